@@ -1,5 +1,6 @@
 #cmakedefine DEBUGREC 1
 #cmakedefine ENABLE_SOUND 1
+#cmakedefine USE_COMPUTED_GOTO 1
 #cmakedefine USE_CONSOLE 1
 #cmakedefine USE_FMOD 1
 #cmakedefine USE_LIBNOTIFY 1
@@ -21,6 +22,7 @@
 #cmakedefine HAVE_SHARE_H 1
 #cmakedefine HAVE_SIGNAL_H 1
 #cmakedefine HAVE_STDINT_H 1
+#cmakedefine HAVE_SYS_EPOLL_H 1
 #cmakedefine HAVE_SYS_INOTIFY_H 1
 #cmakedefine HAVE_SYS_SOCKET_H 1
 #cmakedefine HAVE_SYS_STAT_H 1
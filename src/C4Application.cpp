@@ -50,7 +50,7 @@ C4Application::C4Application() :
 	isFullScreen(true), UseStartupDialog(true), launchEditor(false), restartAtEnd(false),
 	DDraw(nullptr), AppState(C4AS_None),
 	iLastGameTick(0), iGameTickDelay(defaultGameTickDelay), iExtraGameTickDelay(0), pGamePadControl(nullptr),
-	CheckForUpdates(false) {}
+	CheckForUpdates(false), CrossCheckBenchmark(false), BenchmarkFailed(false) {}
 
 C4Application::~C4Application()
 {
@@ -413,6 +413,34 @@ void C4Application::Execute()
 		break;
 	case C4AS_Game:
 	{
+		// replay benchmark: frames back to back, no graphics
+		if (ReplayBenchmark)
+		{
+			if (iRecursionCount <= 1 && !ReplayBenchmark->Execute())
+			{
+				ReplayBenchmark->Finish();
+				Quit();
+			}
+			break;
+		}
+		// collision check benchmark: the scenario was only loaded for it, so quit right away
+		if (CrossCheckBenchmark)
+		{
+			if (iRecursionCount <= 1 && Game.IsRunning)
+			{
+				BenchmarkFailed = !Game.Objects.CrossCheckBenchmark(10);
+				Quit();
+			}
+			break;
+		}
+		// seeking in a replay: the same until the target frame is reached
+		if (Game.IsRunning && Game.Control.isReplay() && Game.FrameCounter < Game.ReplaySeekFrame && iRecursionCount <= 1)
+		{
+			Game.Execute();
+			if (Game.FrameCounter >= Game.ReplaySeekFrame) LogF("Record: Reached frame %d", Game.FrameCounter);
+			NextTick(false);
+			break;
+		}
 		uint32_t iThisGameTick = timeGetTime();
 		// Game (do additional timing check)
 		if (Game.IsRunning && iRecursionCount <= 1) if (Game.GameGo || !iExtraGameTickDelay || (iThisGameTick > iLastGameTick + iExtraGameTickDelay))
@@ -25,6 +25,7 @@
 #include <C4InteractiveThread.h>
 #include "C4Toast.h"
 #include <C4Network2IRC.h>
+#include <C4ReplayBenchmark.h>
 #include <StdWindow.h>
 
 #include <optional>
@@ -88,6 +89,11 @@ public:
 	StdStrBuf IncomingUpdate;
 	// set by ParseCommandLine, for manually invoking an update check by command line or url
 	bool CheckForUpdates;
+	// set by ParseCommandLine, for replaying a record as fast as possible without graphics
+	std::unique_ptr<C4ReplayBenchmark> ReplayBenchmark;
+	// set by ParseCommandLine, for timing object collision checks on a scratch game
+	bool CrossCheckBenchmark;
+	bool BenchmarkFailed;
 	// Flag for launching editor on quit
 	bool launchEditor;
 	// Flag for restarting the engine at the end
@@ -216,6 +216,15 @@ enum C4AulBCCType
 	AB_ERR,              // parse error at this position
 	AB_EOFN,             // end of function
 	AB_EOF,              // end of file
+
+	// superinstructions, set by C4AulScript::Optimize
+	// the chunks they replace stay in place behind them
+	AB_INT_OP,           // AB_INT followed by an int operator
+	AB_CMP_CONDN,        // int comparison followed by AB_CONDN
+	AB_INT_CMP_CONDN,    // AB_INT, int comparison, AB_CONDN
+	AB_VARN_INCDEC,      // AB_VARN_R, ++/--, AB_STACK -1
+
+	AB_NUM               // number of chunk types
 };
 
 // ** a definition of an operator
@@ -468,13 +477,14 @@ protected:
 	void ParseFn(C4AulScriptFunc *Fn, bool fExprOnly = false); // parse single script function
 
 	bool Parse(); // parse preparsed script; return if successfull
+	void Optimize(); // replace common chunk sequences by superinstructions
 	void ParseDescs(); // parse function descs
 
 	bool ResolveIncludes(C4DefList *rDefs); // resolve includes
 	bool ResolveAppends(C4DefList *rDefs); // resolve appends
 	bool IncludesResolved;
 	void AppendTo(C4AulScript &Scr, bool bHighPrio); // append to given script
-	void UnLink(); // reset to unlinked state
+	virtual void UnLink(); // reset to unlinked state
 	virtual void AfterLink(); // called after linking is completed; presearch common funcs here & search same-named funcs
 	virtual bool ReloadScript(const char *szPath); // reload given script
 
@@ -572,9 +582,10 @@ public:
 	bool GetGlobalConstant(const char *szName, C4Value *pTargetValue); // check if a constant exists; assign value to pTargetValue if not nullptr
 
 	bool DenumerateVariablePointers();
-	void UnLink(); // called when a script is being reloaded (clears string table)
+	void UnLink() override; // called when a script is being reloaded (clears string table)
 	// Compile scenario script data (without strings and constants)
 	void CompileFunc(StdCompiler *pComp);
+	void Benchmark(); // log the execution speed of some typical script loops
 
 	friend class C4AulFunc;
 	friend class C4AulParseState;
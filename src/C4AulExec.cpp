@@ -26,6 +26,8 @@
 #include <C4ValueHash.h>
 #include <C4Wrappers.h>
 
+#include <chrono>
+
 C4AulExecError::C4AulExecError(C4Object *pObj, const char *szError) : cObj(pObj)
 {
 	// direct error message string
@@ -250,7 +252,6 @@ private:
 	template<bool asReference = false, bool allowAny = true>
 	void CheckOpPar(C4Value *value, C4V_Type expectedType, const char *operatorName, const char *operandPosition = "")
 	{
-		const bool isAtLeastStrict3 = pCurCtx->Func->pOrgScript->Strict >= C4AulScriptStrict::STRICT3;
 		if constexpr (asReference)
 		{
 			if (!value->ConvertTo(C4V_pC4Value))
@@ -260,19 +261,11 @@ private:
 						operatorName, operandPosition, value->GetTypeInfo(), GetC4VName(expectedType)).getData());
 			}
 
-			if (!isAtLeastStrict3 && (expectedType != C4V_pC4Value) && !*value)
-			{
-				value->GetRefVal().Set0();
-			}
-			if (!value->GetRefVal().ConvertTo(expectedType))
-			{
-				throw C4AulExecError(pCurCtx->Obj,
-					FormatString("operator \"%s\"%s: got \"%s&\", but expected \"%s&\"!",
-						operatorName, operandPosition, value->GetRefVal().GetTypeInfo(), GetC4VName(expectedType)).getData());
-			}
+			CheckOpParRefVal<allowAny>(value->GetRefVal(), expectedType, operatorName, operandPosition);
 		}
 		else
 		{
+			const bool isAtLeastStrict3 = pCurCtx->Func->pOrgScript->Strict >= C4AulScriptStrict::STRICT3;
 			if (!isAtLeastStrict3 && (expectedType != C4V_pC4Value) && !*value)
 			{
 				value->Set0();
@@ -281,10 +274,34 @@ private:
 				throw C4AulExecError(pCurCtx->Obj,
 					FormatString("operator \"%s\"%s: got \"%s\", but expected \"%s\"!",
 						operatorName, operandPosition, value->GetTypeInfo(), GetC4VName(expectedType)).getData());
+			if constexpr (!allowAny)
+			{
+				if (isAtLeastStrict3 && value->GetType() == C4V_Any)
+					throw C4AulExecError(pCurCtx->Obj,
+						FormatString("operator \"%s\"%s: got nil, but expected \"%s\"!",
+							operatorName, operandPosition, GetC4VName(expectedType)).getData());
+			}
+		}
+	}
+
+	// the part of CheckOpPar for reference operands that deals with the referenced value
+	template<bool allowAny = true>
+	void CheckOpParRefVal(C4Value &refVal, C4V_Type expectedType, const char *operatorName, const char *operandPosition = "")
+	{
+		const bool isAtLeastStrict3 = pCurCtx->Func->pOrgScript->Strict >= C4AulScriptStrict::STRICT3;
+		if (!isAtLeastStrict3 && (expectedType != C4V_pC4Value) && !refVal)
+		{
+			refVal.Set0();
+		}
+		if (!refVal.ConvertTo(expectedType))
+		{
+			throw C4AulExecError(pCurCtx->Obj,
+				FormatString("operator \"%s\"%s: got \"%s&\", but expected \"%s&\"!",
+					operatorName, operandPosition, refVal.GetTypeInfo(), GetC4VName(expectedType)).getData());
 		}
 		if constexpr (!allowAny)
 		{
-			if (isAtLeastStrict3 && value->GetType() == C4V_Any)
+			if (isAtLeastStrict3 && refVal.GetType() == C4V_Any)
 				throw C4AulExecError(pCurCtx->Obj,
 					FormatString("operator \"%s\"%s: got nil, but expected \"%s\"!",
 						operatorName, operandPosition, GetC4VName(expectedType)).getData());
@@ -348,8 +365,106 @@ C4Value C4AulExec::Exec(C4AulScriptFunc *pSFunc, C4Object *pObj, const C4Value *
 	return Exec(pSFunc->Code, fPassErrors);
 }
 
+// int operators of the superinstructions; same results as the respective operator chunks
+static void ExecIntOp(C4AulBCCType eOp, C4Value &rLeft, C4ValueInt iRight)
+{
+	const C4ValueInt iLeft = rLeft._getInt();
+	switch (eOp)
+	{
+	case AB_Pow:              rLeft.SetInt(Pow(iLeft, iRight)); break;
+	case AB_Div:              if (iRight) rLeft.SetInt(iLeft / iRight); else rLeft.Set0(); break;
+	case AB_Mul:              rLeft.SetInt(iLeft * iRight); break;
+	case AB_Mod:              if (iRight) rLeft.SetInt(iLeft % iRight); else rLeft.Set0(); break;
+	case AB_Sub:              rLeft.SetInt(iLeft - iRight); break;
+	case AB_Sum:              rLeft.SetInt(iLeft + iRight); break;
+	case AB_LeftShift:        rLeft.SetInt(iLeft << iRight); break;
+	case AB_RightShift:       rLeft.SetInt(iLeft >> iRight); break;
+	case AB_LessThan:         rLeft.SetBool(iLeft < iRight); break;
+	case AB_LessThanEqual:    rLeft.SetBool(iLeft <= iRight); break;
+	case AB_GreaterThan:      rLeft.SetBool(iLeft > iRight); break;
+	case AB_GreaterThanEqual: rLeft.SetBool(iLeft >= iRight); break;
+	case AB_BitAnd:           rLeft.SetInt(iLeft & iRight); break;
+	case AB_BitXOr:           rLeft.SetInt(iLeft ^ iRight); break;
+	case AB_BitOr:            rLeft.SetInt(iLeft | iRight); break;
+	default: assert(false);
+	}
+}
+
+static bool ExecIntCompare(C4AulBCCType eOp, C4ValueInt iLeft, C4ValueInt iRight)
+{
+	switch (eOp)
+	{
+	case AB_LessThan:         return iLeft < iRight;
+	case AB_LessThanEqual:    return iLeft <= iRight;
+	case AB_GreaterThan:      return iLeft > iRight;
+	case AB_GreaterThanEqual: return iLeft >= iRight;
+	default: assert(false); return false;
+	}
+}
+
+// Common chunks jump directly to the handler of the next chunk where the
+// compiler supports it (labels as values), which predicts a lot better than
+// the single indirect jump of the switch. All other chunks go through the switch.
+// (can be turned off with the USE_COMPUTED_GOTO build option for comparison)
+#if defined(__GNUC__) && defined(USE_COMPUTED_GOTO)
+#define C4AUL_COMPUTED_GOTO
+#define C4AUL_LABEL(op) op##_Label:
+#define C4AUL_NEXT { ++pCPos; goto *DispatchTable[pCPos->bccType]; }
+#define C4AUL_DISPATCH goto *DispatchTable[pCPos->bccType];
+#else
+#define C4AUL_LABEL(op)
+#define C4AUL_NEXT break;
+#define C4AUL_DISPATCH { fJump = true; break; }
+#endif
+
 C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 {
+#ifdef C4AUL_COMPUTED_GOTO
+	static void *DispatchTable[AB_NUM];
+	if (!DispatchTable[0])
+	{
+		std::fill_n(DispatchTable, AB_NUM, &&Switch_Label);
+#define C4AUL_DISPATCH_TO(op) DispatchTable[op] = &&op##_Label;
+		C4AUL_DISPATCH_TO(AB_NIL)
+		C4AUL_DISPATCH_TO(AB_INT)
+		C4AUL_DISPATCH_TO(AB_BOOL)
+		C4AUL_DISPATCH_TO(AB_STRING)
+		C4AUL_DISPATCH_TO(AB_C4ID)
+		C4AUL_DISPATCH_TO(AB_PARN_R)
+		C4AUL_DISPATCH_TO(AB_PARN_V)
+		C4AUL_DISPATCH_TO(AB_VARN_R)
+		C4AUL_DISPATCH_TO(AB_VARN_V)
+		C4AUL_DISPATCH_TO(AB_GLOBALN_R)
+		C4AUL_DISPATCH_TO(AB_GLOBALN_V)
+		C4AUL_DISPATCH_TO(AB_Not)
+		C4AUL_DISPATCH_TO(AB_Pow)
+		C4AUL_DISPATCH_TO(AB_Div)
+		C4AUL_DISPATCH_TO(AB_Mul)
+		C4AUL_DISPATCH_TO(AB_Mod)
+		C4AUL_DISPATCH_TO(AB_Sub)
+		C4AUL_DISPATCH_TO(AB_Sum)
+		C4AUL_DISPATCH_TO(AB_LeftShift)
+		C4AUL_DISPATCH_TO(AB_RightShift)
+		C4AUL_DISPATCH_TO(AB_LessThan)
+		C4AUL_DISPATCH_TO(AB_LessThanEqual)
+		C4AUL_DISPATCH_TO(AB_GreaterThan)
+		C4AUL_DISPATCH_TO(AB_GreaterThanEqual)
+		C4AUL_DISPATCH_TO(AB_BitAnd)
+		C4AUL_DISPATCH_TO(AB_BitXOr)
+		C4AUL_DISPATCH_TO(AB_BitOr)
+		C4AUL_DISPATCH_TO(AB_Set)
+		C4AUL_DISPATCH_TO(AB_STACK)
+		C4AUL_DISPATCH_TO(AB_JUMP)
+		C4AUL_DISPATCH_TO(AB_CONDN)
+		C4AUL_DISPATCH_TO(AB_IVARN)
+		C4AUL_DISPATCH_TO(AB_INT_OP)
+		C4AUL_DISPATCH_TO(AB_CMP_CONDN)
+		C4AUL_DISPATCH_TO(AB_INT_CMP_CONDN)
+		C4AUL_DISPATCH_TO(AB_VARN_INCDEC)
+#undef C4AUL_DISPATCH_TO
+	}
+#endif
+
 	// Save start context
 	C4AulScriptContext *pOldCtx = pCurCtx;
 
@@ -358,27 +473,30 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 		for (;;)
 		{
 			bool fJump = false;
+#ifdef C4AUL_COMPUTED_GOTO
+		Switch_Label:
+#endif
 			switch (pCPos->bccType)
 			{
-			case AB_NIL:
+			case AB_NIL: C4AUL_LABEL(AB_NIL)
 				PushValue(C4VNull);
-				break;
+				C4AUL_NEXT
 
-			case AB_INT:
+			case AB_INT: C4AUL_LABEL(AB_INT)
 				PushValue(C4VInt(static_cast<C4ValueInt>(pCPos->bccX)));
-				break;
+				C4AUL_NEXT
 
-			case AB_BOOL:
+			case AB_BOOL: C4AUL_LABEL(AB_BOOL)
 				PushValue(C4VBool(!!pCPos->bccX));
-				break;
+				C4AUL_NEXT
 
-			case AB_STRING:
+			case AB_STRING: C4AUL_LABEL(AB_STRING)
 				PushString(reinterpret_cast<C4String *>(pCPos->bccX));
-				break;
+				C4AUL_NEXT
 
-			case AB_C4ID:
+			case AB_C4ID: C4AUL_LABEL(AB_C4ID)
 				PushValue(C4VID(static_cast<C4ID>(pCPos->bccX)));
-				break;
+				C4AUL_NEXT
 
 			case AB_EOFN:
 				throw C4AulExecError(pCurCtx->Obj, "function didn't return");
@@ -386,19 +504,19 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_ERR:
 				throw C4AulExecError(pCurCtx->Obj, "syntax error: see previous parser error for details.");
 
-			case AB_PARN_R:
+			case AB_PARN_R: C4AUL_LABEL(AB_PARN_R)
 				PushValueRef(pCurCtx->Pars[pCPos->bccX]);
-				break;
-			case AB_PARN_V:
+				C4AUL_NEXT
+			case AB_PARN_V: C4AUL_LABEL(AB_PARN_V)
 				PushValue(pCurCtx->Pars[pCPos->bccX]);
-				break;
+				C4AUL_NEXT
 
-			case AB_VARN_R:
+			case AB_VARN_R: C4AUL_LABEL(AB_VARN_R)
 				PushValueRef(pCurCtx->Vars[pCPos->bccX]);
-				break;
-			case AB_VARN_V:
+				C4AUL_NEXT
+			case AB_VARN_V: C4AUL_LABEL(AB_VARN_V)
 				PushValue(pCurCtx->Vars[pCPos->bccX]);
-				break;
+				C4AUL_NEXT
 
 			case AB_LOCALN_R: case AB_LOCALN_V:
 				if (!pCurCtx->Obj)
@@ -425,12 +543,12 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 					PushValue(*pCurCtx->Obj->LocalNamed.GetItem(pCPos->bccX));
 				break;
 
-			case AB_GLOBALN_R:
+			case AB_GLOBALN_R: C4AUL_LABEL(AB_GLOBALN_R)
 				PushValueRef(*Game.ScriptEngine.GlobalNamed.GetItem(pCPos->bccX));
-				break;
-			case AB_GLOBALN_V:
+				C4AUL_NEXT
+			case AB_GLOBALN_V: C4AUL_LABEL(AB_GLOBALN_V)
 				PushValue(*Game.ScriptEngine.GlobalNamed.GetItem(pCPos->bccX));
-				break;
+				C4AUL_NEXT
 			// prefix
 			case AB_Inc1: // ++
 				CheckOpPar<C4V_Int, false>(pCPos->bccX);
@@ -446,10 +564,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(~pCurVal->_getInt());
 				break;
-			case AB_Not: // !
+			case AB_Not: C4AUL_LABEL(AB_Not) // !
 				CheckOpPar(pCPos->bccX);
 				pCurVal->SetBool(!pCurVal->_getRaw());
-				break;
+				C4AUL_NEXT
 			case AB_Neg: // -
 				CheckOpPar<C4V_Any, false>(pCPos->bccX);
 				pCurVal->SetInt(-pCurVal->_getInt());
@@ -474,15 +592,15 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 			// postfix
-			case AB_Pow: // **
+			case AB_Pow: C4AUL_LABEL(AB_Pow) // **
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(Pow(pPar1->_getInt(), pPar2->_getInt()));
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_Div: // /
+			case AB_Div: C4AUL_LABEL(AB_Div) // /
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -491,17 +609,17 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				else
 					pPar1->Set0();
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_Mul: // *
+			case AB_Mul: C4AUL_LABEL(AB_Mul) // *
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() * pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_Mod: // %
+			case AB_Mod: C4AUL_LABEL(AB_Mod) // %
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
@@ -510,71 +628,71 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				else
 					pPar1->Set0();
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_Sub: // -
+			case AB_Sub: C4AUL_LABEL(AB_Sub) // -
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() - pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_Sum: // +
+			case AB_Sum: C4AUL_LABEL(AB_Sum) // +
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() + pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_LeftShift: // <<
+			case AB_LeftShift: C4AUL_LABEL(AB_LeftShift) // <<
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() << pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_RightShift: // >>
+			case AB_RightShift: C4AUL_LABEL(AB_RightShift) // >>
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() >> pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_LessThan: // <
+			case AB_LessThan: C4AUL_LABEL(AB_LessThan) // <
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() < pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_LessThanEqual: // <=
+			case AB_LessThanEqual: C4AUL_LABEL(AB_LessThanEqual) // <=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() <= pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_GreaterThan: // >
+			case AB_GreaterThan: C4AUL_LABEL(AB_GreaterThan) // >
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() > pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_GreaterThanEqual: // >=
+			case AB_GreaterThanEqual: C4AUL_LABEL(AB_GreaterThanEqual) // >=
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetBool(pPar1->_getInt() >= pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
 			case AB_Concat: // ..
 			case AB_ConcatIt: // ..=
@@ -691,29 +809,29 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				PopValue();
 				break;
 			}
-			case AB_BitAnd: // &
+			case AB_BitAnd: C4AUL_LABEL(AB_BitAnd) // &
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() & pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_BitXOr: // ^
+			case AB_BitXOr: C4AUL_LABEL(AB_BitXOr) // ^
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() ^ pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
-			case AB_BitOr: // |
+			case AB_BitOr: C4AUL_LABEL(AB_BitOr) // |
 			{
 				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				pPar1->SetInt(pPar1->_getInt() | pPar2->_getInt());
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
 			case AB_And: // &&
 			{
@@ -840,13 +958,13 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 			}
-			case AB_Set: // =
+			case AB_Set: C4AUL_LABEL(AB_Set) // =
 			{
 				CheckOpPars(pCPos->bccX);
 				C4Value *pPar1 = pCurVal - 1, *pPar2 = pCurVal;
 				*pPar1 = *pPar2;
 				PopValue();
-				break;
+				C4AUL_NEXT
 			}
 			case AB_ARRAY:
 			{
@@ -969,17 +1087,16 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 			case AB_DEREF:
 				pCurVal[0].Deref();
 
-			case AB_STACK:
+			case AB_STACK: C4AUL_LABEL(AB_STACK)
 				if (pCPos->bccX < 0)
 					PopValues(-pCPos->bccX);
 				else
 					PushNullVals(pCPos->bccX);
-				break;
+				C4AUL_NEXT
 
-			case AB_JUMP:
-				fJump = true;
+			case AB_JUMP: C4AUL_LABEL(AB_JUMP)
 				pCPos += pCPos->bccX;
-				break;
+				C4AUL_DISPATCH
 
 			case AB_JUMPAND:
 				if (!pCurVal[0])
@@ -1026,14 +1143,70 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				}
 				break;
 
-			case AB_CONDN:
+			case AB_CONDN: C4AUL_LABEL(AB_CONDN)
 				if (!pCurVal[0])
 				{
-					fJump = true;
 					pCPos += pCPos->bccX;
+					PopValue();
+					C4AUL_DISPATCH
 				}
 				PopValue();
-				break;
+				C4AUL_NEXT
+
+			case AB_INT_OP: C4AUL_LABEL(AB_INT_OP)
+			{
+				// AB_INT and the operator following it, without pushing the constant
+				CheckOverflow(1);
+				const auto iConst = static_cast<C4ValueInt>(pCPos->bccX);
+				++pCPos; // errors belong to the operator
+				const C4ScriptOpDef &Op = C4ScriptOpMap[pCPos->bccX];
+				CheckOpPar<false, false>(pCurVal, Op.Type1, Op.Identifier, " left side");
+				ExecIntOp(Op.Code, *pCurVal, iConst);
+				C4AUL_NEXT
+			}
+
+			case AB_CMP_CONDN: C4AUL_LABEL(AB_CMP_CONDN)
+			{
+				// int comparison and AB_CONDN, without pushing the result
+				CheckOpPars<C4V_Any, C4V_Any, false, false>(pCPos->bccX);
+				const bool fResult = ExecIntCompare(C4ScriptOpMap[pCPos->bccX].Code, pCurVal[-1]._getInt(), pCurVal->_getInt());
+				PopValues(2);
+				++pCPos; // AB_CONDN
+				pCPos += fResult ? 1 : pCPos->bccX;
+				C4AUL_DISPATCH
+			}
+
+			case AB_INT_CMP_CONDN: C4AUL_LABEL(AB_INT_CMP_CONDN)
+			{
+				// AB_INT, int comparison and AB_CONDN, without pushing constant and result
+				CheckOverflow(1);
+				const auto iConst = static_cast<C4ValueInt>(pCPos->bccX);
+				++pCPos; // errors belong to the comparison
+				const C4ScriptOpDef &Op = C4ScriptOpMap[pCPos->bccX];
+				CheckOpPar<false, false>(pCurVal, Op.Type1, Op.Identifier, " left side");
+				const bool fResult = ExecIntCompare(Op.Code, pCurVal->_getInt(), iConst);
+				PopValue();
+				++pCPos; // AB_CONDN
+				pCPos += fResult ? 1 : pCPos->bccX;
+				C4AUL_DISPATCH
+			}
+
+			case AB_VARN_INCDEC: C4AUL_LABEL(AB_VARN_INCDEC)
+			{
+				// ++/-- on a named var as a statement, without pushing and popping the reference
+				CheckOverflow(1);
+				C4Value &rVar = pCurCtx->Vars[pCPos->bccX].GetRefVal();
+				++pCPos; // errors belong to the operator
+				const C4ScriptOpDef &Op = C4ScriptOpMap[pCPos->bccX];
+				CheckOpParRefVal(rVar, C4V_Int, Op.Identifier);
+				if (Op.Code == AB_Inc1 || Op.Code == AB_Inc1_Postfix)
+					++rVar.GetData().Int;
+				else
+					--rVar.GetData().Int;
+				rVar.HintType(C4V_Int);
+				pCPos += 2; // skip AB_STACK
+				C4AUL_DISPATCH
+			}
 
 			case AB_RETURN:
 			{
@@ -1189,10 +1362,10 @@ C4Value C4AulExec::Exec(C4AulBCC *pCPos, bool fPassErrors)
 				break;
 			}
 
-			case AB_IVARN:
+			case AB_IVARN: C4AUL_LABEL(AB_IVARN)
 				pCurCtx->Vars[pCPos->bccX] = pCurVal[0];
 				PopValue();
-				break;
+				C4AUL_NEXT
 
 			case AB_CALLNS:
 				// Ignore. TODO: Fix this.
@@ -1674,6 +1847,65 @@ C4Value C4AulScript::DirectExec(C4Object *pObj, const char *szScript, const char
 	return vRetVal;
 }
 
+void C4AulScriptEngine::Benchmark()
+{
+	const int32_t iIterations = 1000000;
+	static const struct { const char *szName, *szBody; } Loops[] =
+	{
+		{"arithmetic", "var s = 0; for (var i = 0; i < %d; ++i) s += i * 3 %% 7 - 2; return s;"},
+		{"conditions", "var s = 0, i = %d; while (i--) if (i %% 3 == 0 || i > 500) ++s; return s;"},
+		{"arrays", "var a = CreateArray(100), s = 0; for (var i = 0; i < %d; ++i) { a[i %% 100] = i; s += a[i %% 100] %% 7; } return s;"},
+		{"engine calls", "var s = 0; for (var i = 0; i < %d; ++i) s += Abs(i - 500000) / 1000; return s;"},
+		{"strings", "var s = 0; for (var i = 0; i < %d; ++i) if (Format(\"%%d\", i %% 10) == \"5\") ++s; return s;"},
+	};
+	// compile as a regular script, so the loop gets the same code as in definitions
+	// (DirectExec only takes expressions)
+	const auto Run = [this](const char *szBody, bool fSuperinstructions, C4Value &Result) -> double
+	{
+		const bool fWasOptimizing = Config.Developer.ScriptSuperinstructions;
+		Config.Developer.ScriptSuperinstructions = fSuperinstructions;
+		C4AulScript *pScript = new C4AulScript();
+		pScript->Script.Copy(FormatString("#strict 3\nfunc Bench() { %s }", szBody).getData());
+		pScript->ScriptName = "benchmark";
+		pScript->Temporary = true;
+		pScript->Reg2List(this, this);
+		pScript->Preparse();
+		pScript->State = ASS_LINKED;
+		pScript->Parse();
+		Config.Developer.ScriptSuperinstructions = fWasOptimizing;
+		C4AulScriptFunc *pFunc = pScript->GetSFunc("Bench");
+		double dTime = -1;
+		if (pFunc && pScript->State == ASS_PARSED)
+		{
+			const auto Start = std::chrono::steady_clock::now();
+			Result = pFunc->Exec();
+			dTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+		}
+		delete pScript;
+		return dTime;
+	};
+#ifdef C4AUL_COMPUTED_GOTO
+	Log("Benchmark: computed goto dispatch");
+#else
+	Log("Benchmark: switch dispatch");
+#endif
+	for (const auto &Loop : Loops)
+	{
+		// fewer iterations for the slow ones
+		const int32_t iCount = SEqual(Loop.szName, "strings") ? iIterations / 10 : iIterations;
+		const StdStrBuf Body(FormatString(Loop.szBody, static_cast<int>(iCount)));
+		C4Value Result, PlainResult;
+		const double dTime = Run(Body.getData(), true, Result), dPlainTime = Run(Body.getData(), false, PlainResult);
+		if (dTime <= 0 || dPlainTime <= 0)
+		{
+			LogF("Benchmark: %-12s failed to compile", Loop.szName);
+			continue;
+		}
+		LogF("Benchmark: %-12s %.2f M iterations/s, %.2f M without superinstructions (result %d%s)", Loop.szName,
+			iCount / dTime / 1000000, iCount / dPlainTime / 1000000, Result.getInt(), Result == PlainResult ? "" : ", differs without superinstructions!");
+	}
+}
+
 void C4AulScript::ResetProfilerTimes()
 {
 	// zero all profiler times of owned functions
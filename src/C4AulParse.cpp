@@ -912,6 +912,12 @@ static const char *GetTTName(C4AulBCCType e)
 	case AB_ERR:              return "AB_ERR";              // parse error at this position
 	case AB_EOFN:             return "AB_EOFN";             // end of function
 	case AB_EOF:              return "AB_EOF";
+
+	case AB_INT_OP:           return "AB_INT_OP";           // superinstruction: constant operand
+	case AB_CMP_CONDN:        return "AB_CMP_CONDN";        // superinstruction: compare and jump
+	case AB_INT_CMP_CONDN:    return "AB_INT_CMP_CONDN";    // superinstruction: compare with constant and jump
+	case AB_VARN_INCDEC:      return "AB_VARN_INCDEC";      // superinstruction: ++/-- named var
+	case AB_NUM:              break;
 	}
 	return "?";
 }
@@ -3574,6 +3580,9 @@ bool C4AulScript::Parse()
 	// add eof chunk
 	AddBCC(AB_EOF);
 
+	// fuse common sequences
+	Optimize();
+
 	// calc absolute code addresses for script funcs
 	for (f = Func0; f; f = f->Next)
 	{
@@ -3627,6 +3636,64 @@ bool C4AulScript::Parse()
 	return true;
 }
 
+namespace
+{
+	bool IsIntArithmeticType(C4AulBCCType type) noexcept
+	{
+		switch (type)
+		{
+		case AB_Pow: case AB_Div: case AB_Mul: case AB_Mod: case AB_Sub: case AB_Sum:
+		case AB_LeftShift: case AB_RightShift: case AB_BitAnd: case AB_BitXOr: case AB_BitOr:
+			return true;
+		default:
+			return false;
+		}
+	}
+
+	bool IsIntCompareType(C4AulBCCType type) noexcept
+	{
+		return type == AB_LessThan || type == AB_LessThanEqual || type == AB_GreaterThan || type == AB_GreaterThanEqual;
+	}
+}
+
+void C4AulScript::Optimize()
+{
+	if (!Config.Developer.ScriptSuperinstructions) return;
+	// Only the first chunk of a sequence is replaced; the others are kept, so
+	// jumps into the middle of a sequence and all jump offsets stay valid.
+	// The superinstructions get their operators from the operator IDs of the
+	// following chunks, so a chunk may be both the tail of one sequence and
+	// the head of another.
+	for (int i = 0; i < CodeSize; i++)
+	{
+		C4AulBCC *pBCC = Code + i;
+		const C4AulBCCType eNext = i + 1 < CodeSize ? pBCC[1].bccType : AB_EOF;
+		const C4AulBCCType eNext2 = i + 2 < CodeSize ? pBCC[2].bccType : AB_EOF;
+		switch (pBCC->bccType)
+		{
+		case AB_INT:
+			if (IsIntCompareType(eNext) && eNext2 == AB_CONDN)
+				pBCC->bccType = AB_INT_CMP_CONDN;
+			else if (IsIntCompareType(eNext) || IsIntArithmeticType(eNext))
+				pBCC->bccType = AB_INT_OP;
+			break;
+
+		case AB_LessThan: case AB_LessThanEqual: case AB_GreaterThan: case AB_GreaterThanEqual:
+			if (eNext == AB_CONDN)
+				pBCC->bccType = AB_CMP_CONDN;
+			break;
+
+		case AB_VARN_R:
+			if ((eNext == AB_Inc1 || eNext == AB_Dec1 || eNext == AB_Inc1_Postfix || eNext == AB_Dec1_Postfix) && eNext2 == AB_STACK && pBCC[2].bccX == -1)
+				pBCC->bccType = AB_VARN_INCDEC;
+			break;
+
+		default:
+			break;
+		}
+	}
+}
+
 void C4AulScript::ParseDescs()
 {
 	// parse children
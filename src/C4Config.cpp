@@ -88,6 +88,7 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 #endif
 	pComp->Value(mkNamingAdapt(FPS,              "FPS",              false,         false, true));
 	pComp->Value(mkNamingAdapt(Record,           "Record",           false,         false, true));
+	pComp->Value(mkNamingAdapt(RecordKeyframeInterval, "RecordKeyframeInterval", 0, false, true));
 	pComp->Value(mkNamingAdapt(ScreenshotFolder, "ScreenshotFolder", "Screenshots", false, true));
 	pComp->Value(mkNamingAdapt(FairCrew,         "NoCrew",           false,         false, true));
 	pComp->Value(mkNamingAdapt(FairCrewStrength, "DefCrewStrength",  1000,          false, true));
@@ -106,11 +107,14 @@ void C4ConfigGeneral::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(UseWhiteLobbyChat,    "UseWhiteLobbyChat",    false, false, true));
 	pComp->Value(mkNamingAdapt(ShowLogTimestamps,    "ShowLogTimestamps",    false, false, true));
 	pComp->Value(mkNamingAdapt(Preloading,           "Preloading",           true));
+	pComp->Value(mkNamingAdapt(ParallelLandscapeScan, "ParallelLandscapeScan", true));
+	pComp->Value(mkNamingAdapt(ParallelDefLoading,   "ParallelDefLoading",   true));
 }
 
 void C4ConfigDeveloper::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(AutoFileReload, "AutoFileReload", true, false, true));
+	pComp->Value(mkNamingAdapt(ScriptSuperinstructions, "ScriptSuperinstructions", true));
 }
 
 #ifdef C4ENGINE
@@ -216,6 +220,7 @@ void C4ConfigNetwork::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(LocalName,          "LocalName",          "Unknown",      false, true));
 	pComp->Value(mkNamingAdapt(Nick,               "Nick",               "",             false, true));
 	pComp->Value(mkNamingAdapt(MaxLoadFileSize,    "MaxLoadFileSize", 100 * 1024 * 1024, false, true));
+	pComp->Value(mkNamingAdapt(PacketCompression,  "PacketCompression", true,            false, true));
 
 	pComp->Value(mkNamingAdapt(MasterServerSignUp,        "MasterServerSignUp",     true,   false, true));
 	pComp->Value(mkNamingAdapt(MasterReferencePeriod,     "MasterReferencePeriod",  120,    false, true));
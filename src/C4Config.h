@@ -64,6 +64,7 @@ public:
 	char MissionAccess[CFG_MaxString + 1];
 	bool FPS;
 	bool Record;
+	int32_t RecordKeyframeInterval; // frames between savegames stored in records for seeking; 0 for none
 	bool MMTimer;    // use multimedia-timers
 	bool FairCrew;   // don't use permanent crew physicals
 	int32_t FairCrewStrength; // strength of clonks in fair crew mode
@@ -83,6 +84,8 @@ public:
 	bool UseWhiteLobbyChat;
 	bool ShowLogTimestamps;
 	bool Preloading;
+	bool ParallelLandscapeScan; // check landscape columns for material conversion on multiple threads
+	bool ParallelDefLoading; // decode definition graphics on multiple threads
 
 public:
 	static int GetLanguageSequence(const char *strSource, char *strTarget);
@@ -96,6 +99,7 @@ class C4ConfigDeveloper
 {
 public:
 	bool AutoFileReload;
+	bool ScriptSuperinstructions; // fuse common chunk sequences when compiling scripts; off only for comparison
 	void CompileFunc(StdCompiler *pComp);
 };
 
@@ -185,6 +189,7 @@ public:
 	ValidatedStdStrBuf<C4InVal::VAL_NameNoEmpty> LocalName;
 	ValidatedStdStrBuf<C4InVal::VAL_NameAllowEmpty> Nick;
 	int32_t MaxLoadFileSize;
+	bool PacketCompression;
 	char LastPassword[CFG_MaxString + 1];
 	char ServerAddress[CFG_MaxString + 1];
 	char AlternateServerAddress[CFG_MaxString + 1];
@@ -430,6 +430,11 @@ void C4ControlSyncCheck::Set()
 	SectShapeSum = Game.Objects.Sectors.getShapeSum();
 }
 
+StdStrBuf C4ControlSyncCheck::GetSummary() const
+{
+	return FormatString("Frm %i Ctrl %i Rnc %i Rn3 %i Cpx %i PXS %i MMi %i Obc %i Oei %i Sct %i", Frame, ControlTick, RandomCount, Random3, AllCrewPosX, PXSCount, MassMoverIndex, ObjectCount, ObjectEnumerationIndex, SectShapeSum);
+}
+
 int32_t C4ControlSyncCheck::GetAllCrewPosX()
 {
 	int32_t cpx = 0;
@@ -471,8 +476,9 @@ void C4ControlSyncCheck::Execute() const
 		}
 		// Message
 		LogFatal("Network: Synchronization loss!");
-		LogFatal(FormatString("Network: %s Frm %i Ctrl %i Rnc %i Rn3 %i Cpx %i PXS %i MMi %i Obc %i Oei %i Sct %i", szThis,            Frame,           ControlTick,           RandomCount,           Random3,           AllCrewPosX,           PXSCount,           MassMoverIndex,           ObjectCount,           ObjectEnumerationIndex,           SectShapeSum).getData());
-		LogFatal(FormatString("Network: %s Frm %i Ctrl %i Rnc %i Rn3 %i Cpx %i PXS %i MMi %i Obc %i Oei %i Sct %i", szOther, SyncCheck.Frame, SyncCheck.ControlTick, SyncCheck.RandomCount, SyncCheck.Random3, SyncCheck.AllCrewPosX, SyncCheck.PXSCount, SyncCheck.MassMoverIndex, SyncCheck.ObjectCount, SyncCheck.ObjectEnumerationIndex, SyncCheck.SectShapeSum).getData());
+		LogFatal(FormatString("Network: %s %s", szThis, GetSummary().getData()).getData());
+		LogFatal(FormatString("Network: %s %s", szOther, SyncCheck.GetSummary().getData()).getData());
+		if (Game.Control.SyncLossFrame < 0) Game.Control.SyncLossFrame = Frame;
 		StartSoundEffect("SyncError");
 #ifdef _DEBUG
 		// Debug safe
@@ -490,6 +496,8 @@ void C4ControlSyncCheck::Execute() const
 			Game.Network.Clear();
 		}
 	}
+	else
+		++Game.Control.SyncChecksPassed;
 }
 
 void C4ControlSyncCheck::CompileFunc(StdCompiler *pComp)
@@ -209,6 +209,7 @@ protected:
 public:
 	void Set();
 	int32_t getFrame() const { return Frame; }
+	StdStrBuf GetSummary() const; // compared values for logging
 	virtual bool Sync() const override { return false; }
 	DECLARE_C4CONTROL_VIRTUALS
 
@@ -35,6 +35,7 @@
 #endif
 
 #include <algorithm>
+#include <memory>
 
 // Default Action Procedures
 
@@ -966,6 +967,19 @@ int32_t C4DefList::Load(C4Group &hGroup, uint32_t dwLoadWhat,
 
 #ifdef C4ENGINE // Message
 	if (fThisSearchMessage) { LogF("%s...", GetFilename(hGroup.GetName())); }
+
+	// Decode the graphics of all definitions in here on worker threads, ahead of loading them
+	std::unique_ptr<C4DefGraphicsPreloader> pPreloader;
+	if ((dwLoadWhat & C4D_Load_Bitmap) && !C4DefGraphicsPreloader::Active)
+	{
+		const int32_t iThreads = C4DefGraphicsPreloader::GetThreadCount();
+		if (iThreads > 0)
+		{
+			pPreloader = std::make_unique<C4DefGraphicsPreloader>(iThreads);
+			pPreloader->AddGroup(hGroup);
+			C4DefGraphicsPreloader::Active = pPreloader.get();
+		}
+	}
 #endif
 
 	auto def = std::make_unique<C4Def>();
@@ -1023,6 +1037,8 @@ int32_t C4DefList::Load(C4Group &hGroup, uint32_t dwLoadWhat,
 
 	// progress (could go down one level of recursion...)
 	if (iMinProgress != iMaxProgress) Game.SetInitProgress(float(iMaxProgress));
+
+	if (pPreloader) C4DefGraphicsPreloader::Active = nullptr;
 #endif
 
 	return iResult;
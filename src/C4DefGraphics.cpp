@@ -32,8 +32,29 @@
 #include <C4Player.h>
 #include <C4Log.h>
 
+#include <StdBitmap.h>
+
+#ifdef _WIN32
+#include <objbase.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+
 // C4DefGraphics
 
+namespace
+{
+	// read the accessed PNG entry, preferably from the preloaded images
+	bool ReadDefPNG(C4Surface &rSurface, C4Group &hGroup, const char *szEntry)
+	{
+		std::unique_ptr<StdBitmap> Bitmap;
+		if (C4DefGraphicsPreloader::Active && C4DefGraphicsPreloader::Active->Take(hGroup, szEntry, Bitmap))
+			return Bitmap && rSurface.ReadBitmap(*Bitmap);
+		return rSurface.ReadPNG(hGroup);
+	}
+}
+
 C4DefGraphics::C4DefGraphics(C4Def *pOwnDef)
 {
 	// store def
@@ -61,7 +82,7 @@ bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const
 	if (szFilenamePNG && hGroup.AccessEntry(szFilenamePNG))
 	{
 		Bitmap = new C4Surface();
-		if (!Bitmap->ReadPNG(hGroup)) return false;
+		if (!ReadDefPNG(*Bitmap, hGroup, szFilenamePNG)) return false;
 	}
 	else
 	{
@@ -78,7 +99,7 @@ bool C4DefGraphics::LoadGraphics(C4Group &hGroup, const char *szFilename, const
 		// if overlay-surface is present, load from that
 		if (szOverlayPNG && hGroup.AccessEntry(szOverlayPNG))
 		{
-			if (!BitmapClr->ReadPNG(hGroup))
+			if (!ReadDefPNG(*BitmapClr, hGroup, szOverlayPNG))
 				return false;
 			// set as Clr-surface, also checking size
 			if (!BitmapClr->SetAsClrByOwnerOf(Bitmap))
@@ -322,6 +343,234 @@ C4PortraitGraphics *C4PortraitGraphics::GetByIndex(int32_t iIndex)
 	return pResult->IsPortrait();
 }
 
+// C4DefGraphicsPreloader
+
+C4DefGraphicsPreloader *C4DefGraphicsPreloader::Active = nullptr;
+
+const size_t C4DefGfxPreload_MaxDecodedSize = 128 * 1024 * 1024, // workers wait while this much has not been taken yet
+             C4DefGfxPreload_MaxRawSize = 32 * 1024 * 1024; // the reader waits while this much has not been decoded yet
+
+int32_t C4DefGraphicsPreloader::GetThreadCount()
+{
+	if (!Config.General.ParallelDefLoading) return 0;
+	// leave one core to the loading thread
+	return std::clamp<int32_t>(static_cast<int32_t>(std::thread::hardware_concurrency()) - 1, 0, 8);
+}
+
+C4DefGraphicsPreloader::C4DefGraphicsPreloader(int32_t iThreads)
+{
+	for (int32_t i = 0; i < iThreads; ++i)
+		Workers.emplace_back(&C4DefGraphicsPreloader::Work, this);
+}
+
+C4DefGraphicsPreloader::~C4DefGraphicsPreloader()
+{
+	{
+		const std::lock_guard<std::mutex> lock{Mutex};
+		fStop = true;
+	}
+	QueueChanged.notify_all();
+	RawDecoded.notify_all();
+	if (Reader.joinable()) Reader.join();
+	for (auto &worker : Workers)
+		worker.join();
+}
+
+std::string C4DefGraphicsPreloader::GetKey(const std::string &GroupKey, const char *szEntry)
+{
+	std::string Key{GroupKey};
+	if (!Key.empty()) Key += DirectorySeparator;
+	Key += szEntry;
+	// group entry names are not case sensitive
+	std::transform(Key.begin(), Key.end(), Key.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+	return Key;
+}
+
+size_t C4DefGraphicsPreloader::GetSize(const Image &rImage)
+{
+	return rImage.Bitmap ? size_t{rImage.Bitmap->Width()} * rImage.Bitmap->Height() * (rImage.Bitmap->UsesAlpha() ? 4 : 3) : 0;
+}
+
+void C4DefGraphicsPreloader::AddGroup(C4Group &hGroup)
+{
+	// the loading thread keeps using hGroup, so the reader opens the group on its own
+	Reader = std::thread{&C4DefGraphicsPreloader::Read, this, std::string{hGroup.GetFullName().getData()}, GetKey("", hGroup.GetFullName().getData())};
+}
+
+void C4DefGraphicsPreloader::Read(const std::string &Filename, const std::string &GroupKey)
+{
+	C4Group hGroup;
+	if (hGroup.Open(Filename.c_str()))
+		ReadGroup(hGroup, GroupKey);
+	{
+		const std::lock_guard<std::mutex> lock{Mutex};
+		fReaderDone = true;
+	}
+	GroupRead.notify_all();
+}
+
+bool C4DefGraphicsPreloader::ReadGroup(C4Group &hGroup, const std::string &GroupKey)
+{
+	const int32_t iGroup = GroupCount++;
+	char szEntry[_MAX_FNAME + 1];
+	// loading entries resets the search, so collect the names first
+	std::vector<std::string> Entries;
+	hGroup.ResetSearch();
+	while (hGroup.FindNextEntry("*.png", szEntry))
+		Entries.emplace_back(szEntry);
+	for (const auto &Entry : Entries)
+	{
+		{
+			std::unique_lock<std::mutex> lock{Mutex};
+			RawDecoded.wait(lock, [this] { return fStop || fLoaderWaiting || RawSize < C4DefGfxPreload_MaxRawSize; });
+			if (fStop) return false;
+		}
+		auto pImage = std::make_unique<Image>();
+		pImage->Group = iGroup;
+		if (!hGroup.LoadEntry(Entry.c_str(), pImage->Data)) continue;
+		{
+			const std::lock_guard<std::mutex> lock{Mutex};
+			RawSize += pImage->Data.getSize();
+			Queue.push_back(pImage.get());
+			Pending.push_back(pImage.get());
+			Images[GetKey(GroupKey, Entry.c_str())] = std::move(pImage);
+		}
+		QueueChanged.notify_one();
+	}
+	{
+		const std::lock_guard<std::mutex> lock{Mutex};
+		ReadGroups.insert(GroupKey);
+		if (fStop) return false;
+	}
+	GroupRead.notify_all();
+	// definition subgroups, in the order C4DefList::Load visits them
+	Entries.clear();
+	hGroup.ResetSearch();
+	while (hGroup.FindNextEntry(C4CFN_DefFiles, szEntry))
+		Entries.emplace_back(szEntry);
+	for (const auto &Entry : Entries)
+	{
+		C4Group hChild;
+		if (hChild.OpenAsChild(&hGroup, Entry.c_str()))
+			if (!ReadGroup(hChild, GetKey(GroupKey, Entry.c_str())))
+				return false;
+	}
+	return true;
+}
+
+void C4DefGraphicsPreloader::Decode(Image &rImage)
+{
+	try
+	{
+		rImage.Bitmap = C4Surface::DecodePNG(rImage.Data.getData(), rImage.Data.getSize());
+	}
+	catch (const std::runtime_error &e)
+	{
+		rImage.Error = e.what();
+	}
+	rImage.Data.Clear();
+}
+
+void C4DefGraphicsPreloader::Work()
+{
+#ifdef _WIN32
+	// PNG decoding uses WIC
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+#endif
+	std::unique_lock<std::mutex> lock{Mutex};
+	for (;;)
+	{
+		QueueChanged.wait(lock, [this] { return fStop || (!Queue.empty() && DecodedSize < C4DefGfxPreload_MaxDecodedSize); });
+		if (fStop) break;
+		Image &rImage = *Queue.front();
+		Queue.pop_front();
+		// taken over by the loading thread or skipped meanwhile?
+		if (rImage.State != Image::Queued || rImage.fSkipped) continue;
+		rImage.State = Image::Decoding;
+		RawSize -= rImage.Data.getSize();
+		lock.unlock();
+		RawDecoded.notify_one();
+		Decode(rImage);
+		lock.lock();
+		rImage.State = Image::Done;
+		if (rImage.fSkipped)
+			rImage.Bitmap.reset();
+		else
+			DecodedSize += GetSize(rImage);
+		ImageDone.notify_all();
+	}
+#ifdef _WIN32
+	lock.unlock();
+	CoUninitialize();
+#endif
+}
+
+void C4DefGraphicsPreloader::Skip(int32_t iBeforeGroup)
+{
+	// images of groups that have been passed are not going to be taken anymore
+	while (!Pending.empty() && Pending.front()->Group < iBeforeGroup)
+	{
+		Image &rImage = *Pending.front();
+		Pending.pop_front();
+		if (rImage.State == Image::Taken) continue;
+		rImage.fSkipped = true;
+		// (the data of images being decoded is freed by the worker)
+		if (rImage.State == Image::Queued)
+		{
+			RawSize -= rImage.Data.getSize();
+			rImage.Data.Clear();
+		}
+		else if (rImage.State == Image::Done)
+		{
+			DecodedSize -= GetSize(rImage);
+			rImage.Bitmap.reset();
+		}
+	}
+}
+
+bool C4DefGraphicsPreloader::Take(C4Group &hGroup, const char *szEntry, std::unique_ptr<StdBitmap> &rBitmap)
+{
+	const std::string GroupKey{GetKey("", hGroup.GetFullName().getData())};
+	std::unique_lock<std::mutex> lock{Mutex};
+	// the reader may not have got that far yet
+	if (!fReaderDone && !ReadGroups.count(GroupKey))
+	{
+		fLoaderWaiting = true;
+		lock.unlock();
+		RawDecoded.notify_all();
+		lock.lock();
+		GroupRead.wait(lock, [this, &GroupKey] { return fReaderDone || ReadGroups.count(GroupKey); });
+		fLoaderWaiting = false;
+	}
+	const auto it = Images.find(GetKey(GroupKey, szEntry));
+	if (it == Images.end() || it->second->State == Image::Taken || it->second->fSkipped) return false;
+	Image &rImage = *it->second;
+	Skip(rImage.Group);
+	if (rImage.State == Image::Queued)
+	{
+		// not started yet: don't wait for the workers
+		rImage.State = Image::Decoding;
+		RawSize -= rImage.Data.getSize();
+		lock.unlock();
+		RawDecoded.notify_one();
+		Decode(rImage);
+		lock.lock();
+	}
+	else
+	{
+		ImageDone.wait(lock, [&rImage] { return rImage.State == Image::Done; });
+		DecodedSize -= GetSize(rImage);
+	}
+	rImage.State = Image::Taken;
+	rBitmap = std::move(rImage.Bitmap);
+	const std::string Error = std::move(rImage.Error);
+	lock.unlock();
+	QueueChanged.notify_all();
+	if (!rBitmap)
+		LogF("Could not create surface from PNG file: %s", Error.c_str());
+	return true;
+}
+
 C4DefGraphicsPtrBackup::C4DefGraphicsPtrBackup(C4DefGraphics *pSourceGraphics)
 {
 	// assign graphics + def
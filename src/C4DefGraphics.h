@@ -24,6 +24,16 @@
 #include <C4Material.h>
 #include <C4Surface.h>
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 #define C4Portrait_None   "none"
 #define C4Portrait_Random "random"
 #define C4Portrait_Custom "custom"
@@ -96,6 +106,59 @@ public:
 	C4PortraitGraphics *Get(const char *szGrpName); // get portrait graphics by name
 };
 
+// decodes the PNG files of definitions on worker threads while C4DefList loads them one by one
+class C4DefGraphicsPreloader
+{
+public:
+	C4DefGraphicsPreloader(int32_t iThreads);
+	~C4DefGraphicsPreloader();
+
+	C4DefGraphicsPreloader(const C4DefGraphicsPreloader &) = delete;
+	C4DefGraphicsPreloader &operator=(const C4DefGraphicsPreloader &) = delete;
+
+	static C4DefGraphicsPreloader *Active; // consulted by C4DefGraphics::LoadGraphics while set
+	static int32_t GetThreadCount(); // worker threads to decode with; 0 if graphics are decoded sequentially
+
+private:
+	struct Image
+	{
+		int32_t Group; // groups are numbered in the order C4DefList::Load visits them
+		StdBuf Data; // file contents until decoded
+		std::unique_ptr<StdBitmap> Bitmap;
+		std::string Error;
+		enum { Queued, Decoding, Done, Taken } State = Queued;
+		bool fSkipped = false; // group has been passed without taking the image
+	};
+
+	std::mutex Mutex;
+	std::condition_variable QueueChanged, ImageDone, GroupRead, RawDecoded;
+	std::unordered_map<std::string, std::unique_ptr<Image>> Images; // by lower case group path and entry name
+	std::unordered_set<std::string> ReadGroups; // lower case paths of groups whose images have all been queued
+	std::deque<Image *> Queue; // images to decode
+	std::deque<Image *> Pending; // images that have not been taken or skipped yet, in group order
+	std::vector<std::thread> Workers;
+	std::thread Reader;
+	size_t RawSize = 0; // bytes of PNG files waiting to be decoded
+	size_t DecodedSize = 0; // bytes of decoded bitmaps waiting to be taken
+	int32_t GroupCount = 0;
+	bool fReaderDone = false;
+	bool fLoaderWaiting = false; // the loading thread needs a group that has not been read yet
+	bool fStop = false;
+
+public:
+	void AddGroup(C4Group &hGroup); // start reading the PNG files of the group and its definition subgroups into the queue
+	bool Take(C4Group &hGroup, const char *szEntry, std::unique_ptr<StdBitmap> &rBitmap); // false if the entry has not been preloaded
+
+private:
+	static std::string GetKey(const std::string &GroupKey, const char *szEntry);
+	static void Decode(Image &rImage);
+	static size_t GetSize(const Image &rImage);
+	void Read(const std::string &Filename, const std::string &GroupKey);
+	bool ReadGroup(C4Group &hGroup, const std::string &GroupKey);
+	void Work();
+	void Skip(int32_t iBeforeGroup);
+};
+
 // backup class holding dead graphics pointers and names
 class C4DefGraphicsPtrBackup
 {
@@ -165,12 +165,23 @@ void C4FileMonitor::OnThreadEvent(C4InteractiveEventType eEvent, const std::any
 	pCallback(std::any_cast<const char *>(eventData), nullptr);
 }
 
+#ifdef STDSCHEDULER_USE_EPOLL
+
+int C4FileMonitor::GetFD()
+{
+	return fd;
+}
+
+#else
+
 void C4FileMonitor::GetFDs(fd_set *pFDs, int *pMaxFD)
 {
 	FD_SET(fd, pFDs);
 	if (pMaxFD) *pMaxFD = (std::max)(*pMaxFD, fd);
 }
 
+#endif
+
 #elif defined(_WIN32)
 
 C4FileMonitor::C4FileMonitor(ChangeNotify pCallback)
@@ -324,6 +335,8 @@ void C4FileMonitor::AddDirectory(const char *szDir) {}
 // Signal for calling Execute()
 #ifdef STDSCHEDULER_USE_EVENTS
 HANDLE C4FileMonitor::GetEvent() { return 0; }
+#elif defined(STDSCHEDULER_USE_EPOLL)
+int C4FileMonitor::GetFD() { return -1; }
 #else
 void C4FileMonitor::GetFDs(fd_set *pFDs, int *pMaxFD) {}
 #endif
@@ -40,6 +40,8 @@ public:
 	// Signal for calling Execute()
 #ifdef STDSCHEDULER_USE_EVENTS
 	virtual HANDLE GetEvent() override;
+#elif defined(STDSCHEDULER_USE_EPOLL)
+	virtual int GetFD() override;
 #else
 	virtual void GetFDs(fd_set *pFDs, int *pMaxFD) override;
 #endif
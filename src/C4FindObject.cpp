@@ -21,6 +21,10 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 #include <C4Random.h>
+#include <C4Stat.h>
+
+C4ST_NEW(FindObjectIndexStat,    "C4FindObject ID index scans")
+C4ST_NEW(FindObjectFullScanStat, "C4FindObject full list scans")
 
 // *** C4FindObject
 
@@ -233,7 +237,18 @@ int32_t C4FindObject::Count(const C4ObjectList &Objs, const C4LSectors &Sct)
 	// Check bounds
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
-		return Count(Objs);
+	{
+		// Count over objects of the searched ID only, if possible
+		const std::vector<C4Object *> *pCandidates = GetIndexCandidates(Objs);
+		if (!pCandidates)
+			return Count(Objs);
+		int32_t iCount = 0;
+		for (C4Object *pObj : *pCandidates)
+			if (pObj->Status)
+				if (Check(pObj))
+					iCount++;
+		return iCount;
+	}
 	else if (UseShapes())
 	{
 		// Get area
@@ -276,7 +291,23 @@ C4Object *C4FindObject::Find(const C4ObjectList &Objs, const C4LSectors &Sct)
 	// Check bounds
 	C4Rect *pBounds = GetBounds();
 	if (!pBounds)
-		return Find(Objs);
+	{
+		// Search objects of the searched ID only, if possible
+		const std::vector<C4Object *> *pCandidates = GetIndexCandidates(Objs);
+		if (!pCandidates)
+			return Find(Objs);
+		for (C4Object *pObj : *pCandidates)
+			if (pObj->Status)
+				if (Check(pObj))
+					if (pObj->Status)
+					{
+						if (!pSort) return pObj;
+						if (!pBestResult || pSort->Compare(pObj, pBestResult) > 0)
+							if (pObj->Status)
+								pBestResult = pObj;
+					}
+		return pBestResult;
+	}
 	// Traverse areas, return first matching object w/o sort or best with sort
 	else if (UseShapes())
 	{
@@ -311,12 +342,30 @@ C4ValueArray *C4FindObject::FindMany(const C4ObjectList &Objs, const C4LSectors
 	if (IsImpossible())
 		return new C4ValueArray();
 	C4Rect *pBounds = GetBounds();
-	if (!pBounds)
+	const std::vector<C4Object *> *pCandidates = nullptr;
+	if (!pBounds && !(pCandidates = GetIndexCandidates(Objs)))
 		return FindMany(Objs);
 	// Prepare for array that may be generated
 	C4ValueArray *pArray; int32_t iSize;
+	// Search objects of the searched ID only?
+	if (pCandidates)
+	{
+		// Set up array
+		pArray = new C4ValueArray(32); iSize = 0;
+		// Search
+		for (C4Object *pObj : *pCandidates)
+			if (pObj->Status)
+				if (Check(pObj))
+				{
+					// Grow the array, if neccessary
+					if (iSize >= pArray->GetSize())
+						pArray->SetSize(iSize * 2);
+					// Add object
+					(*pArray)[iSize++] = C4VObj(pObj);
+				}
+	}
 	// Check shape lists?
-	if (UseShapes())
+	else if (UseShapes())
 	{
 		// Get area
 		C4LArea Area(&Game.Objects.Sectors, *pBounds); C4LSector *pSct;
@@ -388,6 +437,22 @@ void C4FindObject::CheckObjectStatus(C4ValueArray *pArray)
 		}
 }
 
+const std::vector<C4Object *> *C4FindObject::GetIndexCandidates(const C4ObjectList &Objs)
+{
+	// Only the main object list keeps an ID index, and it must not
+	// change while being traversed (i.e. no script calls in Check or Compare)
+	const C4ID idIndex = GetIndexID();
+	if (&Objs != &Game.Objects || idIndex == C4ID_None || HasSideEffects() || (pSort && pSort->HasSideEffects()))
+	{
+		C4ST_ADD(FindObjectFullScanStat, Objs.ObjectCount())
+		return nullptr;
+	}
+	// Objects of that ID in list order, so results are the same as for a full scan
+	const std::vector<C4Object *> &Candidates = Game.Objects.ObjectsByID(idIndex);
+	C4ST_ADD(FindObjectIndexStat, Candidates.size())
+	return &Candidates;
+}
+
 void C4FindObject::SetSort(C4SortObject *pToSort)
 {
 	delete pSort;
@@ -472,6 +537,25 @@ bool C4FindObjectAnd::IsImpossible()
 	return false;
 }
 
+C4ID C4FindObjectAnd::GetIndexID()
+{
+	// any ID condition restricts the whole conjunction
+	for (int32_t i = 0; i < iCnt; i++)
+	{
+		const C4ID idIndex = ppConds[i]->GetIndexID();
+		if (idIndex != C4ID_None) return idIndex;
+	}
+	return C4ID_None;
+}
+
+bool C4FindObjectAnd::HasSideEffects()
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (ppConds[i]->HasSideEffects())
+			return true;
+	return false;
+}
+
 // *** C4FindObjectOr
 
 C4FindObjectOr::C4FindObjectOr(int32_t inCnt, C4FindObject **ppConds)
@@ -533,6 +617,14 @@ bool C4FindObjectOr::IsEnsured()
 	return false;
 }
 
+bool C4FindObjectOr::HasSideEffects()
+{
+	for (int32_t i = 0; i < iCnt; i++)
+		if (ppConds[i]->HasSideEffects())
+			return true;
+	return false;
+}
+
 // *** C4FindObject* (primitive conditions)
 
 bool C4FindObjectExclude::Check(C4Object *pObj)
@@ -872,6 +964,14 @@ int32_t C4SortObjectMultiple::CompareCache(int32_t iObj1, int32_t iObj2, C4Objec
 	return 0;
 }
 
+bool C4SortObjectMultiple::HasSideEffects()
+{
+	for (int32_t i = 0; i < iCnt; ++i)
+		if (ppSorts[i]->HasSideEffects())
+			return true;
+	return false;
+}
+
 int32_t C4SortObjectDistance::CompareGetValue(C4Object *pFor)
 {
 	int32_t dx = pFor->x - iX, dy = pFor->y - iY;
@@ -21,6 +21,8 @@
 #include "C4Value.h"
 #include "C4Aul.h"
 
+#include <vector>
+
 // Condition map
 enum C4FindObjectCondID
 {
@@ -93,9 +95,12 @@ protected:
 	virtual bool UseShapes() { return false; }
 	virtual bool IsImpossible() { return false; }
 	virtual bool IsEnsured() { return false; }
+	virtual C4ID GetIndexID() { return C4ID_None; } // if not C4ID_None, all matching objects have this ID
+	virtual bool HasSideEffects() { return false; } // may Check() change the object list?
 
 private:
 	void CheckObjectStatus(C4ValueArray *pArray);
+	const std::vector<C4Object *> *GetIndexCandidates(const C4ObjectList &Objs); // objects to check instead of a full list scan, if any
 };
 
 // Combinators
@@ -113,6 +118,7 @@ protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override { return pCond->IsEnsured(); }
 	virtual bool IsEnsured() override { return pCond->IsImpossible(); }
+	virtual bool HasSideEffects() override { return pCond->HasSideEffects(); }
 };
 
 class C4FindObjectAnd : public C4FindObject
@@ -132,6 +138,8 @@ protected:
 	virtual bool UseShapes() override { return fUseShapes; }
 	virtual bool IsEnsured() override { return !iCnt; }
 	virtual bool IsImpossible() override;
+	virtual C4ID GetIndexID() override;
+	virtual bool HasSideEffects() override;
 };
 
 class C4FindObjectOr : public C4FindObject
@@ -150,6 +158,7 @@ protected:
 	virtual C4Rect *GetBounds() override { return fHasBounds ? &Bounds : nullptr; }
 	virtual bool IsEnsured() override;
 	virtual bool IsImpossible() override { return !iCnt; }
+	virtual bool HasSideEffects() override;
 };
 
 // Primitive conditions
@@ -178,6 +187,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual C4ID GetIndexID() override { return id; }
 };
 
 class C4FindObjectInRect : public C4FindObject
@@ -363,6 +373,7 @@ private:
 protected:
 	virtual bool Check(C4Object *pObj) override;
 	virtual bool IsImpossible() override;
+	virtual bool HasSideEffects() override { return true; }
 };
 
 class C4FindObjectLayer : public C4FindObject
@@ -405,6 +416,7 @@ public:
 
 	virtual bool PrepareCache(const C4ValueList *pObjs) { return false; }
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) { return Compare(pObj1, pObj2); }
+	virtual bool HasSideEffects() { return false; } // may Compare() change the object list?
 
 public:
 	static C4SortObject *CreateByValue(const C4Value &Data);
@@ -447,6 +459,7 @@ protected:
 
 	virtual bool PrepareCache(const C4ValueList *pObjs) override;
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	virtual bool HasSideEffects() override { return pSort->HasSideEffects(); }
 };
 
 class C4SortObjectMultiple : public C4SortObject // apply next sort if previous compares to equality
@@ -466,6 +479,7 @@ protected:
 
 	virtual bool PrepareCache(const C4ValueList *pObjs) override;
 	virtual int32_t CompareCache(int32_t iObj1, int32_t iObj2, C4Object *pObj1, C4Object *pObj2) override;
+	virtual bool HasSideEffects() override;
 };
 
 class C4SortObjectDistance : public C4SortObjectByValue // sort by distance from point x/y
@@ -529,4 +543,5 @@ private:
 
 protected:
 	int32_t CompareGetValue(C4Object *pFor) override;
+	virtual bool HasSideEffects() override { return true; }
 };
@@ -0,0 +1,101 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// per-frame timeline of game execution phases, exportable as Chrome trace
+
+#include <C4Include.h>
+#include <C4FrameProfiler.h>
+
+#include <algorithm>
+#include <utility>
+
+C4FrameProfiler::C4FrameProfiler()
+	: fActive(false), fTimeline(false), NextSpan(0), SpanCount(0) {}
+
+void C4FrameProfiler::Start(bool fTimeline)
+{
+	Clear();
+	// the buffer is only allocated once somebody actually records a timeline
+	if (fTimeline) Spans.resize(C4FrameProfilerMaxSpans);
+	this->fTimeline = fTimeline;
+	StartTime = std::chrono::steady_clock::now();
+	fActive = true;
+}
+
+void C4FrameProfiler::Stop()
+{
+	fActive = false;
+	DefTimes.clear();
+}
+
+void C4FrameProfiler::Clear()
+{
+	NextSpan = SpanCount = 0;
+	DefTimes.clear();
+	PhaseTotals.clear();
+}
+
+void C4FrameProfiler::PushSpan(const Span &rSpan)
+{
+	Spans[NextSpan] = rSpan;
+	NextSpan = (NextSpan + 1) % Spans.size();
+	SpanCount = std::min(SpanCount + 1, Spans.size());
+}
+
+void C4FrameProfiler::AddSpan(const char *szName, int32_t iFrame, uint64_t iStart, uint64_t iEnd)
+{
+	// there are only a handful of phases; span names are static, so comparing pointers is enough
+	auto it = std::find_if(PhaseTotals.begin(), PhaseTotals.end(), [szName](const PhaseTotal &Total) { return Total.Name == szName; });
+	if (it == PhaseTotals.end())
+		it = PhaseTotals.insert(PhaseTotals.end(), {szName, 0, 0});
+	it->Duration += iEnd - iStart;
+	++it->Count;
+	if (fTimeline)
+		PushSpan({szName, C4ID_None, iFrame, iStart, iEnd - iStart, C4FPT_Game});
+}
+
+void C4FrameProfiler::FlushDefTimes(int32_t iFrame, uint64_t iStart)
+{
+	// most expensive definitions first, laid out back to back
+	std::vector<std::pair<C4ID, uint64_t>> Times(DefTimes.begin(), DefTimes.end());
+	std::sort(Times.begin(), Times.end(), [](const auto &a, const auto &b) { return a.second > b.second || (a.second == b.second && a.first < b.first); });
+	for (const auto &Time : Times)
+	{
+		PushSpan({nullptr, Time.first, iFrame, iStart, Time.second, C4FPT_Defs});
+		iStart += Time.second;
+	}
+	DefTimes.clear();
+}
+
+bool C4FrameProfiler::ExportChromeTrace(const char *szFilename) const
+{
+	StdStrBuf Out;
+	Out.Append("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	Out.AppendFormat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Game\"}},\n", C4FPT_Game);
+	Out.AppendFormat("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"Object definitions\"}}", C4FPT_Defs);
+	// oldest span first
+	const size_t iFirst = (NextSpan + Spans.size() - SpanCount) % std::max<size_t>(Spans.size(), 1);
+	for (size_t i = 0; i < SpanCount; i++)
+	{
+		const Span &rSpan = Spans[(iFirst + i) % Spans.size()];
+		Out.AppendFormat(",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":1,\"tid\":%d,\"args\":{\"frame\":%d}}",
+			rSpan.Name ? rSpan.Name : C4IdText(rSpan.id),
+			rSpan.Track == C4FPT_Defs ? "definition" : "game",
+			static_cast<unsigned long long>(rSpan.Start), static_cast<unsigned long long>(rSpan.Duration),
+			rSpan.Track, rSpan.Frame);
+	}
+	Out.Append("\n]}\n");
+	return Out.SaveToFile(szFilename);
+}
@@ -0,0 +1,109 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// per-frame timeline of game execution phases, exportable as Chrome trace
+
+#pragma once
+
+#include "C4Id.h"
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+const size_t C4FrameProfilerMaxSpans = 1 << 16; // ring buffer size; older spans are overwritten
+
+// timeline tracks (shown as threads in the trace viewer)
+enum C4FrameProfilerTrack
+{
+	C4FPT_Game = 1, // execution phases
+	C4FPT_Defs = 2, // object execution time summed up per definition
+};
+
+class C4FrameProfiler
+{
+public:
+	C4FrameProfiler();
+
+	struct PhaseTotal
+	{
+		const char *Name; // static span name
+		uint64_t Duration; // microseconds
+		int32_t Count;
+	};
+
+private:
+	struct Span
+	{
+		const char *Name; // static string; nullptr for definition spans
+		C4ID id; // definition for C4FPT_Defs spans
+		int32_t Frame;
+		uint64_t Start, Duration; // microseconds since profiler start
+		C4FrameProfilerTrack Track;
+	};
+
+	bool fActive;
+	bool fTimeline; // if not set, only phase totals are recorded
+	std::chrono::steady_clock::time_point StartTime;
+	std::vector<Span> Spans; // ring buffer
+	size_t NextSpan, SpanCount;
+	std::unordered_map<C4ID, uint64_t> DefTimes; // current frame's object execution time per definition
+	std::vector<PhaseTotal> PhaseTotals; // in order of first occurrence
+
+public:
+	bool IsActive() const { return fActive; }
+	bool IsTimelineActive() const { return fActive && fTimeline; }
+	void Start(bool fTimeline = true); // clears recorded spans and totals
+	void Stop(); // keeps recorded spans for export
+	void Clear();
+
+	uint64_t Now() const { return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - StartTime).count(); }
+
+	void AddSpan(const char *szName, int32_t iFrame, uint64_t iStart, uint64_t iEnd);
+	void AddDefTime(C4ID id, uint64_t iTime) { DefTimes[id] += iTime; }
+	void FlushDefTimes(int32_t iFrame, uint64_t iStart); // put summed definition times onto the timeline, starting at iStart
+
+	bool ExportChromeTrace(const char *szFilename) const;
+	const std::vector<PhaseTotal> &GetPhaseTotals() const { return PhaseTotals; }
+
+private:
+	void PushSpan(const Span &rSpan);
+};
+
+// records a span from construction to destruction, if the profiler is active
+class C4FrameProfilerSpan
+{
+public:
+	C4FrameProfilerSpan(C4FrameProfiler &rProfiler, const char *szName, int32_t iFrame)
+		: rProfiler(rProfiler), szName(szName), iFrame(iFrame), fActive(rProfiler.IsActive()), iStart(fActive ? rProfiler.Now() : 0) {}
+
+	~C4FrameProfilerSpan()
+	{
+		// spans must have been started with the profiler running
+		if (fActive && rProfiler.IsActive())
+			rProfiler.AddSpan(szName, iFrame, iStart, rProfiler.Now());
+	}
+
+	C4FrameProfilerSpan(const C4FrameProfilerSpan &) = delete;
+	C4FrameProfilerSpan &operator=(const C4FrameProfilerSpan &) = delete;
+
+private:
+	C4FrameProfiler &rProfiler;
+	const char *szName;
+	int32_t iFrame;
+	bool fActive;
+	uint64_t iStart;
+};
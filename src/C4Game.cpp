@@ -60,6 +60,7 @@
 #undef None
 #endif
 
+#include <chrono>
 #include <iterator>
 #include <sstream>
 #include <utility>
@@ -86,6 +87,7 @@ bool C4Game::InitDefs()
 {
 	int32_t iDefs = 0;
 	Log(LoadResStr("IDS_PRC_INITDEFS"));
+	const auto StartTime = std::chrono::steady_clock::now();
 	int iDefResCount = 0;
 	for (const auto &def : Parameters.GameRes.iterRes(NRT_Definitions))
 		++iDefResCount;
@@ -105,6 +107,12 @@ bool C4Game::InitDefs()
 	// Load for scenario file - ignore sys group here, because it has been loaded already
 	iDefs += Defs.Load(ScenarioFile, C4D_Load_RX, Config.General.LanguageEx, &*Application.SoundSystem, true, true, 35, 40, false);
 
+	// startup timing
+	const int32_t iDecodeThreads = C4DefGraphicsPreloader::GetThreadCount();
+	LogF("Startup: %d definitions loaded in %lld ms (graphics decoding: %s)", iDefs,
+		static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - StartTime).count()),
+		iDecodeThreads ? FormatString("%d threads", static_cast<int>(iDecodeThreads)).getData() : "sequential");
+
 	// Absolutely no defs: we don't like that
 	if (!iDefs) { LogFatal(LoadResStr("IDS_PRC_NODEFS")); return false; }
 
@@ -138,6 +146,19 @@ bool C4Game::OpenScenario()
 		SCopy(RecordFile.getData(), ScenarioFilename, _MAX_PATH);
 	}
 
+	// seeking in a record: start from the last keyframe before the target frame
+	if (ReplaySeekFrame > 0 && ScenarioFilename[0])
+	{
+		C4Group RecordGrp; C4RecordKeyframe Keyframe;
+		if (RecordGrp.Open(ScenarioFilename) && C4Playback::FindKeyframe(RecordGrp, ReplaySeekFrame, &Keyframe))
+		{
+			RecordGrp.Close();
+			LogF("Record: Starting at keyframe (Frame %d)", Keyframe.Frame);
+			SAppend(DirSep, ScenarioFilename, _MAX_PATH);
+			SAppend(Keyframe.Filename.getData(), ScenarioFilename, _MAX_PATH);
+		}
+	}
+
 	// Scenario filename check & log
 	if (!ScenarioFilename[0]) { LogFatal(LoadResStr("IDS_PRC_NOC4S")); return false; }
 	LogF(LoadResStr("IDS_PRC_LOADC4S"), ScenarioFilename);
@@ -744,14 +765,14 @@ C4ST_NEW(MusicSystemStat, "C4Game::Execute MusicSystem.Execute")
 C4ST_NEW(MessagesStat,    "C4Game::Execute Messages.Execute")
 C4ST_NEW(ScriptStat,      "C4Game::Execute Script.Execute")
 
-#define EXEC_S(Expressions, Stat) \
-	{ C4ST_START(Stat) Expressions C4ST_STOP(Stat) }
+#define EXEC_S(Expressions, Stat, Name) \
+	{ C4ST_START(Stat) C4FrameProfilerSpan ProfilerSpan(FrameProfiler, Name, FrameCounter); Expressions C4ST_STOP(Stat) }
 
 #ifdef DEBUGREC
-#define EXEC_S_DR(Expressions, Stat, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); EXEC_S(Expressions, Stat) }
+#define EXEC_S_DR(Expressions, Stat, Name, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); EXEC_S(Expressions, Stat, Name) }
 #define EXEC_DR(Expressions, DebugRecName) { AddDbgRec(RCT_Block, DebugRecName, 6); Expressions }
 #else
-#define EXEC_S_DR(Expressions, Stat, DebugRecName) EXEC_S(Expressions, Stat)
+#define EXEC_S_DR(Expressions, Stat, Name, DebugRecName) EXEC_S(Expressions, Stat, Name)
 #define EXEC_DR(Expressions, DebugRecName) Expressions
 #endif
 
@@ -765,7 +786,7 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	// Prepare control
 	bool fControl;
-	EXEC_S(fControl = Control.Prepare();, ControlStat)
+	EXEC_S(fControl = Control.Prepare();, ControlStat, "Control.Prepare")
 	if (!fControl) return false; // not ready yet: wait
 
 	// Halt
@@ -776,12 +797,18 @@ bool C4Game::Execute() // Returns true if the game is over
 #endif
 
 	// Execute the control
-	Control.Execute();
+	{
+		C4FrameProfilerSpan ProfilerSpan(FrameProfiler, "Control.Execute", FrameCounter);
+		Control.Execute();
+	}
 	if (!IsRunning) return false;
 
 	// Ticks
 	EXEC_DR(Ticks();, "Ticks")
 
+	// everything up to the end of this function makes up the frame in the profiler timeline
+	C4FrameProfilerSpan FrameSpan(FrameProfiler, "Frame", FrameCounter);
+
 #ifdef DEBUGREC
 	// debugrec
 	AddDbgRec(RCT_DbgFrame, &FrameCounter, sizeof(int32_t));
@@ -789,19 +816,19 @@ bool C4Game::Execute() // Returns true if the game is over
 
 	// Game
 
-	EXEC_S(ExecObjects();, ExecObjectsStat)
+	EXEC_S(ExecObjects();, ExecObjectsStat, "ExecObjects")
 	if (pGlobalEffects)
-		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, GEStats, "GEEx\0");
-	EXEC_S_DR(PXS.Execute();,                      PXSStat,         "PXSEx")
-	EXEC_S_DR(Particles.GlobalParticles.Exec();,   PartStat,        "ParEx")
-	EXEC_S_DR(MassMover.Execute();,                MassMoverStat,   "MMvEx")
-	EXEC_S_DR(Weather.Execute();,                  WeatherStat,     "WtrEx")
-	EXEC_S_DR(Landscape.Execute();,                LandscapeStat,   "LdsEx")
-	EXEC_S_DR(Players.Execute();,                  PlayersStat,     "PlrEx")
+		EXEC_S_DR(pGlobalEffects->Execute(nullptr);, GEStats, "GlobalEffects", "GEEx\0");
+	EXEC_S_DR(PXS.Execute();,                      PXSStat,         "PXS",         "PXSEx")
+	EXEC_S_DR(Particles.GlobalParticles.Exec();,   PartStat,        "Particles",   "ParEx")
+	EXEC_S_DR(MassMover.Execute();,                MassMoverStat,   "MassMover",   "MMvEx")
+	EXEC_S_DR(Weather.Execute();,                  WeatherStat,     "Weather",     "WtrEx")
+	EXEC_S_DR(Landscape.Execute();,                LandscapeStat,   "Landscape",   "LdsEx")
+	EXEC_S_DR(Players.Execute();,                  PlayersStat,     "Players",     "PlrEx")
 	// FIXME: C4Application::Execute should do this, but what about the stats?
-	EXEC_S_DR(Application.MusicSystem->Execute();, MusicSystemStat, "Music")
-	EXEC_S_DR(Messages.Execute();,                 MessagesStat,    "MsgEx")
-	EXEC_S_DR(Script.Execute();,                   ScriptStat,      "Scrpt")
+	EXEC_S_DR(Application.MusicSystem->Execute();, MusicSystemStat, "MusicSystem", "Music")
+	EXEC_S_DR(Messages.Execute();,                 MessagesStat,    "Messages",    "MsgEx")
+	EXEC_S_DR(Script.Execute();,                   ScriptStat,      "Script",      "Scrpt")
 
 	EXEC_DR(MouseControl.Execute();, "Input")
 
@@ -1096,7 +1123,7 @@ C4Object *C4Game::NewObject(C4Def *pDef, C4Object *pCreator,
 	// ---- From now on, object is ready to be used in scripts!
 	// Construction callback
 	C4AulParSet pars(C4VObj(pCreator));
-	objPtr->Call(PSF_Construction, pars);
+	objPtr->Call(OCB_Construction, pars);
 	// AssignRemoval called? (Con 0)
 	if (!objPtr->Status) { return nullptr; }
 	// Do initial con
@@ -1548,20 +1575,40 @@ void C4Game::ExecObjects() // Every Tick1 by Execute
 
 	// Execute objects - reverse order to ensure
 	C4Object *cObj; C4ObjectLink *clnk;
-	for (clnk = Objects.Last; clnk && (cObj = clnk->Obj); clnk = clnk->Prev)
-		if (cObj->Status)
-			// Execute object
-			cObj->Execute();
-		else
-			// Status reset: process removal delay
-			if (cObj->RemovalDelay > 0) cObj->RemovalDelay--;
+	if (FrameProfiler.IsTimelineActive())
+	{
+		// same as below, but sum up execution time per definition
+		const uint64_t iStart = FrameProfiler.Now();
+		for (clnk = Objects.Last; clnk && (cObj = clnk->Obj); clnk = clnk->Prev)
+			if (cObj->Status)
+			{
+				const C4ID idObj = cObj->id;
+				const uint64_t iObjStart = FrameProfiler.Now();
+				cObj->Execute();
+				FrameProfiler.AddDefTime(idObj, FrameProfiler.Now() - iObjStart);
+			}
+			else
+				if (cObj->RemovalDelay > 0) cObj->RemovalDelay--;
+		FrameProfiler.FlushDefTimes(FrameCounter, iStart);
+	}
+	else
+		for (clnk = Objects.Last; clnk && (cObj = clnk->Obj); clnk = clnk->Prev)
+			if (cObj->Status)
+				// Execute object
+				cObj->Execute();
+			else
+				// Status reset: process removal delay
+				if (cObj->RemovalDelay > 0) cObj->RemovalDelay--;
 
 #ifdef DEBUGREC
 	AddDbgRec(RCT_Block, "ObjCC", 6);
 #endif
 
 	// Cross check objects
-	Objects.CrossCheck();
+	{
+		C4FrameProfilerSpan ProfilerSpan(FrameProfiler, "CrossCheck", FrameCounter);
+		Objects.CrossCheck();
+	}
 
 #ifdef DEBUGREC
 	AddDbgRec(RCT_Block, "ObjRs", 6);
@@ -1703,6 +1750,7 @@ void C4Game::Default()
 	FrameCounter = 0;
 	GameOver = GameOverDlgShown = false;
 	ScenarioFilename[0] = 0;
+	ReplaySeekFrame = 0;
 	PlayerFilenames[0] = 0;
 	DefinitionFilenames.clear();
 	FixedDefinitions = false;
@@ -2593,6 +2641,7 @@ bool C4Game::InitGameSecondPart(C4Group &hGroup, C4ScenarioSection *section, boo
 
 	// Pathfinder
 	if (!section) PathFinder.Init(&LandscapeFree, &TransferZones);
+	PathFinder.SetNavigationGrid(C4S.Landscape.PathFinder == C4S_PathFinder_Grid, Landscape.Width, Landscape.Height);
 	SetInitProgress(90);
 
 	// PXS
@@ -3101,6 +3150,23 @@ void C4Game::ParseCommandLine(const char *szCmdLine)
 		// Trained Crew (Player Crew)
 		if (SEqualNoCase(szParameter, "/ucrw") || SEqualNoCase(szParameter, "/trainedcrew"))
 			Config.General.FairCrew = false;
+		// headless replay benchmark
+		if (SEqual2NoCase(szParameter, "/benchmark-replay:"))
+		{
+			SCopy(szParameter + 18, ScenarioFilename, _MAX_PATH);
+			Application.ReplayBenchmark = std::make_unique<C4ReplayBenchmark>();
+			continue;
+		}
+		// collision check benchmark on a scratch game
+		if (SEqual2NoCase(szParameter, "/benchmark-crosscheck:"))
+		{
+			SCopy(szParameter + 22, ScenarioFilename, _MAX_PATH);
+			Application.CrossCheckBenchmark = true;
+			continue;
+		}
+		// seek in record
+		if (SEqual2NoCase(szParameter, "/seek:"))
+			ReplaySeekFrame = atoi(szParameter + 6);
 		// record dump
 		if (SEqual2NoCase(szParameter, "/recdump:"))
 			RecordDumpFile.Copy(szParameter + 9);
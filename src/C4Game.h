@@ -48,6 +48,7 @@
 #include <C4GameControl.h>
 #include <C4Effects.h>
 #include <C4Fonts.h>
+#include <C4FrameProfiler.h>
 #include "C4LangStringTable.h"
 #include "C4Scoreboard.h"
 #include <C4Network2.h>
@@ -122,6 +123,7 @@ public:
 	C4Control &Input; // shortcut
 
 	C4PathFinder PathFinder;
+	C4FrameProfiler FrameProfiler;
 	C4TransferZones TransferZones;
 	C4Group ScenarioFile;
 	C4GroupSet GroupSet;
@@ -158,6 +160,7 @@ public:
 	bool Verbose; // default false; set to true only by command line
 	StdStrBuf RecordDumpFile;
 	StdStrBuf RecordStream;
+	int32_t ReplaySeekFrame; // set by command line: replays start at the last keyframe before and fast-forward to it
 	bool TempScenarioFile;
 	bool fPreinited; // set after PreInit has been called; unset by Clear and Default
 	int32_t FrameCounter;
@@ -129,6 +129,9 @@ void C4GameControl::OnGameSynchronizing()
 		fRecordNeeded = false;
 		StartRecord(false, false);
 	}
+	// otherwise, a running record may take a keyframe to seek to
+	else if (pRecord && pRecord->IsKeyframeDue(Game.FrameCounter))
+		pRecord->SaveKeyframe(pExecutingControl != nullptr);
 }
 
 bool C4GameControl::StartRecord(bool fInitial, bool fStreaming)
@@ -221,6 +224,8 @@ void C4GameControl::Default()
 	ControlTick = 0;
 	SyncRate = C4SyncCheckRate;
 	DoSync = false;
+	SyncChecksPassed = 0;
+	SyncLossFrame = -1;
 	fRecordNeeded = false;
 	pExecutingControl = nullptr;
 }
@@ -324,6 +329,12 @@ void C4GameControl::Ticks()
 	if (!(Game.FrameCounter % SyncRate))
 		DoSync = true;
 
+	// the host requests synchronizations for record keyframes through the control,
+	// so all clients and replays execute them at the same frames
+	if (fHost && (pRecord || eMode == CM_Network) && Game.Parameters.KeyframeInterval > 0)
+		if (Game.FrameCounter && !(Game.FrameCounter % Game.Parameters.KeyframeInterval))
+			DoInput(CID_Synchronize, new C4ControlSynchronize(false, true), CDT_Queue);
+
 	// calc next tick without waiting for timer? (catchup cases)
 	if (eMode == CM_Network)
 		if (Network.CtrlOverflow(ControlTick))
@@ -91,6 +91,9 @@ public:
 	int32_t ControlTick;
 	int32_t SyncRate;
 	bool DoSync;
+	// sync check results (compared against recorded or received checks)
+	int32_t SyncChecksPassed;
+	int32_t SyncLossFrame; // -1 if no sync loss occurred
 
 public:
 	// configuration
@@ -28,6 +28,56 @@
 #include <C4Game.h>
 #include <C4Wrappers.h>
 
+#include <chrono>
+#include <cmath>
+
+C4ObjectPosGrid::C4ObjectPosGrid()
+	: CellsX(1), CellsY(1), BuildCnt(0) {}
+
+void C4ObjectPosGrid::Init(int32_t iWidth, int32_t iHeight)
+{
+	CellsX = std::max<int32_t>(1, (iWidth + C4ObjectPosGridCellSize - 1) / C4ObjectPosGridCellSize);
+	CellsY = std::max<int32_t>(1, (iHeight + C4ObjectPosGridCellSize - 1) / C4ObjectPosGridCellSize);
+	CellStart.clear();
+	Positions.clear();
+}
+
+void C4ObjectPosGrid::Build(C4ObjectList &rObjects, uint32_t dwOCF)
+{
+	++BuildCnt;
+	// count objects per cell (objects outside the landscape go to the border cells)
+	CellStart.assign(CellsX * CellsY + 1, 0);
+	C4Object *pObj;
+	for (C4ObjectList::iterator iter = rObjects.begin(); iter != rObjects.end() && (pObj = *iter); ++iter)
+		if (pObj->Status && !pObj->Contained && (pObj->OCF & dwOCF))
+			++CellStart[CellX(pObj->x) + CellY(pObj->y) * CellsX + 1];
+	// prefix sum
+	for (size_t i = 1; i < CellStart.size(); i++)
+		CellStart[i] += CellStart[i - 1];
+	// sort in
+	Positions.resize(CellStart.back());
+	std::vector<int32_t> fill(CellStart.begin(), CellStart.end() - 1);
+	for (C4ObjectList::iterator iter = rObjects.begin(); iter != rObjects.end() && (pObj = *iter); ++iter)
+		if (pObj->Status && !pObj->Contained && (pObj->OCF & dwOCF))
+			Positions[fill[CellX(pObj->x) + CellY(pObj->y) * CellsX]++] = {pObj->x, pObj->y};
+}
+
+bool C4ObjectPosGrid::AnyInRect(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt) const
+{
+	if (iWdt <= 0 || iHgt <= 0 || Positions.empty()) return false;
+	const int32_t iCX1 = CellX(iX), iCX2 = CellX(iX + iWdt - 1),
+	              iCY1 = CellY(iY), iCY2 = CellY(iY + iHgt - 1);
+	for (int32_t iCY = iCY1; iCY <= iCY2; iCY++)
+		for (int32_t iCX = iCX1; iCX <= iCX2; iCX++)
+		{
+			const int32_t iCell = iCX + iCY * CellsX;
+			for (int32_t i = CellStart[iCell]; i < CellStart[iCell + 1]; i++)
+				if (Inside<int32_t>(Positions[i].first - iX, 0, iWdt - 1) && Inside<int32_t>(Positions[i].second - iY, 0, iHgt - 1))
+					return true;
+		}
+	return false;
+}
+
 C4GameObjects::C4GameObjects()
 {
 	Default();
@@ -43,12 +93,15 @@ void C4GameObjects::Default()
 	ResortProc = nullptr;
 	Sectors.Clear();
 	LastUsedMarker = 0;
+	IDIndex.clear();
+	fIDIndexValid = false;
 }
 
 void C4GameObjects::Init(int32_t iWidth, int32_t iHeight)
 {
 	// init sectors
 	Sectors.Init(iWidth, iHeight);
+	CrossCheckGrid.Init(iWidth, iHeight);
 }
 
 bool C4GameObjects::Add(C4Object *nObj)
@@ -128,8 +181,8 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 							if (Game.Players.Hostile(obj1->Owner, obj2->Owner))
 							{
 								// RejectFight callback
-								if (obj1->Call(PSF_RejectFight, {C4VObj(obj2)}).getBool()) continue;
-								if (obj2->Call(PSF_RejectFight, {C4VObj(obj1)}).getBool()) continue;
+								if (obj1->Call(OCB_RejectFight, {C4VObj(obj2)}).getBool()) continue;
+								if (obj2->Call(OCB_RejectFight, {C4VObj(obj1)}).getBool()) continue;
 								ObjectActionFight(obj1, obj2);
 								ObjectActionFight(obj2, obj1);
 								continue;
@@ -147,10 +200,25 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 	}
 	focf |= OCF_Alive; tocf |= OCF_HitSpeed2;
 
+	// Objects without any possible partner inside their shape are skipped. This does not change
+	// the order of checks. Callbacks may change any object, so the snapshot isn't trusted after them:
+	// objects are checked completely until enough of them have been to pay for retaking it.
+	bool fGridValid = false;
+	size_t iGridRebuildDelay = 0;
+
 	if (focf && tocf)
 		for (C4ObjectList::iterator iter = begin(); iter != end() && (obj1 = *iter); ++iter)
 			if (obj1->Status && !obj1->Contained && (obj1->OCF & focf))
 			{
+				if (!fGridValid && !iGridRebuildDelay)
+				{
+					CrossCheckGrid.Build(*this, tocf);
+					fGridValid = true;
+				}
+				else if (!fGridValid)
+					--iGridRebuildDelay;
+				if (fGridValid && !CrossCheckGrid.AnyInRect(obj1->x + obj1->Shape.x, obj1->y + obj1->Shape.y, obj1->Shape.Wdt, obj1->Shape.Hgt))
+					continue;
 				uint32_t Marker = GetNextMarker();
 				C4LSector *pSct;
 				for (C4ObjectList *pLst = obj1->Area.FirstObjects(&pSct); pLst; pLst = obj1->Area.NextObjects(pLst, &pSct))
@@ -165,7 +233,11 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 										obj2->Marker = Marker;
 										// Hit
 										if ((obj2->OCF & OCF_HitSpeed2) && (obj1->OCF & OCF_Alive) && (obj2->Category & C4D_Object))
-											if (!obj1->Call(PSF_QueryCatchBlow, {C4VObj(obj2)}))
+										{
+											// callbacks may change any object
+											if (fGridValid) iGridRebuildDelay = CrossCheckGrid.GetSize() / C4ObjectPosGridRebuildRatio;
+											fGridValid = false;
+											if (!obj1->Call(OCB_QueryCatchBlow, {C4VObj(obj2)}))
 											{
 												// "realistic" hit energy
 												C4Fixed dXDir = obj2->xdir - obj1->xdir, dYDir = obj2->ydir - obj1->ydir;
@@ -175,18 +247,21 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 												int tmass = std::max<int32_t>(obj1->Mass, 50);
 												if (!Tick3 || (obj1->Action.Act >= 0 && obj1->Def->ActMap[obj1->Action.Act].Procedure != DFA_FLIGHT))
 													obj1->Fling(obj2->xdir * 50 / tmass, -Abs(obj2->ydir / 2) * 50 / tmass, false, obj2->Controller);
-												obj1->Call(PSF_CatchBlow, {C4VInt(-iHitEnergy / 5),
+												obj1->Call(OCB_CatchBlow, {C4VInt(-iHitEnergy / 5),
 													C4VObj(obj2)});
 												// obj1 might have been tampered with
 												if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
 													goto out1;
 												continue;
 											}
+										}
 										// Collection
 										if ((obj1->OCF & OCF_Collection) && (obj2->OCF & OCF_Carryable))
 											if (Inside<int32_t>(obj2->x - (obj1->x + obj1->Def->Collection.x), 0, obj1->Def->Collection.Wdt - 1))
 												if (Inside<int32_t>(obj2->y - (obj1->y + obj1->Def->Collection.y), 0, obj1->Def->Collection.Hgt - 1))
 												{
+													if (fGridValid) iGridRebuildDelay = CrossCheckGrid.GetSize() / C4ObjectPosGridRebuildRatio;
+													fGridValid = false;
 													obj1->Collect(obj2);
 													// obj1 might have been tampered with
 													if (!obj1->Status || obj1->Contained || !(obj1->OCF & focf))
@@ -231,6 +306,46 @@ void C4GameObjects::CrossCheck() // Every Tick1 by ExecObjects
 			}
 }
 
+bool C4GameObjects::CrossCheckBenchmark(int32_t iFrames)
+{
+	// this fills the game with objects and calls their callbacks over and over,
+	// so it may only run on a game that was loaded for it (/benchmark-crosscheck)
+	if (!Application.CrossCheckBenchmark) return false;
+	// living things that collect and get hit by flying objects
+	C4Def *pLiving = nullptr, *pThing = nullptr;
+	for (std::size_t i = 0; C4Def *pDef = Game.Defs.GetDef(i, C4D_Living); i++)
+		if (!pLiving || (pDef->Collection.Wdt > 0 && pLiving->Collection.Wdt <= 0))
+			pLiving = pDef;
+	for (std::size_t i = 0; C4Def *pDef = Game.Defs.GetDef(i, C4D_Object); i++)
+		if (pDef->Carryable) { pThing = pDef; break; }
+	if (!pLiving || !pThing) return false;
+	for (const int32_t iCount : {500, 2000, 5000})
+	{
+		// about one object per 20x20 pixels
+		const int32_t iWdt = std::min<int32_t>(GBackWdt, static_cast<int32_t>(std::sqrt(iCount * 400.0))),
+		              iHgt = std::min<int32_t>(GBackHgt, iCount * 400 / std::max<int32_t>(iWdt, 1));
+		std::vector<C4Object *> Objects;
+		for (int32_t i = 0; i < iCount; i++)
+		{
+			const bool fLiving = !(i % 2);
+			C4Object *pObj = Game.CreateObject(fLiving ? pLiving->id : pThing->id, nullptr, NO_OWNER, SafeRandom(iWdt), SafeRandom(iHgt), 0,
+				fLiving ? Fix0 : itofix(SafeRandom(11) - 5), fLiving ? Fix0 : itofix(5));
+			if (pObj) Objects.push_back(pObj);
+		}
+		const int32_t iBuilds = CrossCheckGrid.GetBuildCount();
+		const auto Start = std::chrono::steady_clock::now();
+		for (int32_t iFrame = 0; iFrame < iFrames; iFrame++)
+			CrossCheck();
+		const double dTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+		LogF("Benchmark: %5d objects: %.2f ms/frame, %.1f grid rebuilds/frame", static_cast<int32_t>(Objects.size()), dTime / iFrames,
+			static_cast<double>(CrossCheckGrid.GetBuildCount() - iBuilds) / iFrames);
+		// (deleted at the end of the frame)
+		for (C4Object *pObj : Objects)
+			if (pObj->Status) pObj->AssignRemoval();
+	}
+	return true;
+}
+
 C4Object *C4GameObjects::AtObject(int ctx, int cty, uint32_t &ocf, C4Object *exclude)
 {
 	uint32_t cocf;
@@ -307,6 +422,40 @@ void C4GameObjects::PutSolidMasks()
 			cLnk->Obj->UpdateSolidMask(false);
 }
 
+void C4GameObjects::InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore)
+{
+	C4NotifyingObjectList::InsertLinkBefore(pLink, pBefore);
+	fIDIndexValid = false;
+}
+
+void C4GameObjects::InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter)
+{
+	C4NotifyingObjectList::InsertLink(pLink, pAfter);
+	fIDIndexValid = false;
+}
+
+void C4GameObjects::RemoveLink(C4ObjectLink *pLnk)
+{
+	C4NotifyingObjectList::RemoveLink(pLnk);
+	fIDIndexValid = false;
+}
+
+void C4GameObjects::BuildIDIndex()
+{
+	// keep the buckets' memory; IDs that are gone just get empty buckets
+	for (auto &Bucket : IDIndex)
+		Bucket.second.clear();
+	for (C4ObjectLink *cLnk = First; cLnk; cLnk = cLnk->Next)
+		IDIndex[cLnk->Obj->id].push_back(cLnk->Obj);
+	fIDIndexValid = true;
+}
+
+const std::vector<C4Object *> &C4GameObjects::ObjectsByID(C4ID id)
+{
+	if (!fIDIndexValid) BuildIDIndex();
+	return IDIndex[id];
+}
+
 void C4GameObjects::DeleteObjects()
 {
 	// delete links and objects
@@ -413,6 +562,8 @@ void C4ObjResort::SortObject()
 	C4ObjectLink *pLnkBck = pLnk;
 	C4Object *pObj2; int iResult;
 	if (!pLnk) return;
+	// (link changes go through the base class, which lets us use them; the index still gets invalidated)
+	C4NotifyingObjectList &Objects = Game.Objects;
 	while (pLnk = pLnk->Next)
 	{
 		// get object
@@ -432,9 +583,9 @@ void C4ObjResort::SortObject()
 		// move link directly after pMoveLink
 		// FIXME: Inform C4ObjectList that this is a reorder, not a remove+insert
 		// move out of current position
-		Game.Objects.RemoveLink(pLnkBck);
+		Objects.RemoveLink(pLnkBck);
 		// put into new position
-		Game.Objects.InsertLink(pLnkBck, pMoveLink);
+		Objects.InsertLink(pLnkBck, pMoveLink);
 	}
 	else
 	{
@@ -458,9 +609,9 @@ void C4ObjResort::SortObject()
 		if (!pMoveLink) return;
 		// move link directly before pMoveLink
 		// move out of current position
-		Game.Objects.RemoveLink(pLnkBck);
+		Objects.RemoveLink(pLnkBck);
 		// put into new position
-		Game.Objects.InsertLinkBefore(pLnkBck, pMoveLink);
+		Objects.InsertLinkBefore(pLnkBck, pMoveLink);
 	}
 	// object has been resorted: resort into area lists, too
 	Game.Objects.UpdatePosResort(pSortObj);
@@ -500,6 +651,7 @@ void C4ObjResort::Sort(C4ObjectLink *pFirst, C4ObjectLink *pLast)
 				// so there's something to be reordered: swap the links
 				// FIXME: Inform C4ObjectList about this reorder
 				C4Object *pObj = pCurr->Obj; pCurr->Obj = pCurr2->Obj; pCurr2->Obj = pObj;
+				Game.Objects.InvalidateIDIndex();
 				// and readd to sector lists
 				pCurr->Obj->Unsorted = pCurr2->Obj->Unsorted = true;
 				// grow list section to scan next
@@ -543,6 +695,7 @@ int C4GameObjects::Load(C4Group &hGroup, bool fKeepInactive)
 		Source,
 		Name.getData()))
 		return 0;
+	InvalidateIDIndex();
 
 	// Process objects
 	C4ObjectLink *cLnk;
@@ -747,6 +900,7 @@ bool C4GameObjects::OrderObjectBefore(C4Object *pObj1, C4Object *pObj2)
 	// reorder
 	if (!C4ObjectList::OrderObjectBefore(pObj1, pObj2))
 		return false;
+	InvalidateIDIndex();
 	// update area lists
 	UpdatePosResort(pObj1);
 	// done, success
@@ -761,6 +915,7 @@ bool C4GameObjects::OrderObjectAfter(C4Object *pObj1, C4Object *pObj2)
 	// reorder
 	if (!C4ObjectList::OrderObjectAfter(pObj1, pObj2))
 		return false;
+	InvalidateIDIndex();
 	// update area lists
 	UpdatePosResort(pObj1);
 	// done, success
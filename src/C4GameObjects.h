@@ -23,8 +23,38 @@
 #include <C4FindObject.h>
 #include <C4Sector.h>
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 class C4ObjResort;
 
+const int32_t C4ObjectPosGridCellSize = 32,
+              C4ObjectPosGridRebuildRatio = 8; // objects in the grid per object checked without it before it is rebuilt
+
+// snapshot of object positions, sorted into a uniform grid
+// used by CrossCheck to skip objects that have nothing in reach
+class C4ObjectPosGrid
+{
+public:
+	C4ObjectPosGrid();
+
+	void Init(int32_t iWidth, int32_t iHeight);
+	void Build(C4ObjectList &rObjects, uint32_t dwOCF); // all active, uncontained objects matching any of dwOCF
+	bool AnyInRect(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt) const; // any object position inside the rect?
+	size_t GetSize() const { return Positions.size(); }
+	int32_t GetBuildCount() const { return BuildCnt; }
+
+private:
+	int32_t CellsX, CellsY;
+	int32_t BuildCnt; // (statistics)
+	std::vector<int32_t> CellStart; // first index into Positions per cell; one extra entry at the end
+	std::vector<std::pair<int32_t, int32_t>> Positions; // sorted by cell
+
+	int32_t CellX(int32_t iX) const { return BoundBy<int32_t>(iX / C4ObjectPosGridCellSize, 0, CellsX - 1); }
+	int32_t CellY(int32_t iY) const { return BoundBy<int32_t>(iY / C4ObjectPosGridCellSize, 0, CellsY - 1); }
+};
+
 // main object list class
 class C4GameObjects : public C4NotifyingObjectList
 {
@@ -37,6 +67,16 @@ public:
 
 private:
 	uint32_t LastUsedMarker; // last used value for C4Object::Marker
+	C4ObjectPosGrid CrossCheckGrid; // collision partners for CrossCheck
+	std::unordered_map<C4ID, std::vector<C4Object *>> IDIndex; // objects by ID in list order; rebuilt lazily after list changes
+	bool fIDIndexValid;
+
+	void BuildIDIndex();
+
+protected:
+	virtual void InsertLinkBefore(C4ObjectLink *pLink, C4ObjectLink *pBefore) override;
+	virtual void InsertLink(C4ObjectLink *pLink, C4ObjectLink *pAfter) override;
+	virtual void RemoveLink(C4ObjectLink *pLnk) override;
 
 public:
 	C4LSectors Sectors; // section object lists
@@ -49,11 +89,14 @@ public:
 	C4ObjectList &ObjectsAt(int ix, int iy); // get object list for map pos
 
 	void CrossCheck(); // various collision-checks
+	bool CrossCheckBenchmark(int32_t iFrames); // logs CrossCheck timings with lots of objects; only on a scratch game
 	C4Object *AtObject(int ctx, int cty, uint32_t &ocf, C4Object *exclude = nullptr); // find object at ctx/cty
 	void Synchronize(); // network synchronization
 	uint32_t GetNextMarker();
 
 	C4Object *FindInternal(C4ID id); // find object in first sector
+	const std::vector<C4Object *> &ObjectsByID(C4ID id); // all objects of given ID in list order
+	void InvalidateIDIndex() { fIDIndexValid = false; } // call when objects are reordered or change their ID
 	virtual C4Object *ObjectPointer(int32_t iNumber) override; // object pointer by number
 	long ObjectNumber(C4Object *pObj); // object number by pointer
 
@@ -149,6 +149,9 @@ public:
 	// Automatic frame skip enabled for this game?
 	bool AutoFrameSkip;
 
+	// Frames between record keyframes; 0 for none
+	int32_t KeyframeInterval;
+
 	// Allow debug mode?
 	bool AllowDebug;
 
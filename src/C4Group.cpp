@@ -250,7 +250,7 @@ bool C4Group_DeleteItem(const char *szItem, bool fRecycle)
 	return true;
 }
 
-bool C4Group_PackDirectoryTo(const char *szFilename, const char *szFilenameTo)
+bool C4Group_PackDirectoryTo(const char *szFilename, const char *szFilenameTo, bool fSyncFlush)
 {
 	// Check file type
 	if (!DirectoryExists(szFilename)) return false;
@@ -266,6 +266,8 @@ bool C4Group_PackDirectoryTo(const char *szFilename, const char *szFilenameTo)
 	C4Group hGroup;
 	if (!hGroup.Open(szFilenameTo, true))
 		return false;
+	// child groups are stored uncompressed, so only the outermost one needs this
+	hGroup.SetSyncFlush(fSyncFlush);
 	// Add folder contents to group
 	DirectoryIterator i(szFilename);
 	for (; *i; i++)
@@ -313,14 +315,14 @@ bool C4Group_PackDirectoryTo(const char *szFilename, const char *szFilenameTo)
 	return true;
 }
 
-bool C4Group_PackDirectory(const char *szFilename)
+bool C4Group_PackDirectory(const char *szFilename, bool fSyncFlush)
 {
 	// Make temporary filename
 	char szTempFilename[_MAX_PATH + 1];
 	SCopy(szFilename, szTempFilename, _MAX_PATH);
 	MakeTempFilename(szTempFilename);
 	// Pack directory
-	if (!C4Group_PackDirectoryTo(szFilename, szTempFilename))
+	if (!C4Group_PackDirectoryTo(szFilename, szTempFilename, fSyncFlush))
 		return false;
 	// Rename folder
 	char szTempFilename2[_MAX_PATH + 1];
@@ -595,6 +597,7 @@ C4Group::C4Group()
 	fnProcessCallback = nullptr;
 	MadeOriginal = false;
 	NoSort = false;
+	SyncFlush = false;
 }
 
 void C4Group::Init()
@@ -971,7 +974,7 @@ bool C4Group::Save(bool fReOpen)
 
 	// Create the new (temp) group file
 	CStdFile tfile;
-	if (!tfile.Create(szTempFileName, true))
+	if (!tfile.Create(szTempFileName, true, false, SyncFlush))
 	{
 		delete[] save_core; return Error("Close: ...");
 	}
@@ -1223,16 +1226,20 @@ bool C4Group::SetFilePtr(size_t iOffset)
 	if (Status == GRPF_Folder)
 		return Error("SetFilePtr not implemented for Folders");
 
-	// ensure mother is at correct pos
-	if (Mother) Mother->EnsureChildFilePtr(this);
-
-	// Rewind if necessary
-	if (FilePtr > iOffset)
-		if (!RewindFilePtr()) return false;
+	// Child group in packed mother: the mother seeks
+	if (Mother && Mother->Status == GRPF_File)
+	{
+		if (!Mother->SetFilePtr(MotherOffset + EntryOffset + iOffset)) return false;
+	}
+	// Regular group or child group in folder: seek standard file
+	else
+	{
+		// ensure mother has the child file open
+		if (Mother && !Mother->EnsureChildFilePtr(this)) return false;
+		if (!(Mother ? Mother->StdFile : StdFile).Seek(EntryOffset + iOffset)) return false;
+	}
 
-	// Advance to target pointer
-	if (FilePtr < iOffset)
-		if (!AdvanceFilePtr(iOffset - FilePtr)) return false;
+	FilePtr = iOffset;
 
 	return true;
 }
@@ -1240,11 +1247,7 @@ bool C4Group::SetFilePtr(size_t iOffset)
 bool C4Group::Advance(size_t iOffset)
 {
 	if (Status == GRPF_Folder) return !!StdFile.Advance(iOffset);
-	// FIXME: reading the file one byte at a time sounds just slow.
-	uint8_t buf;
-	for (; iOffset > 0; iOffset--)
-		if (!Read(&buf, 1)) return false;
-	return true;
+	return SetFilePtr(FilePtr + iOffset);
 }
 
 bool C4Group::Read(void *pBuffer, size_t iSize)
@@ -26,23 +26,20 @@
 #include <StdCompiler.h>
 
 // C4Group-Rewind-warning:
-// The current C4Group-implementation cannot handle random file access very well,
-// because all files are written within a single zlib-stream.
-// For every out-of-order-file accessed a group-rewind must be performed, and every
-// single file up to the accessed file unpacked. As a workaround, all C4Groups are
-// packed in a file order matching the reading order of the engine.
-// If the reading order doesn't match the packing order, and a rewind has to be performed,
-// a warning is issued in Debug-builds of the engine. But since some components require
-// random access because they are loaded on-demand at runtime (e.g. global sounds), the
-// warning may be temp disabled for those files using C4GRP_DISABLE_REWINDWARN and
-// C4GRP_ENABLE_REWINDWARN. A ref counter keeps track of nested calls to those functions.
+// All files of a C4Group are written within a single zlib-stream. Packed groups can
+// be accessed in any order, because the compressed stream keeps an index of access
+// points while it is read (see StdGzCompressedFile::Read): going back to an entry
+// only unpacks from the closest access point before it, not from the group start.
+// Still, reading in packing order is fastest, so all C4Groups are packed in a file
+// order matching the reading order of the engine. If a group has to be rewound
+// after a read error, a warning is issued in Debug-builds of the engine. Components
+// that are loaded on-demand at runtime (e.g. global sounds) may temp disable the
+// warning using C4GRP_DISABLE_REWINDWARN and C4GRP_ENABLE_REWINDWARN. A ref counter
+// keeps track of nested calls to those functions.
 //
 // If you add any new components to scenario or definition files, remember to adjust the
 // sort order lists in C4Components.h accordingly, and enforce a reading order for that
 // component.
-//
-// Maybe some day, someone will write a C4Group-implementation that is probably capable of
-// random access...
 #ifdef _DEBUG
 extern int iC4GroupRewindFilePtrNoWarn;
 #define C4GRP_DISABLE_REWINDWARN ++iC4GroupRewindFilePtrNoWarn;
@@ -69,8 +66,8 @@ bool C4Group_IsGroup(const char *szFilename);
 bool C4Group_CopyItem(const char *szSource, const char *szTarget, bool fNoSort = false, bool fResetAttributes = false);
 bool C4Group_MoveItem(const char *szSource, const char *szTarget, bool fNoSort = false);
 bool C4Group_DeleteItem(const char *szItem, bool fRecycle = false);
-bool C4Group_PackDirectoryTo(const char *szFilename, const char *szFilenameTo);
-bool C4Group_PackDirectory(const char *szFilename);
+bool C4Group_PackDirectoryTo(const char *szFilename, const char *szFilenameTo, bool fSyncFlush = false);
+bool C4Group_PackDirectory(const char *szFilename, bool fSyncFlush = false);
 bool C4Group_UnpackDirectory(const char *szFilename);
 bool C4Group_ExplodeDirectory(const char *szFilename);
 bool C4Group_ReadFile(const char *szFilename, char **pData, size_t *iSize);
@@ -182,6 +179,7 @@ protected:
 	bool MadeOriginal;
 
 	bool NoSort; // If this flag is set, all entries will be marked NoSort in AddEntry
+	bool SyncFlush; // If this flag is set, unchanged parts compress to the same bytes when saving (for network transfers from similar files)
 
 public:
 	bool Open(const char *szGroupName, bool fCreate = false);
@@ -249,6 +247,7 @@ public:
 	inline bool IsPacked() { return Status == GRPF_File; }
 	inline bool HasPackedMother() { if (!Mother) return false; return Mother->IsPacked(); }
 	inline bool SetNoSort(bool fNoSort) { NoSort = fNoSort; return true; }
+	inline void SetSyncFlush(bool fSyncFlush) { SyncFlush = fSyncFlush; }
 #ifdef _DEBUG
 	void PrintInternals(const char *szIndent = nullptr);
 #endif
@@ -39,8 +39,15 @@
 #include <StdBitmap.h>
 #include <StdPNG.h>
 
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 int32_t MVehic = MNone, MTunnel = MNone, MWater = MNone, MSnow = MNone, MEarth = MNone, MGranite = MNone;
 uint8_t MCVehic = 0;
@@ -48,6 +55,78 @@ uint8_t MCVehic = 0;
 const int C4LS_MaxLightDistY = 8;
 const int C4LS_MaxLightDistX = 1;
 
+const int32_t C4LS_ScanPixelsPerThread = 8192; // less work isn't worth waking another scan thread
+
+// checks landscape columns for ExecuteScan; the threads wait for the next frame instead of being recreated
+class C4LandscapeScanWorkers
+{
+public:
+	~C4LandscapeScanWorkers();
+
+	// splits [0, iCount) into iParts ranges and runs Work on them, the calling thread helping
+	void Run(int32_t iParts, int32_t iCount, const std::function<void(int32_t, int32_t)> &Work);
+
+private:
+	std::mutex Mutex;
+	std::condition_variable WorkAvailable, WorkDone;
+	std::vector<std::thread> Threads;
+	const std::function<void(int32_t, int32_t)> *pWork = nullptr;
+	int32_t iParts = 0, iCount = 0, iNextPart = 0, iPartsDone = 0;
+	bool fQuit = false;
+
+	bool RunPart(std::unique_lock<std::mutex> &Lock); // runs the next part if there is any; Lock is released meanwhile
+	void Execute();
+};
+
+C4LandscapeScanWorkers::~C4LandscapeScanWorkers()
+{
+	{
+		const std::lock_guard<std::mutex> Lock(Mutex);
+		fQuit = true;
+	}
+	WorkAvailable.notify_all();
+	for (auto &Thread : Threads)
+		Thread.join();
+}
+
+void C4LandscapeScanWorkers::Run(int32_t iParts, int32_t iCount, const std::function<void(int32_t, int32_t)> &Work)
+{
+	std::unique_lock<std::mutex> Lock(Mutex);
+	// threads are only added, so a busy frame doesn't have to wait for them again
+	while (static_cast<int32_t>(Threads.size()) < iParts - 1)
+		Threads.emplace_back(&C4LandscapeScanWorkers::Execute, this);
+	pWork = &Work;
+	this->iParts = iParts; this->iCount = iCount;
+	iNextPart = iPartsDone = 0;
+	WorkAvailable.notify_all();
+	while (RunPart(Lock)) {}
+	WorkDone.wait(Lock, [this] { return iPartsDone == this->iParts; });
+	pWork = nullptr;
+}
+
+bool C4LandscapeScanWorkers::RunPart(std::unique_lock<std::mutex> &Lock)
+{
+	if (!pWork || iNextPart >= iParts) return false;
+	const int32_t iPart = iNextPart++;
+	const auto &Work = *pWork;
+	Lock.unlock();
+	Work(iCount * iPart / iParts, iCount * (iPart + 1) / iParts);
+	Lock.lock();
+	if (++iPartsDone == iParts) WorkDone.notify_all();
+	return true;
+}
+
+void C4LandscapeScanWorkers::Execute()
+{
+	std::unique_lock<std::mutex> Lock(Mutex);
+	for (;;)
+	{
+		WorkAvailable.wait(Lock, [this] { return fQuit || (pWork && iNextPart < iParts); });
+		if (fQuit) return;
+		while (RunPart(Lock)) {}
+	}
+}
+
 C4Landscape::C4Landscape()
 {
 	Default();
@@ -85,7 +164,7 @@ void C4Landscape::Execute()
 
 void C4Landscape::ExecuteScan()
 {
-	int32_t cy, mat;
+	int32_t mat;
 
 	// Check: Scan needed?
 	const int32_t iTemperature = Game.Weather.GetTemperature();
@@ -104,25 +183,51 @@ void C4Landscape::ExecuteScan()
 	AddDbgRec(RCT_MatScan, &ScanX, sizeof(ScanX));
 #endif
 
-	for (int32_t cnt = 0; cnt < ScanSpeed; cnt++)
+	// Materials that will convert when scanned downwards/upwards; this mirrors the check at the start of DoScan
+	std::vector<uint8_t> convDown(Game.Material.Num), convUp(Game.Material.Num);
+	for (mat = 0; mat < Game.Material.Num; mat++)
 	{
-		// Scan landscape column: sectors down
-		int32_t last_mat = -1;
-		for (cy = 0; cy < Height; cy++)
+		const C4Material &material = Game.Material.Map[mat];
+		for (int32_t dir = 0; dir < 2; dir++)
 		{
-			mat = _GetMat(ScanX, cy);
-			// material change?
-			if (last_mat != mat)
-			{
-				// upwards
-				if (last_mat != -1)
-					DoScan(ScanX, cy - 1, last_mat, 1);
-				// downwards
-				if (mat != -1)
-					cy += DoScan(ScanX, cy, mat, 0);
-			}
-			last_mat = mat;
+			const bool conv =
+				(material.BelowTempConvertDir == dir && material.BelowTempConvertTo && iTemperature < material.BelowTempConvert) ||
+				(material.AboveTempConvertDir == dir && material.AboveTempConvertTo && iTemperature > material.AboveTempConvert);
+			(dir == 0 ? convDown : convUp)[mat] = conv;
 		}
+	}
+
+	// Find the columns in which anything could convert at all
+	// A column is only ever changed by its own scan, so this can be decided on the current
+	// landscape for all columns at once and in parallel; the actual conversion then runs
+	// sequentially in scan order and yields exactly the same result as scanning every column.
+	const int32_t iColumns = std::min<int32_t>(ScanSpeed, Width);
+	std::vector<uint8_t> columnNeeded(iColumns);
+	const auto checkColumns = [&](int32_t iFrom, int32_t iTo)
+	{
+		for (int32_t i = iFrom; i < iTo; i++)
+			columnNeeded[i] = IsScanNeeded((ScanX + i) % Width, convDown.data(), convUp.data());
+	};
+
+	// as many threads as there is work for
+	int32_t iThreads = 1;
+	if (Config.General.ParallelLandscapeScan)
+		iThreads = BoundBy<int32_t>(iColumns * Height / C4LS_ScanPixelsPerThread, 1, std::min<int32_t>(std::max(std::thread::hardware_concurrency(), 1u), iColumns));
+
+	if (iThreads > 1)
+	{
+		if (!ScanWorkers) ScanWorkers = std::make_unique<C4LandscapeScanWorkers>();
+		ScanWorkers->Run(iThreads, iColumns, checkColumns);
+	}
+	else
+		checkColumns(0, iColumns);
+
+	for (int32_t cnt = 0; cnt < ScanSpeed; cnt++)
+	{
+		// Scan landscape column
+		// (columns scanned a second time in the same frame may have changed in the meantime)
+		if (cnt >= iColumns || columnNeeded[cnt])
+			ScanColumn(ScanX);
 
 		// Scan advance & rewind
 		ScanX++;
@@ -131,6 +236,44 @@ void C4Landscape::ExecuteScan()
 	}
 }
 
+void C4Landscape::ScanColumn(int32_t cx)
+{
+	// Scan landscape column: sectors down
+	int32_t last_mat = -1;
+	for (int32_t cy = 0; cy < Height; cy++)
+	{
+		const int32_t mat = _GetMat(cx, cy);
+		// material change?
+		if (last_mat != mat)
+		{
+			// upwards
+			if (last_mat != -1)
+				DoScan(cx, cy - 1, last_mat, 1);
+			// downwards
+			if (mat != -1)
+				cy += DoScan(cx, cy, mat, 0);
+		}
+		last_mat = mat;
+	}
+}
+
+bool C4Landscape::IsScanNeeded(int32_t cx, const uint8_t *convDown, const uint8_t *convUp)
+{
+	// same walk as ScanColumn, but read-only: any material boundary at which DoScan would convert?
+	int32_t last_mat = -1;
+	for (int32_t cy = 0; cy < Height; cy++)
+	{
+		const int32_t mat = _GetMat(cx, cy);
+		if (last_mat != mat)
+		{
+			if (last_mat != -1 && convUp[last_mat]) return true;
+			if (mat != -1 && convDown[mat]) return true;
+			last_mat = mat;
+		}
+	}
+	return false;
+}
+
 #define PRETTY_TEMP_CONV
 
 int32_t C4Landscape::DoScan(int32_t cx, int32_t cy, int32_t mat, int32_t dir)
@@ -253,6 +396,12 @@ void C4Landscape::Clear(bool fClearMapCreator, bool fClearSky)
 	// clear pixel count
 	delete[] PixCnt;         PixCnt           = nullptr;
 	PixCntPitch = 0;
+	// clear pending relights
+	RelightTiles.clear();
+	RelightTilesX = RelightTilesY = RelightTileCount = 0;
+	PixChangeRect.Default();
+	PixChangeDepth = 0;
+	fPixChangeMatCntRemoved = false;
 }
 
 void C4Landscape::Draw(C4FacetEx &cgo, int32_t iPlayer)
@@ -750,19 +899,15 @@ bool C4Landscape::SetPix(int32_t x, int32_t y, uint8_t npix)
 	if (npix == _GetPix(x, y))
 		return true;
 	// note for relight
-	C4Rect CheckRect(x - 2 * C4LS_MaxLightDistX, y - 2 * C4LS_MaxLightDistY, 4 * C4LS_MaxLightDistX + 1, 4 * C4LS_MaxLightDistY + 1);
-	for (int32_t i = 0; i < C4LS_MaxRelights; i++)
-		if (!Relights[i].Wdt || Relights[i].Overlap(CheckRect) || i + 1 >= C4LS_MaxRelights)
-		{
-			Relights[i].Add(C4Rect(x, y, 1, 1));
-			break;
-		}
+	Relight(C4Rect(x, y, 1, 1));
 	// set pixel
 	return _SetPix(x, y, npix);
 }
 
 bool C4Landscape::SetPixDw(int32_t x, int32_t y, uint32_t dwPix)
 {
+	// a pending relight must not overwrite the pixel later
+	DoRelights();
 	if (!Surface32->LockForUpdate({x, y, x + 1, y + 1}))
 	{
 		return false;
@@ -784,6 +929,8 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 	// get and check pixel
 	uint8_t opix = _GetPix(x, y);
 	if (npix == opix) return true;
+	// path search cells depend on solidity
+	if (DensitySolid(Pix2Dens[npix]) != DensitySolid(Pix2Dens[opix])) Game.PathFinder.InvalidatePoint(x, y);
 	// count pixels
 	if (Pix2Dens[npix])
 	{
@@ -795,7 +942,16 @@ bool C4Landscape::_SetPix(int32_t x, int32_t y, uint8_t npix)
 	}
 
 	// count material
-	if (!npix || MatValid(Pix2Mat[npix]))
+	if (PixChangeDepth && PixChangeRect.Contains(x, y))
+	{
+		// counted for the whole rect in FinishPixChanges
+		if (!fPixChangeMatCntRemoved)
+		{
+			UpdateMatCnt(PixChangeRect, false);
+			fPixChangeMatCntRemoved = true;
+		}
+	}
+	else if (!npix || MatValid(Pix2Mat[npix]))
 	{
 		int32_t omat = Pix2Mat[opix], nmat = Pix2Mat[npix];
 		if (opix) MatCount[omat]--;
@@ -1016,6 +1172,7 @@ void C4Landscape::ShakeFree(int32_t tx, int32_t ty, int32_t rad)
 {
 	int32_t ycnt, xcnt, lwdt, dpy;
 	// Shake free pixels
+	BeginPixChanges(C4Rect(tx - rad, ty - rad, 2 * rad + 1, 2 * rad + 1));
 	for (ycnt = rad - 1; ycnt >= -rad; ycnt--)
 	{
 		lwdt = static_cast<int32_t>(sqrt(double(rad * rad - ycnt * ycnt)));
@@ -1023,16 +1180,19 @@ void C4Landscape::ShakeFree(int32_t tx, int32_t ty, int32_t rad)
 		for (xcnt = -lwdt; xcnt < lwdt + (lwdt == 0); xcnt++)
 			ShakeFreePix(tx + xcnt, dpy);
 	}
+	FinishPixChanges();
 }
 
 void C4Landscape::DigFreeMat(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mat)
 {
 	int32_t cx, cy;
-	if (MatValid(mat))
-		for (cx = tx; cx < tx + wdt; cx++)
-			for (cy = ty; cy < ty + hgt; cy++)
-				if (GetMat(cx, cy) == mat)
-					DigFreePix(cx, cy);
+	if (!MatValid(mat)) return;
+	BeginPixChanges(C4Rect(tx, ty, wdt, hgt));
+	for (cx = tx; cx < tx + wdt; cx++)
+		for (cy = ty; cy < ty + hgt; cy++)
+			if (GetMat(cx, cy) == mat)
+				DigFreePix(cx, cy);
+	FinishPixChanges();
 }
 
 void C4Landscape::BlastFree(int32_t tx, int32_t ty, int32_t rad, int32_t grade, int32_t iByPlayer)
@@ -1053,12 +1213,14 @@ void C4Landscape::BlastFree(int32_t tx, int32_t ty, int32_t rad, int32_t grade,
 	}
 	// blast pixels
 	int32_t iBlastSize = rad * rad * 6283 / 2000; // rad^2 * pi
+	BeginPixChanges(C4Rect(tx - rad, ty - rad, 2 * rad + 1, 2 * rad + 1));
 	for (ycnt = -rad; ycnt <= rad; ycnt++)
 	{
 		lwdt = static_cast<int32_t>(sqrt(double(rad * rad - ycnt * ycnt))); dpy = ty + ycnt;
 		for (xcnt = -lwdt; xcnt < lwdt + (lwdt == 0); xcnt++)
 			BlastFreePix(tx + xcnt, dpy, grade, iBlastSize);
 	}
+	FinishPixChanges();
 
 	// Evaluate material count
 	for (cnt = 0; cnt < Game.Material.Num; cnt++)
@@ -1080,17 +1242,21 @@ void C4Landscape::BlastFree(int32_t tx, int32_t ty, int32_t rad, int32_t grade,
 void C4Landscape::DrawMaterialRect(int32_t mat, int32_t tx, int32_t ty, int32_t wdt, int32_t hgt)
 {
 	int32_t cx, cy;
+	BeginPixChanges(C4Rect(tx, ty, wdt, hgt));
 	for (cy = ty; cy < ty + hgt; cy++)
 		for (cx = tx; cx < tx + wdt; cx++)
 			if ((MatDensity(mat) > GetDensity(cx, cy))
 				|| ((MatDensity(mat) == GetDensity(cx, cy)) && (MatDigFree(mat) <= MatDigFree(GetMat(cx, cy)))))
 				SetPix(cx, cy, Mat2PixColDefault(mat) + GBackIFT(cx, cy));
+	FinishPixChanges();
 }
 
 void C4Landscape::RaiseTerrain(int32_t tx, int32_t ty, int32_t wdt)
 {
 	int32_t cx, cy;
 	uint8_t cpix;
+	// pixels are only raised up to 20 pixels below ty
+	BeginPixChanges(C4Rect(tx, ty, wdt, 20));
 	for (cx = tx; cx < tx + wdt; cx++)
 	{
 		for (cy = ty; (cy + 1 < GBackHgt) && !GBackSolid(cx, cy + 1); cy++);
@@ -1101,6 +1267,7 @@ void C4Landscape::RaiseTerrain(int32_t tx, int32_t ty, int32_t wdt)
 				while (cy >= ty) { SetPix(cx, cy, cpix); cy--; }
 		}
 	}
+	FinishPixChanges();
 }
 
 int32_t C4Landscape::AreaSolidCount(int32_t x, int32_t y, int32_t wdt, int32_t hgt)
@@ -1456,6 +1623,7 @@ bool C4Landscape::Save(C4Group &hGroup)
 
 	SCopy(Config.AtTempPath(C4CFN_TempLandscapePNG), szTempLandscape);
 	MakeTempFilename(szTempLandscape);
+	DoRelights();
 	if (!Surface32->SavePNG(szTempLandscape, true, false, false))
 		return false;
 	if (!hGroup.Move(szTempLandscape, C4CFN_LandscapePNG)) return false;
@@ -1657,6 +1825,11 @@ void C4Landscape::Default()
 	Modulation = 0;
 	fMapChanged = false;
 	ShadeMaterials = true;
+	RelightTiles.clear();
+	RelightTilesX = RelightTilesY = RelightTileCount = 0;
+	PixChangeRect.Default();
+	PixChangeDepth = 0;
+	fPixChangeMatCntRemoved = false;
 }
 
 void C4Landscape::ClearBlastMatCount()
@@ -2127,11 +2300,13 @@ void C4Landscape::ClearRect(int32_t iTx, int32_t iTy, int32_t iWdt, int32_t iHgt
 {
 	C4Rect rt(iTx, iTy, iWdt, iHgt);
 	PrepareChange(rt, false);
+	BeginPixChanges(rt);
 	for (int32_t y = iTy; y < iTy + iHgt; y++)
 	{
 		for (int32_t x = iTx; x < iTx + iWdt; x++) ClearPix(x, y);
 		if (Rnd3()) Rnd3();
 	}
+	FinishPixChanges();
 	FinishChange(rt, false);
 }
 
@@ -2147,6 +2322,7 @@ void C4Landscape::ClearRectDensity(int32_t iTx, int32_t iTy, int32_t iWdt, int32
 	default: break; // min=max as given
 	}
 
+	BeginPixChanges(C4Rect(iTx, iTy, iWdt, iHgt));
 	for (int32_t y = iTy; y < iTy + iHgt; y++)
 	{
 		for (int32_t x = iTx; x < iTx + iWdt; x++)
@@ -2156,6 +2332,7 @@ void C4Landscape::ClearRectDensity(int32_t iTx, int32_t iTy, int32_t iWdt, int32
 		}
 		if (Rnd3()) Rnd3();
 	}
+	FinishPixChanges();
 }
 
 bool C4Landscape::SaveMap(C4Group &hGroup)
@@ -2435,7 +2612,7 @@ uint8_t C4Landscape::GetMapIndex(int32_t iX, int32_t iY)
 
 bool C4Landscape::DoRelights()
 {
-	if (!Relights[0].Wdt) return true;
+	if (!RelightTileCount) return true;
 
 	if (!Surface32->Lock()) return false;
 	if (AnimationSurface)
@@ -2443,25 +2620,50 @@ bool C4Landscape::DoRelights()
 		AnimationSurface->Lock();
 	}
 
-	for (int32_t i = 0; i < C4LS_MaxRelights; i++)
+	// merge the areas of neighbouring tiles: runs of tiles in a row whose areas cover the same lines,
+	// and runs that continue a rect of the row above with the same columns
+	std::vector<C4Rect> Rects;
+	for (int32_t ty = 0; ty < RelightTilesY; ++ty)
+		for (int32_t tx = 0; tx < RelightTilesX; ++tx)
+		{
+			C4Rect &rTile = RelightTiles[ty * RelightTilesX + tx];
+			if (!rTile.Wdt) continue;
+			C4Rect Rect = rTile;
+			rTile.Default();
+			for (; tx + 1 < RelightTilesX; ++tx)
+			{
+				C4Rect &rNext = RelightTiles[ty * RelightTilesX + tx + 1];
+				if (!rNext.Wdt || rNext.x != Rect.x + Rect.Wdt || rNext.y != Rect.y || rNext.Hgt != Rect.Hgt) break;
+				Rect.Wdt += rNext.Wdt;
+				rNext.Default();
+			}
+			const auto Above = std::find_if(Rects.begin(), Rects.end(), [&Rect](const C4Rect &rAbove)
+			{
+				return rAbove.x == Rect.x && rAbove.Wdt == Rect.Wdt && rAbove.y + rAbove.Hgt == Rect.y;
+			});
+			if (Above != Rects.end())
+				Above->Hgt += Rect.Hgt;
+			else
+				Rects.push_back(Rect);
+		}
+	RelightTileCount = 0;
+
+	for (const C4Rect &rRect : Rects)
 	{
-		if (!Relights[i].Wdt)
-			break;
-		C4Rect SolidMaskRect = Relights[i];
-		SolidMaskRect.x -= 2 * C4LS_MaxLightDistX; SolidMaskRect.y -= 2 * C4LS_MaxLightDistY;
-		SolidMaskRect.Wdt += 4 * C4LS_MaxLightDistX; SolidMaskRect.Hgt += 4 * C4LS_MaxLightDistY;
+		C4Rect SolidMaskRect = rRect;
+		SolidMaskRect.x -= C4LS_MaxLightDistX; SolidMaskRect.y -= C4LS_MaxLightDistY;
+		SolidMaskRect.Wdt += 2 * C4LS_MaxLightDistX; SolidMaskRect.Hgt += 2 * C4LS_MaxLightDistY;
 		C4SolidMask *pSolid;
 		for (pSolid = C4SolidMask::Last; pSolid; pSolid = pSolid->Prev)
 		{
 			pSolid->RemoveTemporary(SolidMaskRect);
 		}
-		Relight(Relights[i]);
+		ApplyLighting(rRect);
 		// Restore Solidmasks
 		for (pSolid = C4SolidMask::First; pSolid; pSolid = pSolid->Next)
 		{
 			pSolid->PutTemporary(SolidMaskRect);
 		}
-		Relights[i].Default();
 		C4SolidMask::CheckConsistency();
 	}
 
@@ -2476,8 +2678,26 @@ bool C4Landscape::Relight(C4Rect To)
 	// Enlarge to relight pixels surrounding a changed one
 	To.x -= C4LS_MaxLightDistX; To.y -= C4LS_MaxLightDistY;
 	To.Wdt += 2 * C4LS_MaxLightDistX; To.Hgt += 2 * C4LS_MaxLightDistY;
-	// Apply lighting
-	return ApplyLighting(To);
+	// clip to landscape size
+	To.Intersect(C4Rect(0, 0, Width, Height));
+	if (To.Wdt <= 0 || To.Hgt <= 0) return true;
+	if (RelightTiles.empty())
+	{
+		RelightTilesX = (Width + C4LS_RelightTileSize - 1) / C4LS_RelightTileSize;
+		RelightTilesY = (Height + C4LS_RelightTileSize - 1) / C4LS_RelightTileSize;
+		RelightTiles.resize(RelightTilesX * RelightTilesY);
+	}
+	// note the part in each tile; the lighting is applied in DoRelights
+	for (int32_t ty = To.y / C4LS_RelightTileSize; ty <= (To.y + To.Hgt - 1) / C4LS_RelightTileSize; ++ty)
+		for (int32_t tx = To.x / C4LS_RelightTileSize; tx <= (To.x + To.Wdt - 1) / C4LS_RelightTileSize; ++tx)
+		{
+			C4Rect Part(tx * C4LS_RelightTileSize, ty * C4LS_RelightTileSize, C4LS_RelightTileSize, C4LS_RelightTileSize);
+			Part.Intersect(To);
+			C4Rect &rTile = RelightTiles[ty * RelightTilesX + tx];
+			if (!rTile.Wdt) ++RelightTileCount;
+			rTile.Add(Part);
+		}
+	return true;
 }
 
 bool C4Landscape::ApplyLighting(C4Rect To)
@@ -2495,26 +2715,67 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 		AnimationSurface->LockForUpdate(toRect);
 		AnimationSurface->ClearBoxDw(To.x, To.y, To.Wdt, To.Hgt);
 	}
+
+	// material placement of the area plus the 9 lines above, the 8 lines below and one column on each side,
+	// so the shading loops below do not need any bounds checks
+	const int32_t iPitch = To.Wdt + 2;
+	std::vector<int32_t> Placement, AboveDensity, BelowDensity;
+	if (ShadeMaterials)
+	{
+		Placement.resize(iPitch * (To.Hgt + 17));
+		for (int32_t iLine = 0; iLine < To.Hgt + 17; ++iLine)
+		{
+			const int32_t iY = To.y - 9 + iLine;
+			int32_t *const pPlacement = &Placement[iLine * iPitch];
+			if (iY < 0 || iY >= Height)
+			{
+				for (int32_t i = 0; i < iPitch; ++i)
+					pPlacement[i] = GetPlacement(To.x - 1 + i, iY);
+				continue;
+			}
+			pPlacement[0] = GetPlacement(To.x - 1, iY);
+			for (int32_t i = 0; i < To.Wdt; ++i)
+				pPlacement[i + 1] = Pix2Place[_GetPix(To.x + i, iY)];
+			pPlacement[To.Wdt + 1] = GetPlacement(To.x + To.Wdt, iY);
+		}
+		// sums of the 8 lines above and below the first line of the area, per column
+		AboveDensity.assign(To.Wdt, 0);
+		BelowDensity.assign(To.Wdt, 0);
+		for (int32_t iLine = 1; iLine <= 8; ++iLine)
+		{
+			const int32_t *const pAbove = &Placement[iLine * iPitch + 1], *const pBelow = &Placement[(iLine + 9) * iPitch + 1];
+			for (int32_t i = 0; i < To.Wdt; ++i)
+			{
+				AboveDensity[i] += pAbove[i];
+				BelowDensity[i] += pBelow[i];
+			}
+		}
+	}
+
 	// do lightning
-	for (int32_t iX = To.x; iX < To.x + To.Wdt; ++iX)
+	for (int32_t iLine = 0; iLine < To.Hgt; ++iLine)
 	{
-		int AboveDensity = 0, BelowDensity = 0;
+		const int32_t iY = To.y + iLine;
+		const int32_t *pPlacement = nullptr;
 		if (ShadeMaterials)
 		{
-			for (int i = 1; i <= 8; ++i)
+			// slide the sums down to this line; plain loops over all columns, so the compiler can vectorize them
+			if (iLine)
 			{
-				AboveDensity += GetPlacement(iX, To.y - i - 1);
-				BelowDensity += GetPlacement(iX, To.y + i - 1);
+				const int32_t *const pAboveIn = &Placement[(iLine + 8) * iPitch + 1], *const pAboveOut = &Placement[iLine * iPitch + 1];
+				const int32_t *const pBelowIn = &Placement[(iLine + 17) * iPitch + 1], *const pBelowOut = &Placement[(iLine + 9) * iPitch + 1];
+				for (int32_t i = 0; i < To.Wdt; ++i)
+				{
+					AboveDensity[i] += pAboveIn[i] - pAboveOut[i];
+					BelowDensity[i] += pBelowIn[i] - pBelowOut[i];
+				}
 			}
+			pPlacement = &Placement[(iLine + 9) * iPitch + 1];
 		}
 
-		for (int32_t iY = To.y; iY < To.y + To.Hgt; ++iY)
+		for (int32_t i = 0; i < To.Wdt; ++i)
 		{
-			// do not move that code into the if (ShadeMaterials) block, as it needs to be run for sky pixels as well
-			AboveDensity -= GetPlacement(iX, iY - 9);
-			AboveDensity += GetPlacement(iX, iY - 1);
-			BelowDensity -= GetPlacement(iX, iY);
-			BelowDensity += GetPlacement(iX, iY + 8);
+			const int32_t iX = To.x + i;
 
 			// Normal color
 			uint32_t dwBackClr = GetClrByTex(iX, iY);
@@ -2533,10 +2794,10 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 				int iOwnDens = Pix2Place[pix];
 				if (!iOwnDens) continue;
 				iOwnDens *= 2;
-				iOwnDens += GetPlacement(iX + 1, iY) + GetPlacement(iX - 1, iY);
+				iOwnDens += pPlacement[i + 1] + pPlacement[i - 1];
 				iOwnDens /= 4;
 				// get density of surrounding materials
-				int iCompareDens = AboveDensity / 8;
+				int iCompareDens = AboveDensity[i] / 8;
 				if (iOwnDens > iCompareDens)
 				{
 					// apply light
@@ -2546,7 +2807,7 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 				{
 					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iCompareDens - iOwnDens)));
 				}
-				iCompareDens = BelowDensity / 8;
+				iCompareDens = BelowDensity[i] / 8;
 				if (iOwnDens > iCompareDens)
 				{
 					DarkenClrBy(dwBackClr, (std::min)(30, 2 * (iOwnDens - iCompareDens)));
@@ -2563,6 +2824,36 @@ bool C4Landscape::ApplyLighting(C4Rect To)
 	return true;
 }
 
+bool C4Landscape::RelightBenchmark(int32_t iCount)
+{
+	if (!Surface32) return false;
+	// crater sized areas at random positions; the landscape itself is not changed
+	std::vector<C4Rect> Craters;
+	for (int32_t i = 0; i < iCount; ++i)
+	{
+		const int32_t iRadius = 10 + SafeRandom(30);
+		Craters.emplace_back(SafeRandom(Width) - iRadius, SafeRandom(Height) - iRadius, 2 * iRadius, 2 * iRadius);
+	}
+	DoRelights();
+	const auto Run = [this, &Craters](const char *szName, bool fBatched)
+	{
+		int32_t iTiles = 0;
+		const auto Start = std::chrono::steady_clock::now();
+		for (const C4Rect &rCrater : Craters)
+		{
+			Relight(rCrater);
+			iTiles = std::max(iTiles, RelightTileCount);
+			if (!fBatched) DoRelights();
+		}
+		DoRelights();
+		const double dTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+		LogF("Benchmark: %-10s %d craters, %d tiles, %.1f ms", szName, static_cast<int32_t>(Craters.size()), iTiles, dTime);
+	};
+	Run("One by one", false);
+	Run("Batched", true);
+	return true;
+}
+
 uint32_t C4Landscape::GetClrByTex(int32_t iX, int32_t iY)
 {
 	// Get pixel and default color
@@ -2813,9 +3104,30 @@ void C4Landscape::FinishChange(C4Rect BoundingBox, const bool updateMatAndPixCnt
 		pSolid->Repair(SolidMaskRect);
 	}
 	if (updateMatAndPixCnt) UpdatePixCnt(BoundingBox);
+	Game.PathFinder.InvalidateRect(BoundingBox);
 	C4SolidMask::CheckConsistency();
 }
 
+void C4Landscape::BeginPixChanges(C4Rect BoundingBox)
+{
+	// nested changes are counted per pixel if they leave the outer rect
+	if (PixChangeDepth++) return;
+	BoundingBox.Intersect(C4Rect(0, 0, Width, Height));
+	if (BoundingBox.Wdt <= 0 || BoundingBox.Hgt <= 0) BoundingBox.Default();
+	PixChangeRect = BoundingBox;
+	// the counts are only taken out when the first pixel changes, so unchanged areas cost nothing
+	fPixChangeMatCntRemoved = false;
+}
+
+void C4Landscape::FinishPixChanges()
+{
+	assert(PixChangeDepth > 0);
+	if (--PixChangeDepth) return;
+	if (fPixChangeMatCntRemoved) UpdateMatCnt(PixChangeRect, true);
+	PixChangeRect.Default();
+	fPixChangeMatCntRemoved = false;
+}
+
 void C4Landscape::UpdatePixCnt(const C4Rect &Rect, bool fCheck)
 {
 	int32_t PixCntWidth = (Width + 16) / 17;
@@ -23,6 +23,9 @@
 
 #include <StdSurface8.h>
 
+#include <memory>
+#include <vector>
+
 const uint8_t GBM        = 128,
               GBM_ColNum = 64,
               IFT        = 0x80,
@@ -37,10 +40,11 @@ const int32_t C4LSC_Undefined = 0,
               C4LSC_Static = 2,
               C4LSC_Exact = 3;
 
-const int32_t C4LS_MaxRelights = 50;
+const int32_t C4LS_RelightTileSize = 64; // side length of the landscape tiles that collect relight areas
 
 class C4MapCreatorS2;
 class C4Object;
+class C4LandscapeScanWorkers;
 
 class C4Landscape
 {
@@ -71,12 +75,17 @@ public:
 
 protected:
 	C4Surface *Surface32;
+	std::unique_ptr<C4LandscapeScanWorkers> ScanWorkers; // kept across frames; created on first parallel scan
 	C4Surface *AnimationSurface;
 	CSurface8 *Surface8;
 	int32_t Pix2Mat[256], Pix2Dens[256], Pix2Place[256];
 	int32_t PixCntPitch;
 	uint8_t *PixCnt;
-	C4Rect Relights[C4LS_MaxRelights];
+	std::vector<C4Rect> RelightTiles; // area to relight in each tile; empty if the tile is up to date
+	int32_t RelightTilesX, RelightTilesY, RelightTileCount; // grid size and number of tiles with a pending relight
+	C4Rect PixChangeRect; // material of pixels changed in here is counted for the whole rect in FinishPixChanges
+	int32_t PixChangeDepth; // nesting of BeginPixChanges
+	bool fPixChangeMatCntRemoved; // whether PixChangeRect has been taken out of the material counts yet
 
 public:
 	void Default();
@@ -207,10 +216,13 @@ public:
 	void HandleTexMapUpdate();
 	void UpdatePixMaps();
 	bool DoRelights();
+	bool RelightBenchmark(int32_t iCount); // relight random craters one by one and batched and log the timings
 	void RemoveUnusedTexMapEntries();
 
 protected:
 	void ExecuteScan();
+	void ScanColumn(int32_t x);
+	bool IsScanNeeded(int32_t x, const uint8_t *convDown, const uint8_t *convUp); // whether ScanColumn(x) would convert anything (thread-safe)
 	int32_t DoScan(int32_t x, int32_t y, int32_t mat, int32_t dir);
 	int32_t ChunkyRandom(int32_t &iOffset, int32_t iRange); // return static random value, according to offset and MapSeed
 	void DrawChunk(int32_t tx, int32_t ty, int32_t wdt, int32_t hgt, int32_t mcol, int32_t iChunkType, int32_t cro);
@@ -224,7 +236,7 @@ protected:
 	bool SkyToLandscape(int32_t iToX, int32_t iToY, int32_t iToWdt, int32_t iToHgt, int32_t iOffX, int32_t iOffY);
 	CSurface8 *CreateMap(); // create map by landscape attributes
 	CSurface8 *CreateMapS2(C4Group &ScenFile); // create map by def file
-	bool Relight(C4Rect To);
+	bool Relight(C4Rect To); // note area around To for the next DoRelights
 	bool ApplyLighting(C4Rect To);
 	uint32_t GetClrByTex(int32_t iX, int32_t iY);
 	bool Mat2Pal(); // assign material colors to landscape palette
@@ -239,6 +251,10 @@ protected:
 	void UpdateMatCnt(C4Rect Rect, bool fPlus);
 	void PrepareChange(C4Rect BoundingBox, bool updateMatCnt = true);
 	void FinishChange(C4Rect BoundingBox, bool updateMatAndPixCnt = true);
+	// bulk SetPix: material counts of the pixels in BoundingBox are updated once at the end instead of per pixel,
+	// so MatCount and EffectiveMatCount are not up to date in between
+	void BeginPixChanges(C4Rect BoundingBox);
+	void FinishPixChanges();
 	static bool DrawLineLandscape(int32_t iX, int32_t iY, int32_t iGrade);
 
 public:
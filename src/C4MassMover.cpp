@@ -22,8 +22,11 @@
 #include <C4Random.h>
 #include <C4Material.h>
 #include <C4Game.h>
+#include <C4Stat.h>
 #include <C4Wrappers.h>
 
+#include <cstring>
+
 // Note: creation optimized using advancing CreatePtr, so sequential
 // creation does not keep rescanning the complete set for a free
 // slot. (This had caused extreme delays.) This had the effect that
@@ -34,6 +37,13 @@
 // a mathematical triangular shape with no delays! Since masses are
 // running slower and smoother, overall MM counts are much lower,
 // hardly ever exceeding 1000. October 1997
+// The set now grows in blocks when full; free and used slots are tracked
+// in a bitmap, so execution and creation skip unused slots quickly while
+// keeping the slot order described above.
+
+C4ST_NEW(MassMoverLiveStat,    "C4MassMoverSet live movers")
+C4ST_NEW(MassMoverCreatedStat, "C4MassMoverSet created movers")
+C4ST_NEW(MassMoverCeasedStat,  "C4MassMoverSet ceased movers")
 
 C4MassMoverSet::C4MassMoverSet()
 {
@@ -45,47 +55,127 @@ C4MassMoverSet::~C4MassMoverSet()
 	Clear();
 }
 
-void C4MassMoverSet::Clear() {}
+void C4MassMoverSet::Clear()
+{
+	Set.clear();
+	Used.clear();
+	UsedEnd = 0;
+	Count = 0;
+}
 
 void C4MassMoverSet::Execute()
 {
-	C4MassMover *cmm;
-	// Init counts
-	Count = 0;
-	// Execute & count
+	// Execute from top to bottom (see above)
+	// Movers created meanwhile below the current slot are executed in the same pass.
 	for (int32_t speed = 2; speed > 0; speed--)
+		for (int32_t iSlot = FindUsedBelow(UsedEnd); iSlot >= 0; iSlot = FindUsedBelow(iSlot))
+			ExecuteMover(iSlot);
+	// Statistics
+	C4ST_ADD(MassMoverLiveStat,    Count)
+	C4ST_ADD(MassMoverCreatedStat, CreatedCount)
+	C4ST_ADD(MassMoverCeasedStat,  CeasedCount)
+	CreatedCount = CeasedCount = 0;
+}
+
+void C4MassMoverSet::ExecuteMover(int32_t iSlot)
+{
+	At(iSlot).Execute();
+	if (At(iSlot).Mat == MNone)
 	{
-		cmm = &(Set[C4MassMoverChunk - 1]);
-		for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++, cmm--)
-			if (cmm->Mat != MNone)
-			{
-				Count++; cmm->Execute();
-			}
+		SetUnused(iSlot);
+		--Count;
+		++CeasedCount;
 	}
 }
 
 bool C4MassMoverSet::Create(int32_t x, int32_t y, bool fExecute)
 {
-	if (Count == C4MassMoverChunk) return false;
+	if (Count >= GetCapacity() && !Grow()) return false;
 #ifdef DEBUGREC
 	C4RCMassMover rc;
 	rc.x = x; rc.y = y;
 	AddDbgRec(RCT_MMC, &rc, sizeof(rc));
 #endif
-	int32_t cptr = CreatePtr;
-	do
+	// next free slot after CreatePtr, wrapping around
+	int32_t cptr = FindUnused(CreatePtr + 1);
+	if (cptr < 0) cptr = FindUnused(0);
+	if (cptr < 0) return false;
+	if (!At(cptr).Init(x, y))
 	{
-		cptr++;
-		if (cptr >= C4MassMoverChunk) cptr = 0;
-		if (Set[cptr].Mat == MNone)
+		At(cptr).Mat = MNone;
+		return false;
+	}
+	SetUsed(cptr);
+	++Count;
+	++CreatedCount;
+	CreatePtr = cptr;
+	if (fExecute) ExecuteMover(cptr);
+	return true;
+}
+
+bool C4MassMoverSet::Grow()
+{
+	if (Set.size() >= static_cast<size_t>(C4MassMoverMaxChunks)) return false;
+	auto pBlock = std::make_unique<C4MassMover[]>(C4MassMoverChunk);
+	for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++) pBlock[cnt].Mat = MNone;
+	Set.push_back(std::move(pBlock));
+	Used.resize((GetCapacity() + 63) / 64, 0);
+	return true;
+}
+
+void C4MassMoverSet::SetUsed(int32_t iSlot)
+{
+	Used[iSlot / 64] |= uint64_t{1} << (iSlot % 64);
+	UsedEnd = std::max(UsedEnd, iSlot + 1);
+}
+
+void C4MassMoverSet::SetUnused(int32_t iSlot)
+{
+	Used[iSlot / 64] &= ~(uint64_t{1} << (iSlot % 64));
+	// shrink active range
+	if (iSlot + 1 == UsedEnd)
+		UsedEnd = FindUsedBelow(iSlot) + 1;
+}
+
+int32_t C4MassMoverSet::FindUsedBelow(int32_t iSlot) const
+{
+	if (iSlot <= 0) return -1;
+	int32_t iWord = (iSlot - 1) / 64;
+	// mask out bits at or above iSlot in the first word
+	uint64_t dwBits = Used[iWord] & (~uint64_t{0} >> (63 - (iSlot - 1) % 64));
+	for (;;)
+	{
+		if (dwBits)
 		{
-			if (!Set[cptr].Init(x, y)) return false;
-			CreatePtr = cptr;
-			if (fExecute) Set[cptr].Execute();
-			return true;
+			int32_t iBit = 63;
+			while (!((dwBits >> iBit) & 1)) --iBit;
+			return iWord * 64 + iBit;
 		}
-	} while (cptr != CreatePtr);
-	return false;
+		if (--iWord < 0) return -1;
+		dwBits = Used[iWord];
+	}
+}
+
+int32_t C4MassMoverSet::FindUnused(int32_t iFrom) const
+{
+	const int32_t iCapacity = GetCapacity();
+	if (iFrom >= iCapacity) return -1;
+	int32_t iWord = iFrom / 64;
+	// mask out bits below iFrom in the first word
+	uint64_t dwFree = ~Used[iWord] & (~uint64_t{0} << (iFrom % 64));
+	const int32_t iWords = static_cast<int32_t>(Used.size());
+	for (;;)
+	{
+		if (dwFree)
+		{
+			int32_t iBit = 0;
+			while (!((dwFree >> iBit) & 1)) ++iBit;
+			const int32_t iSlot = iWord * 64 + iBit;
+			return iSlot < iCapacity ? iSlot : -1;
+		}
+		if (++iWord >= iWords) return -1;
+		dwFree = ~Used[iWord];
+	}
 }
 
 bool C4MassMover::Init(int32_t tx, int32_t ty)
@@ -96,7 +186,6 @@ bool C4MassMover::Init(int32_t tx, int32_t ty)
 	// Check mat
 	Mat = GBackMat(tx, ty);
 	x = tx; y = ty;
-	Game.MassMover.Count++;
 	return (Mat != MNone);
 }
 
@@ -107,7 +196,6 @@ void C4MassMover::Cease()
 	rc.x = x; rc.y = y;
 	AddDbgRec(RCT_MMD, &rc, sizeof(rc));
 #endif
-	Game.MassMover.Count--;
 	Mat = MNone;
 }
 
@@ -172,30 +260,28 @@ bool C4MassMover::Corrosion(int32_t dx, int32_t dy)
 
 void C4MassMoverSet::Default()
 {
-	int32_t cnt;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt].Mat = MNone;
-	Count = 0;
+	Clear();
 	CreatePtr = 0;
+	CreatedCount = CeasedCount = 0;
+	Grow();
 }
 
 bool C4MassMoverSet::Save(C4Group &hGroup)
 {
-	int32_t cnt;
 	// Consolidate
 	Consolidate();
-	// Recount
-	Count = 0;
-	for (cnt = 0; cnt < C4MassMoverChunk; cnt++)
-		if (Set[cnt].Mat != MNone)
-			Count++;
 	// All empty: delete component
 	if (!Count)
 	{
 		hGroup.Delete(C4CFN_MassMover);
 		return true;
 	}
-	// Save set
-	if (!hGroup.Add(C4CFN_MassMover, Set, Count * sizeof(C4MassMover)))
+	// Save set (all used slots are at the start now)
+	const size_t iMoverSize = sizeof(C4MassMover);
+	char *pData = new char[Count * iMoverSize];
+	for (int32_t cnt = 0; cnt < Count; cnt++)
+		std::memcpy(pData + cnt * iMoverSize, &At(cnt), iMoverSize);
+	if (!hGroup.Add(C4CFN_MassMover, pData, Count * iMoverSize, false, true))
 		return false;
 	// Success
 	return true;
@@ -211,37 +297,37 @@ bool C4MassMoverSet::Load(C4Group &hGroup)
 	if ((iBinSize % iMoverSize) != 0) return false;
 
 	// load new
-	Count = iBinSize / iMoverSize;
-	if (!hGroup.Read(Set, iBinSize)) return false;
+	const int32_t iNum = static_cast<int32_t>(iBinSize / iMoverSize);
+	while (GetCapacity() < iNum)
+		if (!Grow()) return false;
+	for (int32_t cnt = 0; cnt < iNum; cnt++)
+	{
+		if (!hGroup.Read(&At(cnt), iMoverSize)) return false;
+		if (At(cnt).Mat != MNone)
+		{
+			SetUsed(cnt);
+			++Count;
+		}
+	}
 	return true;
 }
 
 void C4MassMoverSet::Consolidate()
 {
-	// Consolidate set
-	int32_t iSpot, iPtr, iConsolidated;
-	for (iSpot = -1, iPtr = 0, iConsolidated = 0; iPtr < C4MassMoverChunk; iPtr++)
-	{
-		// Empty: set new spot if needed
-		if (Set[iPtr].Mat == MNone)
+	// Consolidate set: move all used slots down, keeping their order
+	int32_t iSpot = 0;
+	for (int32_t iPtr = 0; iPtr < UsedEnd; iPtr++)
+		if (IsUsed(iPtr))
 		{
-			if (iSpot == -1) iSpot = iPtr;
-		}
-		// Full: move down to empty spot if possible
-		else if (iSpot != -1)
-		{
-			// Move to spot
-			Set[iSpot] = Set[iPtr];
-			Set[iPtr].Mat = MNone;
-			iConsolidated++;
-			// Advance empty spot (as far as ptr)
-			for (; iSpot < iPtr; iSpot++)
-				if (Set[iSpot].Mat == MNone)
-					break;
-			// No empty spot below ptr
-			if (iSpot == iPtr) iSpot = -1;
+			if (iSpot != iPtr)
+			{
+				At(iSpot) = At(iPtr);
+				At(iPtr).Mat = MNone;
+				SetUnused(iPtr);
+				SetUsed(iSpot);
+			}
+			iSpot++;
 		}
-	}
 	// Reset create ptr
 	CreatePtr = 0;
 }
@@ -254,7 +340,15 @@ void C4MassMoverSet::Synchronize()
 void C4MassMoverSet::Copy(C4MassMoverSet &rSet)
 {
 	Clear();
+	while (GetCapacity() < rSet.GetCapacity()) Grow();
+	for (int32_t cnt = 0; cnt < rSet.UsedEnd; cnt++)
+		if (rSet.IsUsed(cnt))
+		{
+			At(cnt) = rSet.At(cnt);
+			SetUsed(cnt);
+		}
 	Count = rSet.Count;
 	CreatePtr = rSet.CreatePtr;
-	for (int32_t cnt = 0; cnt < C4MassMoverChunk; cnt++) Set[cnt] = rSet.Set[cnt];
+	CreatedCount = rSet.CreatedCount;
+	CeasedCount = rSet.CeasedCount;
 }
@@ -18,7 +18,11 @@
 
 #pragma once
 
-const int32_t C4MassMoverChunk = 10000;
+#include <memory>
+#include <vector>
+
+const int32_t C4MassMoverChunk = 10000, // movers per allocation block
+              C4MassMoverMaxChunks = 100;
 
 class C4MassMoverSet;
 
@@ -43,11 +47,16 @@ public:
 	~C4MassMoverSet();
 
 public:
-	int32_t Count;
+	int32_t Count; // live movers
 	int32_t CreatePtr;
+	int32_t CreatedCount, CeasedCount; // movers created and ceased since the last Execute
 
 protected:
-	C4MassMover Set[C4MassMoverChunk];
+	// Movers are allocated in blocks that never move, because a mover may cause others
+	// to be created (and thus the set to grow) while it is being executed.
+	std::vector<std::unique_ptr<C4MassMover[]>> Set;
+	std::vector<uint64_t> Used; // one bit per slot
+	int32_t UsedEnd; // no slot at or above this index is used
 
 public:
 	void Copy(C4MassMoverSet &rSet);
@@ -61,4 +70,13 @@ public:
 
 protected:
 	void Consolidate();
+	bool Grow();
+	void ExecuteMover(int32_t iSlot);
+	int32_t GetCapacity() const { return static_cast<int32_t>(Set.size()) * C4MassMoverChunk; }
+	C4MassMover &At(int32_t iSlot) { return Set[iSlot / C4MassMoverChunk][iSlot % C4MassMoverChunk]; }
+	bool IsUsed(int32_t iSlot) const { return (Used[iSlot / 64] >> (iSlot % 64)) & 1; }
+	void SetUsed(int32_t iSlot);
+	void SetUnused(int32_t iSlot);
+	int32_t FindUsedBelow(int32_t iSlot) const; // highest used slot below iSlot, or -1
+	int32_t FindUnused(int32_t iFrom) const; // lowest free slot from iFrom on, or -1
 };
@@ -23,6 +23,7 @@
 #include <C4Game.h>
 #include <C4Object.h>
 #include <C4Script.h>
+#include <C4ValueHash.h>
 #include <C4Gui.h>
 #include <C4Console.h>
 #include <C4Application.h>
@@ -451,6 +452,9 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 		LogF("/fast [x] - %s", LoadResStr("IDS_TEXT_SETTOFASTMODESKIPPINGXFRA"));
 		LogF("/slow - %s", LoadResStr("IDS_TEXT_SETTONORMALSPEEDMODE"));
 		LogF("/chart - %s", LoadResStr("IDS_TEXT_DISPLAYNETWORKSTATISTICS"));
+		LogF("/profile [start/stop/save] - %s", LoadResStr("IDS_TEXT_RECORDFRAMETIMELINE"));
+		LogF("/callbacks [reset] - %s", LoadResStr("IDS_TEXT_SHOWCALLBACKSTATISTICS"));
+		LogF("/bench [particles/paths/arrays/maps/strings/script/relight/pxs] [count] - %s", LoadResStr("IDS_TEXT_RUNANENGINEBENCHMARK"));
 		LogF("/nodebug - %s", LoadResStr("IDS_TEXT_PREVENTDEBUGMODEINTHISROU"));
 		LogF("/set comment [comment] - %s", LoadResStr("IDS_TEXT_SETANEWNETWORKCOMMENT"));
 		LogF("/set password [password] - %s", LoadResStr("IDS_TEXT_SETANEWNETWORKPASSWORD"));
@@ -696,6 +700,86 @@ bool C4MessageInput::ProcessCommand(const char *szCommand)
 	if (Game.IsRunning) if (SEqual(szCmdName, "chart"))
 		return Game.ToggleChart();
 
+	// frame profiler
+	if (SEqual(szCmdName, "profile"))
+	{
+		if (SEqual(pCmdPar, "start"))
+		{
+			Game.FrameProfiler.Start();
+			Log(LoadResStr("IDS_MSG_CMD_PROFILE_STARTED"));
+			return true;
+		}
+		if (SEqual(pCmdPar, "stop"))
+		{
+			Game.FrameProfiler.Stop();
+			Log(LoadResStr("IDS_MSG_CMD_PROFILE_STOPPED"));
+			return true;
+		}
+		if (SEqual2(pCmdPar, "save") && (!pCmdPar[4] || pCmdPar[4] == ' '))
+		{
+			const char *szFilename = pCmdPar[4] && pCmdPar[5] ? pCmdPar + 5 : Config.AtExePath("FrameProfile.json");
+			if (!Game.FrameProfiler.ExportChromeTrace(szFilename))
+			{
+				LogF(LoadResStr("IDS_MSG_CMD_PROFILE_SAVEFAILED"), szFilename);
+				return false;
+			}
+			LogF(LoadResStr("IDS_MSG_CMD_PROFILE_SAVED"), szFilename);
+			return true;
+		}
+		Log(LoadResStr("IDS_MSG_CMD_PROFILE_USAGE"));
+		return false;
+	}
+
+	// engine benchmarks; they stall the game for a while, so only in debug mode
+	if (SEqual(szCmdName, "bench"))
+	{
+		if (!Game.IsRunning || !Game.DebugMode) return false;
+		// benchmark name, optionally followed by a count
+		const char *szCount = std::strchr(pCmdPar, ' ');
+		StdStrBuf Name; Name.Copy(pCmdPar, szCount ? szCount - pCmdPar : SLen(pCmdPar));
+		const int32_t iCount = szCount ? atoi(szCount + 1) : 0;
+		if (SEqual(Name.getData(), "particles"))
+			return Game.Particles.Benchmark(iCount ? BoundBy<int32_t>(iCount, 1, 1000000) : 100000, 100);
+		if (SEqual(Name.getData(), "paths"))
+			return Game.PathFinder.Benchmark(iCount ? BoundBy<int32_t>(iCount, 1, 10000) : 100);
+		if (SEqual(Name.getData(), "arrays"))
+		{
+			C4ValueArray::Benchmark();
+			return true;
+		}
+		if (SEqual(Name.getData(), "maps"))
+		{
+			C4ValueHash::Benchmark();
+			return true;
+		}
+		if (SEqual(Name.getData(), "strings"))
+		{
+			C4StringTable::Benchmark();
+			return true;
+		}
+		if (SEqual(Name.getData(), "script"))
+		{
+			Game.ScriptEngine.Benchmark();
+			return true;
+		}
+		if (SEqual(Name.getData(), "relight"))
+			return Game.Landscape.RelightBenchmark(iCount ? BoundBy<int32_t>(iCount, 1, 10000) : 500);
+		if (SEqual(Name.getData(), "pxs"))
+			return C4PXSSystem::Benchmark(iCount ? BoundBy<int32_t>(iCount, 1, 100) : 10);
+		Log("Syntax: /bench particles/paths/arrays/maps/strings/script/relight/pxs [count]");
+		return false;
+	}
+
+	// engine callback statistics
+	if (SEqual(szCmdName, "callbacks"))
+	{
+		if (SEqual(pCmdPar, "reset"))
+			C4DefScriptHost::ResetCallbackStats();
+		else
+			C4DefScriptHost::LogCallbackStats();
+		return true;
+	}
+
 	// custom command
 	if (Game.IsRunning && GetCommand(szCmdName))
 	{
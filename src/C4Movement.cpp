@@ -113,6 +113,14 @@ bool C4Object::Contact(int32_t iCNAT)
 {
 	if (Def->ContactFunctionCalls)
 	{
+		switch (iCNAT)
+		{
+		case CNAT_Left:   return static_cast<bool>(Call(OCB_ContactLeft));
+		case CNAT_Right:  return static_cast<bool>(Call(OCB_ContactRight));
+		case CNAT_Top:    return static_cast<bool>(Call(OCB_ContactTop));
+		case CNAT_Bottom: return static_cast<bool>(Call(OCB_ContactBottom));
+		case CNAT_Center: return static_cast<bool>(Call(OCB_ContactCenter));
+		}
 		return static_cast<bool>(Call(FormatString(PSF_Contact, CNATName(iCNAT)).getData()));
 	}
 	return false;
@@ -474,9 +482,9 @@ void C4Object::DoMovement()
 	if (fAnyContact)
 	{
 		C4AulParSet pars(C4VInt(fixtoi(oldxdir, 100)), C4VInt(fixtoi(oldydir, 100)));
-		if (old_ocf & OCF_HitSpeed1) Call(PSF_Hit,  pars);
-		if (old_ocf & OCF_HitSpeed2) Call(PSF_Hit2, pars);
-		if (old_ocf & OCF_HitSpeed3) Call(PSF_Hit3, pars);
+		if (old_ocf & OCF_HitSpeed1) Call(OCB_Hit,  pars);
+		if (old_ocf & OCF_HitSpeed2) Call(OCB_Hit2, pars);
+		if (old_ocf & OCF_HitSpeed3) Call(OCB_Hit3, pars);
 	}
 
 	// Rotation gfx
@@ -0,0 +1,396 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* A* path search on a grid of landscape cells, alternative to the ray crawling C4PathFinder */
+
+#include <C4Include.h>
+#include <C4NavigationGrid.h>
+
+#include <C4FacetEx.h>
+#include <C4Game.h>
+#include <C4TransferZone.h>
+
+#include <array>
+
+namespace
+{
+	// neighbour directions; bit i of Cell::Edges stands for direction i
+	const int32_t DirX[8] = { -1, 0, 1, -1, 1, -1, 0, 1 };
+	const int32_t DirY[8] = { -1, -1, -1, 0, 0, 1, 1, 1 };
+
+	const int32_t MaxSmoothCells = 64; // waypoint smoothing does not look further ahead
+
+	// candidate points of a cell, closest to the center first
+	std::array<std::pair<int8_t, int8_t>, C4NavGrid_CellSize * C4NavGrid_CellSize> MakePointOrder()
+	{
+		std::array<std::pair<int8_t, int8_t>, C4NavGrid_CellSize * C4NavGrid_CellSize> Order;
+		for (int32_t y = 0; y < C4NavGrid_CellSize; ++y)
+			for (int32_t x = 0; x < C4NavGrid_CellSize; ++x)
+				Order[y * C4NavGrid_CellSize + x] = {static_cast<int8_t>(x), static_cast<int8_t>(y)};
+		const auto Dist = [](const std::pair<int8_t, int8_t> &p)
+		{
+			const int32_t dx = 2 * p.first + 1 - C4NavGrid_CellSize, dy = 2 * p.second + 1 - C4NavGrid_CellSize;
+			return dx * dx + dy * dy;
+		};
+		std::stable_sort(Order.begin(), Order.end(), [&Dist](const auto &a, const auto &b) { return Dist(a) < Dist(b); });
+		return Order;
+	}
+
+	const auto PointOrder = MakePointOrder();
+}
+
+C4NavigationGrid::C4NavigationGrid(int32_t iWdt, int32_t iHgt, bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones)
+	: Wdt((iWdt + C4NavGrid_CellSize - 1) / C4NavGrid_CellSize), Hgt((iHgt + C4NavGrid_CellSize - 1) / C4NavGrid_CellSize),
+	RegionWdt((Wdt + C4NavGrid_RegionCells - 1) / C4NavGrid_RegionCells), RegionHgt((Hgt + C4NavGrid_RegionCells - 1) / C4NavGrid_RegionCells),
+	PointFree(fnPointFree), TransferZones(pTransferZones),
+	Cells(Wdt * Hgt), RegionStamps(RegionWdt * RegionHgt, 0) {}
+
+void C4NavigationGrid::InvalidateRect(const C4Rect &rRect)
+{
+	const int32_t cx1 = std::max<int32_t>(rRect.x / C4NavGrid_CellSize, 0), cy1 = std::max<int32_t>(rRect.y / C4NavGrid_CellSize, 0);
+	const int32_t cx2 = std::min<int32_t>((rRect.x + rRect.Wdt) / C4NavGrid_CellSize, Wdt - 1), cy2 = std::min<int32_t>((rRect.y + rRect.Hgt) / C4NavGrid_CellSize, Hgt - 1);
+	if (cx1 > cx2 || cy1 > cy2) return;
+	for (int32_t cy = cy1; cy <= cy2; ++cy)
+		for (int32_t cx = cx1; cx <= cx2; ++cx)
+			InvalidateCell(cx, cy);
+	++ChangeCounter;
+	for (int32_t ry = cy1 / C4NavGrid_RegionCells; ry <= cy2 / C4NavGrid_RegionCells; ++ry)
+		for (int32_t rx = cx1 / C4NavGrid_RegionCells; rx <= cx2 / C4NavGrid_RegionCells; ++rx)
+			RegionStamps[ry * RegionWdt + rx] = ChangeCounter;
+}
+
+int32_t C4NavigationGrid::CellAt(int32_t iX, int32_t iY) const
+{
+	if (iX < 0 || iY < 0) return -1;
+	const int32_t cx = iX / C4NavGrid_CellSize, cy = iY / C4NavGrid_CellSize;
+	if (cx >= Wdt || cy >= Hgt) return -1;
+	return cy * Wdt + cx;
+}
+
+const C4NavigationGrid::Cell &C4NavigationGrid::GetPoint(int32_t iCell)
+{
+	Cell &rCell = Cells[iCell];
+	if (rCell.Flags & CF_Point) return rCell;
+	// first free pixel around the center
+	const int32_t iX = (iCell % Wdt) * C4NavGrid_CellSize, iY = (iCell / Wdt) * C4NavGrid_CellSize;
+	rCell.PointX = rCell.PointY = -1;
+	for (const auto &Point : PointOrder)
+		if (PointFree(iX + Point.first, iY + Point.second))
+		{
+			rCell.PointX = Point.first; rCell.PointY = Point.second;
+			break;
+		}
+	rCell.Flags |= CF_Point;
+	return rCell;
+}
+
+bool C4NavigationGrid::CellPoint(int32_t iCell, int32_t &rX, int32_t &rY)
+{
+	const Cell &rCell = GetPoint(iCell);
+	if (rCell.PointX < 0) return false;
+	rX = (iCell % Wdt) * C4NavGrid_CellSize + rCell.PointX;
+	rY = (iCell / Wdt) * C4NavGrid_CellSize + rCell.PointY;
+	return true;
+}
+
+const C4NavigationGrid::Cell &C4NavigationGrid::GetEdges(int32_t iCell)
+{
+	Cell &rCell = Cells[iCell];
+	if (rCell.Flags & CF_Edges) return rCell;
+	rCell.Edges = 0;
+	int32_t iX, iY;
+	if (CellPoint(iCell, iX, iY))
+	{
+		const int32_t cx = iCell % Wdt, cy = iCell / Wdt;
+		for (int32_t i = 0; i < 8; ++i)
+		{
+			const int32_t nx = cx + DirX[i], ny = cy + DirY[i];
+			if (!Inside<int32_t>(nx, 0, Wdt - 1) || !Inside<int32_t>(ny, 0, Hgt - 1)) continue;
+			int32_t iToX, iToY;
+			if (CellPoint(ny * Wdt + nx, iToX, iToY) && PathFree(iX, iY, iToX, iToY))
+				rCell.Edges |= 1 << i;
+		}
+	}
+	rCell.Flags |= CF_Edges;
+	return rCell;
+}
+
+bool C4NavigationGrid::PathFree(int32_t iX, int32_t iY, int32_t iToX, int32_t iToY) const
+{
+	// bresenham, like C4PathFinderRay::PathFree
+	const int32_t dx = Abs(iToX - iX), dy = Abs(iToY - iY);
+	const int32_t xincr = (iToX > iX) ? +1 : -1, yincr = (iToY > iY) ? +1 : -1;
+	if (dx < dy)
+	{
+		int32_t d = 2 * dx - dy, x = iX;
+		for (int32_t y = iY; y != iToY; y += yincr)
+		{
+			if (!PointFree(x, y)) return false;
+			if (d >= 0) { x += xincr; d += 2 * (dx - dy); }
+			else d += 2 * dx;
+		}
+	}
+	else
+	{
+		int32_t d = 2 * dy - dx, y = iY;
+		for (int32_t x = iX; x != iToX; x += xincr)
+		{
+			if (!PointFree(x, y)) return false;
+			if (d >= 0) { y += yincr; d += 2 * (dy - dx); }
+			else d += 2 * dy;
+		}
+	}
+	return PointFree(iToX, iToY);
+}
+
+void C4NavigationGrid::TouchCell(int32_t iCell)
+{
+	const int32_t cx = iCell % Wdt, cy = iCell / Wdt;
+	SearchX1 = std::min(SearchX1, cx); SearchY1 = std::min(SearchY1, cy);
+	SearchX2 = std::max(SearchX2, cx); SearchY2 = std::max(SearchY2, cy);
+}
+
+bool C4NavigationGrid::IsCacheEntryValid(const CacheEntry &rEntry) const
+{
+	// no change in any region the search has looked at
+	for (int32_t ry = rEntry.Y1 / C4NavGrid_RegionCells; ry <= rEntry.Y2 / C4NavGrid_RegionCells; ++ry)
+		for (int32_t rx = rEntry.X1 / C4NavGrid_RegionCells; rx <= rEntry.X2 / C4NavGrid_RegionCells; ++rx)
+			if (RegionStamps[ry * RegionWdt + rx] > rEntry.Stamp)
+				return false;
+	return true;
+}
+
+C4NavigationGrid::CacheEntry *C4NavigationGrid::FindCached(int32_t iFromCell, int32_t iToCell, int32_t iLevel, bool fZones, uint32_t iZoneChanges)
+{
+	for (CacheEntry &rEntry : Cache)
+		if (rEntry.FromCell == iFromCell && rEntry.ToCell == iToCell && rEntry.Level == iLevel && rEntry.fZones == fZones)
+		{
+			if (rEntry.ZoneChanges != iZoneChanges || !IsCacheEntryValid(rEntry))
+			{
+				// outdated
+				rEntry.FromCell = -1;
+				return nullptr;
+			}
+			return &rEntry;
+		}
+	return nullptr;
+}
+
+bool C4NavigationGrid::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iLevel, bool fTransferZones, SetWaypointFn fnSetWaypoint, intptr_t iWaypointParameter)
+{
+	LastPath.clear();
+	const int32_t iFromCell = CellAt(iFromX, iFromY), iToCell = CellAt(iToX, iToY);
+	if (iFromCell < 0 || iToCell < 0) return false;
+	const bool fZones = fTransferZones && TransferZones;
+	const uint32_t iZoneChanges = fZones ? TransferZones->GetChanges() : 0;
+	// the search only depends on the cells, so it can be reused for other points in the same cells
+	// as long as nothing has changed where it looked
+	CacheEntry *pEntry = FindCached(iFromCell, iToCell, iLevel, fZones, iZoneChanges);
+	if (!pEntry)
+	{
+		if (Cache.size() < C4NavGrid_CacheSize)
+			pEntry = &Cache.emplace_back();
+		else
+			pEntry = &*std::min_element(Cache.begin(), Cache.end(), [](const CacheEntry &a, const CacheEntry &b) { return a.LastUse < b.LastUse; });
+		pEntry->FromCell = iFromCell; pEntry->ToCell = iToCell;
+		pEntry->Level = iLevel; pEntry->fZones = fZones;
+		pEntry->ZoneChanges = iZoneChanges;
+		Search(*pEntry);
+	}
+	pEntry->LastUse = ++CacheUses;
+	if (!pEntry->fFound) return false;
+	SetWaypoints(*pEntry, iFromX, iFromY, iToX, iToY, fnSetWaypoint, iWaypointParameter);
+	return true;
+}
+
+void C4NavigationGrid::Search(CacheEntry &rEntry)
+{
+	rEntry.fFound = false;
+	rEntry.Path.clear();
+	rEntry.Stamp = ChangeCounter;
+	// search state is only allocated once somebody searches
+	if (NodeStamps.empty())
+	{
+		NodeStamps.resize(Cells.size(), 0);
+		NodeCosts.resize(Cells.size());
+		NodeParents.resize(Cells.size());
+		NodeZones.resize(Cells.size());
+	}
+	if (!++SearchStamp)
+	{
+		std::fill(NodeStamps.begin(), NodeStamps.end(), 0);
+		SearchStamp = 1;
+	}
+	Open.clear();
+	SearchZones.clear();
+	SearchX1 = SearchY1 = INT32_MAX; SearchX2 = SearchY2 = INT32_MIN;
+	TouchCell(rEntry.FromCell);
+	TouchCell(rEntry.ToCell);
+
+	int32_t iTargetX, iTargetY;
+	if (CellPoint(rEntry.ToCell, iTargetX, iTargetY))
+	{
+		const auto Estimate = [&](int32_t iX, int32_t iY) { return Distance(iX, iY, iTargetX, iTargetY); };
+		// add or improve an open node
+		const auto Reach = [&](int32_t iCell, int32_t iX, int32_t iY, int32_t iCost, int32_t iParent, int32_t iZone)
+		{
+			if (NodeStamps[iCell] == SearchStamp && NodeCosts[iCell] <= iCost) return;
+			NodeStamps[iCell] = SearchStamp;
+			NodeCosts[iCell] = iCost;
+			NodeParents[iCell] = iParent;
+			NodeZones[iCell] = iZone;
+			Open.emplace_back(iCost + Estimate(iX, iY), iCell);
+			std::push_heap(Open.begin(), Open.end(), std::greater<>());
+		};
+
+		int32_t iX, iY;
+		CellPoint(rEntry.FromCell, iX, iY);
+		Reach(rEntry.FromCell, iX, iY, 0, -1, -1);
+		int32_t iExpanded = 0;
+		const int32_t iMaxExpand = C4NavGrid_MaxExpand * rEntry.Level;
+		while (!Open.empty())
+		{
+			std::pop_heap(Open.begin(), Open.end(), std::greater<>());
+			const auto [iEstimate, iCell] = Open.back();
+			Open.pop_back();
+			CellPoint(iCell, iX, iY);
+			// outdated entry of a node that has been reached cheaper since
+			const int32_t iCost = NodeCosts[iCell];
+			if (iEstimate != iCost + Estimate(iX, iY)) continue;
+			// arrived?
+			if (iCell == rEntry.ToCell)
+			{
+				rEntry.fFound = true;
+				break;
+			}
+			if (++iExpanded > iMaxExpand) break;
+			TouchCell(iCell);
+			// transfer zone here that has not just been used to get here?
+			if (rEntry.fZones)
+				if (C4TransferZone *pZone = TransferZones->Find(iX, iY))
+					if (NodeZones[iCell] < 0 || SearchZones[NodeZones[iCell]].ZoneObject != pZone->Object)
+					{
+						// the exit depends on the landscape around the zone
+						const int32_t iMaxX = Wdt * C4NavGrid_CellSize - 1, iMaxY = Hgt * C4NavGrid_CellSize - 1;
+						TouchCell(CellAt(BoundBy<int32_t>(pZone->X - 1, 0, iMaxX), BoundBy<int32_t>(pZone->Y - 1, 0, iMaxY)));
+						TouchCell(CellAt(BoundBy<int32_t>(pZone->X + pZone->Wdt, 0, iMaxX), BoundBy<int32_t>(pZone->Y + pZone->Hgt, 0, iMaxY)));
+						int32_t iExitX = iTargetX, iExitY = iTargetY;
+						if (pZone->At(iTargetX, iTargetY) || pZone->GetEntryPoint(iExitX, iExitY, iTargetX, iTargetY))
+						{
+							const int32_t iExitCell = CellAt(iExitX, iExitY);
+							int32_t iCellX, iCellY;
+							if (iExitCell >= 0 && CellPoint(iExitCell, iCellX, iCellY))
+							{
+								SearchZones.push_back({iExitCell, pZone->Object, iExitX, iExitY});
+								Reach(iExitCell, iCellX, iCellY, iCost + Distance(iX, iY, iExitX, iExitY), iCell, static_cast<int32_t>(SearchZones.size()) - 1);
+							}
+						}
+					}
+			// neighbours
+			const uint8_t Edges = GetEdges(iCell).Edges;
+			for (int32_t i = 0; i < 8; ++i)
+				if (Edges & (1 << i))
+				{
+					const int32_t iNext = iCell + DirY[i] * Wdt + DirX[i];
+					int32_t iNextX, iNextY;
+					CellPoint(iNext, iNextX, iNextY);
+					Reach(iNext, iNextX, iNextY, iCost + Distance(iX, iY, iNextX, iNextY), iCell, -1);
+				}
+		}
+	}
+
+	// remember where the search has looked: edges depend on the neighbours
+	rEntry.X1 = std::max(SearchX1 - 1, 0); rEntry.Y1 = std::max(SearchY1 - 1, 0);
+	rEntry.X2 = std::min(SearchX2 + 1, Wdt - 1); rEntry.Y2 = std::min(SearchY2 + 1, Hgt - 1);
+
+	if (!rEntry.fFound) return;
+	for (int32_t iCell = rEntry.ToCell; iCell >= 0; iCell = NodeParents[iCell])
+	{
+		const int32_t iZone = NodeZones[iCell];
+		if (iZone >= 0)
+			rEntry.Path.push_back(SearchZones[iZone]);
+		else
+			rEntry.Path.push_back({iCell, nullptr, 0, 0});
+	}
+	std::reverse(rEntry.Path.begin(), rEntry.Path.end());
+}
+
+void C4NavigationGrid::SetWaypoints(const CacheEntry &rEntry, int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, SetWaypointFn fnSetWaypoint, intptr_t iWaypointParameter)
+{
+	struct Waypoint { int32_t X, Y; C4Object *Transfer; };
+	std::vector<Waypoint> Waypoints;
+	std::vector<std::pair<int32_t, int32_t>> Points; // candidates of the current straight walk; neighbours are connected
+	int32_t iX = iFromX, iY = iFromY;
+	// skip cell points that can be seen from the last waypoint
+	const auto Walk = [&]()
+	{
+		size_t i = 0;
+		while (i + 1 < Points.size())
+		{
+			size_t j = i;
+			while (j + 1 < Points.size() && j + 1 - i < MaxSmoothCells && PathFree(iX, iY, Points[j + 1].first, Points[j + 1].second)) ++j;
+			if (j + 1 == Points.size()) break;
+			iX = Points[j].first; iY = Points[j].second;
+			Waypoints.push_back({iX, iY, nullptr});
+			i = j + 1;
+		}
+		Points.clear();
+	};
+	const auto AddCellPoint = [&](int32_t iCell)
+	{
+		int32_t iCellX, iCellY;
+		if (CellPoint(iCell, iCellX, iCellY)) Points.emplace_back(iCellX, iCellY);
+	};
+	AddCellPoint(rEntry.Path.front().Cell);
+	for (size_t i = 1; i < rEntry.Path.size(); ++i)
+	{
+		const PathNode &rNode = rEntry.Path[i];
+		const bool fLast = (i + 1 == rEntry.Path.size());
+		if (rNode.ZoneObject)
+		{
+			// walk into the zone, then transfer; the transfer command finds its own way to the zone
+			Walk();
+			const int32_t iExitX = fLast ? iToX : rNode.ExitX, iExitY = fLast ? iToY : rNode.ExitY;
+			Waypoints.push_back({iExitX, iExitY, rNode.ZoneObject});
+			if (fLast) break;
+			Waypoints.push_back({iExitX, iExitY, nullptr});
+			iX = iExitX; iY = iExitY;
+		}
+		AddCellPoint(rNode.Cell);
+	}
+	Points.emplace_back(iToX, iToY);
+	Walk();
+	// waypoints are set from the target back to the start, like C4PathFinderRay::SetCompletePath does
+	for (auto it = Waypoints.rbegin(); it != Waypoints.rend(); ++it)
+		fnSetWaypoint(it->X, it->Y, reinterpret_cast<intptr_t>(it->Transfer), iWaypointParameter);
+	// for drawing
+	LastPath.emplace_back(iFromX, iFromY);
+	for (const Waypoint &rWaypoint : Waypoints) LastPath.emplace_back(rWaypoint.X, rWaypoint.Y);
+	LastPath.emplace_back(iToX, iToY);
+}
+
+void C4NavigationGrid::Draw(C4FacetEx &cgo)
+{
+	for (size_t i = 1; i < LastPath.size(); ++i)
+		lpDDraw->DrawLine(cgo.Surface,
+			cgo.X + LastPath[i - 1].first - cgo.TargetX, cgo.Y + LastPath[i - 1].second - cgo.TargetY,
+			cgo.X + LastPath[i].first - cgo.TargetX, cgo.Y + LastPath[i].second - cgo.TargetY,
+			CYellow);
+	for (const auto &Point : LastPath)
+		lpDDraw->DrawFrame(cgo.Surface,
+			cgo.X + Point.first - cgo.TargetX - 1, cgo.Y + Point.second - cgo.TargetY - 1,
+			cgo.X + Point.first - cgo.TargetX + 1, cgo.Y + Point.second - cgo.TargetY + 1,
+			CYellow);
+}
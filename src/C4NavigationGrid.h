@@ -0,0 +1,138 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+/* A* path search on a grid of landscape cells, alternative to the ray crawling C4PathFinder */
+
+// The landscape is divided into cells. Each free cell has a representative free point,
+// and two neighbouring cells are connected if the straight line between their points is free.
+// Cells are evaluated lazily and invalidated whenever the solidity of one of their pixels
+// changes, so search results only depend on the current landscape and can be used in sync.
+
+#pragma once
+
+#include <C4Shape.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+class C4FacetEx;
+class C4Object;
+class C4TransferZones;
+
+const int32_t C4NavGrid_CellSize    = 8, // pixels per cell side
+              C4NavGrid_RegionCells = 8, // cells per change tracking region side
+              C4NavGrid_CacheSize   = 64, // number of cached searches
+              C4NavGrid_MaxExpand   = 8000; // expanded cells per search and pathfinder level
+
+class C4NavigationGrid
+{
+public:
+	C4NavigationGrid(int32_t iWdt, int32_t iHgt, bool(*fnPointFree)(int32_t, int32_t), C4TransferZones *pTransferZones);
+
+	typedef bool(*SetWaypointFn)(int32_t, int32_t, intptr_t, intptr_t);
+
+private:
+	enum
+	{
+		CF_Point = 1, // Point is valid
+		CF_Edges = 2, // Edges are valid
+	};
+
+	struct Cell
+	{
+		int8_t PointX = 0, PointY = 0; // representative free point relative to the cell; -1 if the cell is solid
+		uint8_t Edges = 0; // bit set for each free direction
+		uint8_t Flags = 0;
+	};
+
+	// one step of a found path
+	struct PathNode
+	{
+		int32_t Cell;
+		C4Object *ZoneObject; // if set, the cell is reached by transfer from the zone of this object...
+		int32_t ExitX, ExitY; // ...leaving it here
+	};
+
+	struct CacheEntry
+	{
+		int32_t FromCell = -1, ToCell = -1, Level = 0;
+		bool fZones = false;
+		bool fFound = false;
+		uint64_t Stamp = 0; // change counter at search time
+		uint32_t ZoneChanges = 0;
+		int32_t X1 = 0, Y1 = 0, X2 = 0, Y2 = 0; // cells that the search has looked at
+		uint64_t LastUse = 0;
+		std::vector<PathNode> Path; // from start to target cell
+	};
+
+	int32_t Wdt, Hgt; // in cells
+	int32_t RegionWdt, RegionHgt;
+	bool(*PointFree)(int32_t, int32_t);
+	C4TransferZones *TransferZones;
+	std::vector<Cell> Cells;
+	std::vector<uint64_t> RegionStamps; // change counter of the last change in each region
+	uint64_t ChangeCounter = 0;
+
+	// search state; indexed by cell, valid if the node stamp matches the search
+	std::vector<uint32_t> NodeStamps;
+	std::vector<int32_t> NodeCosts, NodeParents;
+	std::vector<int32_t> NodeZones; // index into SearchZones if the node was reached by transfer, else -1
+	std::vector<PathNode> SearchZones;
+	std::vector<std::pair<int32_t, int32_t>> Open; // (estimated total cost, cell) heap
+	uint32_t SearchStamp = 0;
+	int32_t SearchX1, SearchY1, SearchX2, SearchY2;
+
+	std::vector<CacheEntry> Cache;
+	uint64_t CacheUses = 0;
+	std::vector<std::pair<int32_t, int32_t>> LastPath; // waypoints of the last search, for drawing
+
+public:
+	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iLevel, bool fTransferZones, SetWaypointFn fnSetWaypoint, intptr_t iWaypointParameter);
+
+	void InvalidatePoint(int32_t iX, int32_t iY)
+	{
+		const int32_t cx = iX / C4NavGrid_CellSize, cy = iY / C4NavGrid_CellSize;
+		if (!Inside<int32_t>(cx, 0, Wdt - 1) || !Inside<int32_t>(cy, 0, Hgt - 1)) return;
+		InvalidateCell(cx, cy);
+		RegionStamps[(cy / C4NavGrid_RegionCells) * RegionWdt + cx / C4NavGrid_RegionCells] = ++ChangeCounter;
+	}
+	void InvalidateRect(const C4Rect &rRect);
+
+	void Draw(C4FacetEx &cgo);
+
+private:
+	void InvalidateCell(int32_t cx, int32_t cy)
+	{
+		// the cell's point and all edges leading into it
+		Cells[cy * Wdt + cx].Flags = 0;
+		for (int32_t y = std::max<int32_t>(cy - 1, 0); y <= std::min<int32_t>(cy + 1, Hgt - 1); ++y)
+			for (int32_t x = std::max<int32_t>(cx - 1, 0); x <= std::min<int32_t>(cx + 1, Wdt - 1); ++x)
+				Cells[y * Wdt + x].Flags &= ~CF_Edges;
+	}
+
+	const Cell &GetPoint(int32_t iCell);
+	const Cell &GetEdges(int32_t iCell);
+	bool CellPoint(int32_t iCell, int32_t &rX, int32_t &rY);
+	int32_t CellAt(int32_t iX, int32_t iY) const;
+	bool PathFree(int32_t iX, int32_t iY, int32_t iToX, int32_t iToY) const;
+	void TouchCell(int32_t iCell);
+
+	CacheEntry *FindCached(int32_t iFromCell, int32_t iToCell, int32_t iLevel, bool fZones, uint32_t iZoneChanges);
+	bool IsCacheEntryValid(const CacheEntry &rEntry) const;
+	void Search(CacheEntry &rEntry);
+	void SetWaypoints(const CacheEntry &rEntry, int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, SetWaypointFn fnSetWaypoint, intptr_t iWaypointParameter);
+};
@@ -853,11 +853,19 @@ C4NetIOTCP::C4NetIOTCP()
 #endif
 	PeerListCSec(this),
 	iListenPort(~0), lsock(INVALID_SOCKET),
-	pCB(nullptr) {}
+	pCB(nullptr)
+{
+#ifdef STDSCHEDULER_USE_EPOLL
+	EPollFD = epoll_create1(EPOLL_CLOEXEC);
+#endif
+}
 
 C4NetIOTCP::~C4NetIOTCP()
 {
 	Close();
+#ifdef STDSCHEDULER_USE_EPOLL
+	if (EPollFD != -1) close(EPollFD);
+#endif
 }
 
 bool C4NetIOTCP::Init(uint16_t iPort)
@@ -874,6 +882,15 @@ bool C4NetIOTCP::Init(uint16_t iPort)
 	}
 #endif
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// creating it in the constructor failed? Try again
+	if (EPollFD == -1 && (EPollFD = epoll_create1(EPOLL_CLOEXEC)) == -1)
+	{
+		SetError("could not create epoll descriptor", true);
+		return false;
+	}
+#endif
+
 #ifdef STDSCHEDULER_USE_EVENTS
 	// create event
 	if ((Event = WSACreateEvent()) == WSA_INVALID_EVENT)
@@ -890,6 +907,12 @@ bool C4NetIOTCP::Init(uint16_t iPort)
 	}
 #endif
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// watch pipe
+	if (!EPollCtl(EPOLL_CTL_ADD, Pipe[0], EPOLLIN, Pipe))
+		return false;
+#endif
+
 	// create listen socket (if necessary)
 	if (iPort != addr_t::IPPORT_NONE)
 		if (!Listen(iPort))
@@ -959,6 +982,80 @@ bool C4NetIOTCP::CloseBroadcast()
 	return true;
 }
 
+#ifdef STDSCHEDULER_USE_EPOLL
+
+bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
+{
+	// security
+	if (!fInit) return false;
+
+	// wait with the peer list locked, so the peers the events point to stay alive
+	// (closed peers are only deleted once nobody holds the lock, see OnShareFree)
+	CStdShareLock PeerListLock(&PeerListCSec);
+	epoll_event Events[64];
+	const int iEventCnt = epoll_wait(EPollFD, Events, std::size(Events), iMaxTime == C4NetIO::TO_INF ? -1 : iMaxTime);
+
+	// error
+	if (iEventCnt < 0)
+	{
+		if (errno == EINTR) return true;
+		SetError("epoll_wait failed", true);
+		return false;
+	}
+
+	// only sockets with events are checked (the rest is level-triggered and reported again next time)
+	for (int i = 0; i < iEventCnt; i++)
+	{
+		void *const pData = Events[i].data.ptr;
+
+		// flush pipe
+		if (pData == Pipe)
+		{
+			char c;
+			::read(Pipe[0], &c, 1);
+			continue;
+		}
+
+		// a connection waiting for accept?
+		if (pData == &lsock)
+		{
+			if (lsock != INVALID_SOCKET)
+				if (!Accept())
+					return false;
+			continue;
+		}
+
+		// waited-for connection? (there are only a few of them)
+		ConnectWait *pWait = pConnectWaits;
+		while (pWait && pWait != pData) pWait = pWait->Next;
+		if (pWait)
+		{
+			if (pWait->sock != INVALID_SOCKET)
+				if (!OnConnectWaitWriteable(pWait))
+					return false;
+			continue;
+		}
+
+		// connected socket
+		Peer *pPeer = static_cast<Peer *>(pData);
+		if (!pPeer->Open()) continue;
+
+		// something to read from socket? (errors and hangups are reported by recv)
+		if (Events[i].events & (EPOLLIN | EPOLLERR | EPOLLHUP))
+			ReadPeer(pPeer);
+
+		// socket has become writeable?
+		if (pPeer->Open() && (Events[i].events & EPOLLOUT))
+			// send remaining data
+			pPeer->Send();
+	}
+
+	// done
+	return true;
+}
+
+#else
+
 bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 {
 	// security
@@ -1049,15 +1146,10 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 				return false;
 
 			if (wsaEvents.lNetworkEvents & FD_CONNECT)
-#else
-			// got connection?
-			if (FD_ISSET(pWait->sock, &fds[1]))
-#endif
 			{
 				// remove from list
 				SOCKET sock = pWait->sock; pWait->sock = INVALID_SOCKET;
 
-#ifdef STDSCHEDULER_USE_EVENTS
 				// error?
 				if (wsaEvents.iErrorCode[FD_CONNECT_BIT])
 				{
@@ -1065,26 +1157,16 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(wsaEvents.iErrorCode[FD_CONNECT_BIT]));
 				}
 				else
-#else
-				// get error code
-				int iErrCode; socklen_t iErrCodeLen = sizeof(iErrCode);
-				if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&iErrCode), &iErrCodeLen) != 0)
-				{
-					close(sock);
-					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg());
-				}
-				// error?
-				else if (iErrCode)
-				{
-					close(sock);
-					if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(iErrCode));
-				}
-				else
-#endif
 					// accept connection, do callback
 					if (!Accept(sock, pWait->addr))
 						return false;
 			}
+#else
+			// got connection?
+			if (FD_ISSET(pWait->sock, &fds[1]))
+				if (!OnConnectWaitWriteable(pWait))
+					return false;
+#endif
 		}
 	}
 
@@ -1105,50 +1187,7 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 			// something to read from socket?
 			if (FD_ISSET(sock, &fds[0]))
 #endif
-				for (;;)
-				{
-					// how much?
-#ifdef _WIN32
-					DWORD iBytesToRead;
-#else
-					int iBytesToRead;
-#endif
-					if (::ioctlsocket(sock, FIONREAD, &iBytesToRead) == SOCKET_ERROR)
-					{
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
-						break;
-					}
-					// The following two lines of code will make sure that if the variable
-					// "iBytesToRead" is zero, it will be increased by one.
-					// In this case, it will hold the value 1 after the operation.
-					// Note it doesn't do anything for negative values.
-					// (This comment has been sponsored by Sven2)
-					if (!iBytesToRead)
-						++iBytesToRead;
-					// get buffer
-					void *pBuf = pPeer->GetRecvBuf(iBytesToRead);
-					// read a buffer full of data from socket
-					int iBytesRead;
-					if ((iBytesRead = ::recv(sock, reinterpret_cast<char *>(pBuf), iBytesToRead, 0)) == SOCKET_ERROR)
-					{
-						// Would block? Ok, let's try this again later
-						if (HaveWouldBlockError()) { ResetSocketError(); break; }
-						// So he's serious after all...
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
-						break;
-					}
-					// nothing? this means the conection was closed, if you trust in linux manpages.
-					if (!iBytesRead)
-					{
-						pPeer->Close();
-						if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, "connection closed");
-						break;
-					}
-					// pass to Peer::OnRecv
-					pPeer->OnRecv(iBytesRead);
-				}
+				ReadPeer(pPeer);
 
 #ifdef STDSCHEDULER_USE_EVENTS
 			// socket has become writeable?
@@ -1177,6 +1216,92 @@ bool C4NetIOTCP::Execute(int iMaxTime) // (mt-safe)
 	return true;
 }
 
+#endif
+
+#ifndef STDSCHEDULER_USE_EVENTS
+
+bool C4NetIOTCP::OnConnectWaitWriteable(ConnectWait *pWait) // (mt-safe)
+{
+	// remove from list
+	SOCKET sock = pWait->sock; pWait->sock = INVALID_SOCKET;
+
+#ifdef STDSCHEDULER_USE_EPOLL
+	// the peer will register the socket again
+	epoll_ctl(EPollFD, EPOLL_CTL_DEL, sock, nullptr);
+#endif
+
+	// get error code
+	int iErrCode; socklen_t iErrCodeLen = sizeof(iErrCode);
+	if (getsockopt(sock, SOL_SOCKET, SO_ERROR, reinterpret_cast<char *>(&iErrCode), &iErrCodeLen) != 0)
+	{
+		close(sock);
+		if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg());
+	}
+	// error?
+	else if (iErrCode)
+	{
+		close(sock);
+		if (pCB) pCB->OnDisconn(pWait->addr, this, GetSocketErrorMsg(iErrCode));
+	}
+	else
+		// accept connection, do callback
+		if (!Accept(sock, pWait->addr))
+			return false;
+
+	return true;
+}
+
+#endif
+
+void C4NetIOTCP::ReadPeer(Peer *pPeer) // (mt-safe)
+{
+	const SOCKET sock = pPeer->GetSocket();
+	for (;;)
+	{
+		// how much?
+#ifdef _WIN32
+		DWORD iBytesToRead;
+#else
+		int iBytesToRead;
+#endif
+		if (::ioctlsocket(sock, FIONREAD, &iBytesToRead) == SOCKET_ERROR)
+		{
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
+			break;
+		}
+		// The following two lines of code will make sure that if the variable
+		// "iBytesToRead" is zero, it will be increased by one.
+		// In this case, it will hold the value 1 after the operation.
+		// Note it doesn't do anything for negative values.
+		// (This comment has been sponsored by Sven2)
+		if (!iBytesToRead)
+			++iBytesToRead;
+		// get buffer
+		void *pBuf = pPeer->GetRecvBuf(iBytesToRead);
+		// read a buffer full of data from socket
+		int iBytesRead;
+		if ((iBytesRead = ::recv(sock, reinterpret_cast<char *>(pBuf), iBytesToRead, 0)) == SOCKET_ERROR)
+		{
+			// Would block? Ok, let's try this again later
+			if (HaveWouldBlockError()) { ResetSocketError(); break; }
+			// So he's serious after all...
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, GetSocketErrorMsg());
+			break;
+		}
+		// nothing? this means the conection was closed, if you trust in linux manpages.
+		if (!iBytesRead)
+		{
+			pPeer->Close();
+			if (pCB) pCB->OnDisconn(pPeer->GetAddr(), this, "connection closed");
+			break;
+		}
+		// pass to Peer::OnRecv
+		pPeer->OnRecv(iBytesRead);
+	}
+}
+
 C4NetIOTCP::Socket::~Socket()
 {
 	if (sock != INVALID_SOCKET)
@@ -1387,6 +1512,26 @@ HANDLE C4NetIOTCP::GetEvent() // (mt-safe)
 	return Event;
 }
 
+#elif defined(STDSCHEDULER_USE_EPOLL)
+
+int C4NetIOTCP::GetFD() // (mt-safe)
+{
+	return EPollFD;
+}
+
+bool C4NetIOTCP::EPollCtl(int iOp, SOCKET nsock, uint32_t iEvents, void *pData) // (mt-safe)
+{
+	epoll_event Event{};
+	Event.events = iEvents;
+	Event.data.ptr = pData;
+	if (epoll_ctl(EPollFD, iOp, nsock, &Event) != 0)
+	{
+		SetError("could not register socket with epoll", true);
+		return false;
+	}
+	return true;
+}
+
 #else
 
 void C4NetIOTCP::GetFDs(fd_set *pFDs, int *pMaxFD)
@@ -1543,6 +1688,16 @@ C4NetIOTCP::Peer *C4NetIOTCP::Accept(SOCKET nsock, const addr_t &ConnectAddr) //
 	// create new peer
 	Peer *pnPeer = new Peer(addr, nsock, this);
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// watch socket
+	if (!EPollCtl(EPOLL_CTL_ADD, nsock, EPOLLIN, pnPeer))
+	{
+		// (closes the socket)
+		delete pnPeer;
+		return nullptr;
+	}
+#endif
+
 	// get required locks to add item to list
 	CStdShareLock PeerListLock(&PeerListCSec);
 	CStdLock PeerListAddLock(&PeerListAddCSec);
@@ -1616,6 +1771,15 @@ bool C4NetIOTCP::Listen(uint16_t inListenPort)
 		return false;
 	}
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// watch for incoming connections
+	if (!EPollCtl(EPOLL_CTL_ADD, lsock, EPOLLIN, &lsock))
+	{
+		closesocket(lsock); lsock = INVALID_SOCKET;
+		return false;
+	}
+#endif
+
 	// ok
 	iListenPort = inListenPort;
 	return true;
@@ -1688,7 +1852,10 @@ void C4NetIOTCP::AddConnectWait(SOCKET sock, const addr_t &addr) // (mt-safe)
 	pnWait->sock = sock; pnWait->addr = addr;
 	pnWait->Next = pConnectWaits;
 	pConnectWaits = pnWait;
-#ifndef STDSCHEDULER_USE_EVENTS
+#ifdef STDSCHEDULER_USE_EPOLL
+	// wait for the socket to become writeable
+	EPollCtl(EPOLL_CTL_ADD, sock, EPOLLOUT, pnWait);
+#elif !defined(STDSCHEDULER_USE_EVENTS)
 	// unblock, so new FD can be realized
 	UnBlock();
 #endif
@@ -1749,8 +1916,8 @@ size_t C4NetIOTCP::UnpackPacket(const StdBuf &IBuf, const C4NetIO::addr_t &addr)
 	// packet incomplete?
 	if (iPos + iPacketSize < iPos || iPos + iPacketSize > IBuf.getSize())
 		return 0;
-	// ok, call back
-	if (pCB) pCB->OnPacket(C4NetIOPacket(IBuf.getPart(iPos, iPacketSize), addr), this);
+	// ok, call back (the packet references the input buffer)
+	if (pCB) pCB->OnPacket(C4NetIOPacket(IBuf.getPtr(iPos), iPacketSize, false, addr), this);
 	// absorbed
 	return iPos + iPacketSize;
 }
@@ -1766,7 +1933,12 @@ C4NetIOTCP::Peer::Peer(const C4NetIO::addr_t &naddr, SOCKET nsock, C4NetIOTCP *p
 	: pParent(pnParent),
 	addr(naddr), sock(nsock),
 	Next(nullptr), iIBufUsage(0), iIRate(0), iORate(0),
-	fOpen(true), fDoBroadcast(false) {}
+	fOpen(true), fDoBroadcast(false), fUnpacking(false)
+{
+#ifdef STDSCHEDULER_USE_EPOLL
+	fWatchWrite = false;
+#endif
+}
 
 C4NetIOTCP::Peer::~Peer()
 {
@@ -1806,7 +1978,14 @@ bool C4NetIOTCP::Peer::Send() // (mt-safe)
 		}
 
 	// nothin sent?
-	if (iBytesSent == SOCKET_ERROR || !iBytesSent) return true;
+	if (iBytesSent == SOCKET_ERROR || !iBytesSent)
+	{
+#ifdef STDSCHEDULER_USE_EPOLL
+		// try again once the socket has become writeable
+		WatchWrite(true);
+#endif
+		return true;
+	}
 
 	// increase output rate
 	iORate += iBytesSent + iTCPHeaderSize;
@@ -1817,14 +1996,22 @@ bool C4NetIOTCP::Peer::Send() // (mt-safe)
 		// Shrink buffer
 		OBuf.Move(iBytesSent, OBuf.getSize() - iBytesSent);
 		OBuf.Shrink(iBytesSent);
-#ifndef STDSCHEDULER_USE_EVENTS
+#ifdef STDSCHEDULER_USE_EPOLL
+		// try again once the socket has become writeable
+		WatchWrite(true);
+#elif !defined(STDSCHEDULER_USE_EVENTS)
 		// Unblock parent so the FD-list can be refreshed
 		pParent->UnBlock();
 #endif
 	}
 	else
+	{
 		// just delete buffer
 		OBuf.Clear();
+#ifdef STDSCHEDULER_USE_EPOLL
+		WatchWrite(false);
+#endif
+	}
 
 	// ok
 	return true;
@@ -1853,6 +2040,7 @@ void C4NetIOTCP::Peer::OnRecv(int iSize) // (mt-safe)
 	assert(iIBufUsage <= IBuf.getSize());
 	// read packets
 	size_t iPos = 0, iPacketPos;
+	fUnpacking = true;
 	while ((iPacketPos = iPos) < static_cast<size_t>(iIBufUsage))
 	{
 		// Try to unpack a packet
@@ -1864,6 +2052,14 @@ void C4NetIOTCP::Peer::OnRecv(int iSize) // (mt-safe)
 		// Advance
 		iPos += iBytes;
 	}
+	fUnpacking = false;
+	// closed by a packet handler? the buffer is no longer in use now
+	if (!fOpen)
+	{
+		IBuf.Clear();
+		iIBufUsage = 0;
+		return;
+	}
 	// data left?
 	if (iPacketPos < static_cast<size_t>(iIBufUsage))
 	{
@@ -1898,13 +2094,26 @@ void C4NetIOTCP::Peer::Close() // (mt-safe)
 	sock = INVALID_SOCKET;
 	// set flag
 	fOpen = false;
-	// clear buffers
-	IBuf.Clear(); OBuf.Clear();
+	// clear buffers (the input buffer is cleared by OnRecv if packets from it are being handled)
+	if (!fUnpacking) IBuf.Clear();
+	OBuf.Clear();
 	iIBufUsage = 0;
 	// reset statistics
 	iIRate = iORate = 0;
 }
 
+#ifdef STDSCHEDULER_USE_EPOLL
+
+void C4NetIOTCP::Peer::WatchWrite(bool fWatch) // (mt-safe)
+{
+	// (called with OCSec locked)
+	if (fWatch == fWatchWrite || !fOpen) return;
+	if (pParent->EPollCtl(EPOLL_CTL_MOD, sock, fWatch ? EPOLLIN | EPOLLOUT : EPOLLIN, this))
+		fWatchWrite = fWatch;
+}
+
+#endif
+
 void C4NetIOTCP::Peer::ClearStatistics() // (mt-safe)
 {
 	CStdLock ILock(&ICSec); CStdLock OLock(&OCSec);
@@ -1918,11 +2127,18 @@ C4NetIOSimpleUDP::C4NetIOSimpleUDP()
 #ifdef STDSCHEDULER_USE_EVENTS
 	, hEvent(nullptr)
 #endif
-{}
+{
+#ifdef STDSCHEDULER_USE_EPOLL
+	EPollFD = epoll_create1(EPOLL_CLOEXEC);
+#endif
+}
 
 C4NetIOSimpleUDP::~C4NetIOSimpleUDP()
 {
 	Close();
+#ifdef STDSCHEDULER_USE_EPOLL
+	if (EPollFD != -1) close(EPollFD);
+#endif
 }
 
 bool C4NetIOSimpleUDP::Init(uint16_t inPort)
@@ -1942,6 +2158,15 @@ bool C4NetIOSimpleUDP::Init(uint16_t inPort)
 	}
 #endif
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// creating it in the constructor failed? Try again
+	if (EPollFD == -1 && (EPollFD = epoll_create1(EPOLL_CLOEXEC)) == -1)
+	{
+		SetError("could not create epoll descriptor", true);
+		return false;
+	}
+#endif
+
 	// Create sockets
 	sock = ::socket(AF_INET6, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_UDP);
 	if (sock == INVALID_SOCKET)
@@ -2006,6 +2231,24 @@ bool C4NetIOSimpleUDP::Init(uint16_t inPort)
 
 #endif
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// watch pipe and socket
+	epoll_event Event{};
+	Event.events = EPOLLIN;
+	Event.data.ptr = Pipe;
+	if (epoll_ctl(EPollFD, EPOLL_CTL_ADD, Pipe[0], &Event) != 0)
+	{
+		SetError("could not register pipe with epoll", true);
+		return false;
+	}
+	Event.data.ptr = &sock;
+	if (epoll_ctl(EPollFD, EPOLL_CTL_ADD, sock, &Event) != 0)
+	{
+		SetError("could not register socket with epoll", true);
+		return false;
+	}
+#endif
+
 	// set flags
 	fInit = true;
 	fMultiCast = false;
@@ -2161,11 +2404,12 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 		// nothing?
 		if (!iMaxMsgSize)
 			break;
-		// alloc buffer
-		C4NetIOPacket Pkt; Pkt.New(iMaxMsgSize);
+		// alloc buffer (reused for all packets; callbacks copy what they want to keep)
+		if (RecvBuf.getSize() < static_cast<size_t>(iMaxMsgSize))
+			RecvBuf.New(iMaxMsgSize);
 		// read data (note: it is _not_ garantueed that iMaxMsgSize bytes are available)
 		addr_t SrcAddr; socklen_t iSrcAddrLen{sizeof(sockaddr_in6)};
-		int iMsgSize = ::recvfrom(sock, Pkt.getMPtr<char>(), iMaxMsgSize, 0, &SrcAddr, &iSrcAddrLen);
+		int iMsgSize = ::recvfrom(sock, RecvBuf.getMPtr<char>(), iMaxMsgSize, 0, &SrcAddr, &iSrcAddrLen);
 		// error?
 		if (iMsgSize == SOCKET_ERROR)
 			if (HaveConnResetError())
@@ -2193,8 +2437,7 @@ bool C4NetIOSimpleUDP::Execute(int iMaxTime)
 			// let's just pretend it didn't happen, but stop reading.
 			break;
 		// fill in packet information
-		Pkt.SetSize(iMsgSize);
-		Pkt.SetAddr(SrcAddr);
+		C4NetIOPacket Pkt(RecvBuf.getData(), iMsgSize, false, SrcAddr);
 		// callback
 		if (pCB) pCB->OnPacket(Pkt, this);
 	}
@@ -2278,6 +2521,40 @@ void C4NetIOSimpleUDP::UnBlock() // (mt-safe)
 	write(Pipe[1], &c, 1);
 }
 
+#ifdef STDSCHEDULER_USE_EPOLL
+
+int C4NetIOSimpleUDP::GetFD()
+{
+	return EPollFD;
+}
+
+enum C4NetIOSimpleUDP::WaitResult C4NetIOSimpleUDP::WaitForSocket(int iTimeout)
+{
+	// wait for anything to happen
+	epoll_event Events[2];
+	int ret = epoll_wait(EPollFD, Events, 2, iTimeout == C4NetIO::TO_INF ? -1 : iTimeout);
+	// catch simple cases
+	if (ret < 0)
+	{
+		SetError("epoll_wait failed", true); return WR_Error;
+	}
+	if (!ret)
+		return WR_Timeout;
+	bool fReadable = false;
+	for (int i = 0; i < ret; i++)
+		// flush pipe, if neccessary
+		if (Events[i].data.ptr == Pipe)
+		{
+			char c; ::read(Pipe[0], &c, 1);
+		}
+		else
+			fReadable = true;
+	// socket readable?
+	return fReadable ? WR_Readable : WR_Cancelled;
+}
+
+#else
+
 void C4NetIOSimpleUDP::GetFDs(fd_set *pFDs, int *pMaxFD)
 {
 	// add pipe
@@ -2317,6 +2594,8 @@ enum C4NetIOSimpleUDP::WaitResult C4NetIOSimpleUDP::WaitForSocket(int iTimeout)
 	return FD_ISSET(sock, &fds[0]) ? WR_Readable : WR_Cancelled;
 }
 
+#endif // STDSCHEDULER_USE_EPOLL
+
 #endif // STDSCHEDULER_USE_EVENTS
 
 int C4NetIOSimpleUDP::GetTimeout()
@@ -2478,6 +2757,12 @@ struct C4NetIOUDP::CheckPacketHdr : public PacketHdr
 	uint32_t AskCount, MCAskCount;
 };
 
+// appended after the ask list by peers that support selective acknowledgement (ignored by older ones)
+struct C4NetIOUDP::CheckSackExt
+{
+	uint64_t SackBits; // bit i: fragment AckNr + i was received
+};
+
 struct C4NetIOUDP::ClosePacket : public PacketHdr
 {
 	BinAddr Addr;
@@ -2747,6 +3032,10 @@ bool C4NetIOUDP::Execute(int iMaxTime) // (mt-safe)
 	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (!pPeer->Closed())
 			pPeer->CheckTimeout();
+	// acknowledgements and resends due?
+	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
+		if (pPeer->Open())
+			pPeer->CheckTimers();
 
 	// do a delayed loopback test once the incoming buffer is empty
 	if (fDelayedLoopbackTest)
@@ -2837,8 +3126,12 @@ int C4NetIOUDP::GetTimeout() // (mt-safe)
 	CStdShareLock PeerListLock(&PeerListCSec);
 	for (Peer *pPeer = pPeerList; pPeer; pPeer = pPeer->Next)
 		if (!pPeer->Closed())
+		{
 			if (pPeer->GetTimeout())
 				iTiming = (std::max)(std::min<int>(iTiming, int(pPeer->GetTimeout() - timeGetTime())), 0);
+			if (const unsigned int iTimer = pPeer->GetNextTimer())
+				iTiming = (std::max)(std::min<int>(iTiming, int(iTimer - timeGetTime())), 0);
+		}
 	// return timing value
 	return iTiming;
 }
@@ -3201,6 +3494,22 @@ void C4NetIOUDP::PacketList::Clear()
 const unsigned int C4NetIOUDP::Peer::iConnectRetries = 5;
 const unsigned int C4NetIOUDP::Peer::iReCheckInterval = 1000; // (ms)
 
+// Maximum time received data stays unacknowledged
+const unsigned int C4NetIOUDP::Peer::iAckDelay = 10; // (ms)
+
+// Resend timeout (adjusted to the measured round trip time)
+const unsigned int C4NetIOUDP::Peer::iInitialRTO = 300, // (ms)
+	C4NetIOUDP::Peer::iMinRTO = 40, // (ms)
+	C4NetIOUDP::Peer::iMaxRTO = 1000; // (ms)
+
+// Congestion window: maximum number of unacknowledged fragments
+const unsigned int C4NetIOUDP::Peer::iInitialCWnd = 32,
+	C4NetIOUDP::Peer::iMinCWnd = 16,
+	C4NetIOUDP::Peer::iMaxCWnd = 4096;
+
+// Fragments acknowledged after a missing one until it is resent without waiting for the timeout
+const unsigned int C4NetIOUDP::Peer::iFastResendThreshold = 3;
+
 // construction / destruction
 
 C4NetIOUDP::Peer::Peer(const addr_t &naddr, C4NetIOUDP *pnParent)
@@ -3213,6 +3522,10 @@ C4NetIOUDP::Peer::Peer(const addr_t &naddr, C4NetIOUDP *pnParent)
 	OPackets(iMaxOPacketBacklog),
 	iMCAckPacketCounter(0),
 	iNextReCheck(0),
+	iAckTime(0),
+	fSack(false), iOAckNr(0), iONextSend(0), iOInFlight(0), iOLostCnt(0),
+	iSRTT(-1), iRTTVar(0), iRTO(iInitialRTO),
+	iCWnd(iInitialCWnd), iSSThresh(iMaxCWnd), iCWndAcked(0), iRecoverNr(0),
 	iIRate(0), iORate(0), iLoss(0)
 {
 }
@@ -3227,6 +3540,10 @@ bool C4NetIOUDP::Peer::Connect(bool fFailCallback) // (mt-safe)
 {
 	// initiate connection (DoConn will set status CS_Conn)
 	fMultiCast = false; fConnFailCallback = fFailCallback;
+	// find out again whether the peer supports selective acknowledgement
+	CStdLock OutLock(&OutCSec);
+	ResetSack();
+	OutLock.Clear();
 	return DoConn(false);
 }
 
@@ -3244,6 +3561,16 @@ bool C4NetIOUDP::Peer::Send(const C4NetIOPacket &rPacket) // (mt-safe)
 	// It is not secure to send packets before the connection
 	// is etablished completly.
 	if (eStatus != CS_Works) return true;
+	// send as much as the congestion window allows
+	if (fSack)
+	{
+		if (!SendWindow())
+		{
+			Close("failed to send packet");
+			return false;
+		}
+		return true;
+	}
 	// send it
 	if (!SendDirect(*pnPacket))
 	{
@@ -3429,6 +3756,9 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 		// add the fragment
 		if (pPkt->AddFragment(rPacket, addr))
 		{
+			// acknowledge it soon
+			if (!fBroadcasted && !iAckTime)
+				iAckTime = timeGetTime() + iAckDelay;
 			// add the packet to list
 			if (fAddPacket) if (!pPacketList->AddPacket(pPkt)) { delete pPkt; break; }
 			// check for complete packets
@@ -3455,6 +3785,10 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 			iMCAckPacketCounter = pPkt->MCAckNr;
 			pParent->ClearMCPackets();
 		}
+		// selective acknowledgement?
+		const size_t iSackPos = sizeof(CheckPacketHdr) + (pPkt->AskCount + pPkt->MCAskCount) * sizeof(int);
+		if (!fBroadcasted && rPacket.getSize() == iSackPos + sizeof(CheckSackExt))
+			OnSack(pPkt->AckNr, rPacket.getPtr<CheckSackExt>(iSackPos)->SackBits);
 		OutLock.Clear();
 		// read ask list
 		const int *pAskList = rPacket.getPtr<int>(sizeof(CheckPacketHdr));
@@ -3471,7 +3805,10 @@ void C4NetIOUDP::Peer::OnRecv(const C4NetIOPacket &rPacket) // (mt-safe)
 			if (fMCPacket)
 				pParent->BroadcastDirect(*pPkt2Send, pAskList[i]);
 			else
+			{
 				SendDirect(*pPkt2Send, pAskList[i]);
+				OnResent(pAskList[i], timeGetTime());
+			}
 		}
 	}
 	break;
@@ -3553,7 +3890,10 @@ bool C4NetIOUDP::Peer::DoCheck(int iAskCnt, int iMCAskCnt, unsigned int *pAskLis
 	CheckPacketHdr *pChkPkt = Packet.getMPtr<CheckPacketHdr>();
 	// set up header
 	pChkPkt->StatusByte = IPID_Check; // (note: always du here, see C4NetIOUDP::DoCheck)
-	pChkPkt->Nr = iOPacketCounter;
+	// (fragments still waiting for the congestion window must not be asked for)
+	CStdLock OutLock(&OutCSec);
+	pChkPkt->Nr = fSack ? iONextSend : iOPacketCounter;
+	OutLock.Clear();
 	pChkPkt->AckNr = iIPacketCounter;
 	pChkPkt->MCAckNr = iIMCPacketCounter;
 	// copy ask list
@@ -3561,6 +3901,14 @@ bool C4NetIOUDP::Peer::DoCheck(int iAskCnt, int iMCAskCnt, unsigned int *pAskLis
 	pChkPkt->MCAskCount = iMCAskCnt;
 	if (pAskList)
 		Packet.Write(pAskList, iAskListSize, sizeof(CheckPacketHdr));
+	// selective acknowledgement: which of the following fragments are there?
+	CheckSackExt Sack{0};
+	for (unsigned int i = 0; i < 64; i++)
+		if (IPackets.FragmentPresent(iIPacketCounter + i))
+			Sack.SackBits |= uint64_t{1} << i;
+	Packet.Append(&Sack, sizeof(Sack));
+	// everything received is acknowledged now
+	iAckTime = 0;
 	// send packet
 	return SendDirect(C4NetIOPacket(Packet, addr));
 }
@@ -3588,6 +3936,200 @@ bool C4NetIOUDP::Peer::SendDirect(C4NetIOPacket &&rPacket) // (mt-safe)
 	return pParent->SendDirect(std::move(rPacket));
 }
 
+unsigned int C4NetIOUDP::Peer::GetNextTimer() // (mt-safe)
+{
+	// see CheckTimers
+	if (eStatus != CS_Works) return 0;
+	unsigned int iNext = iAckTime;
+	// resend timeouts
+	CStdLock OutLock(&OutCSec);
+	if (fSack)
+		for (const auto &Frag : OFragments)
+			if (!Frag.fAcked && !Frag.fLost && (!iNext || Frag.iSent + iRTO < iNext))
+				iNext = Frag.iSent + iRTO;
+	return iNext;
+}
+
+void C4NetIOUDP::Peer::CheckTimers()
+{
+	if (eStatus != CS_Works) return;
+	const unsigned int iNow = timeGetTime();
+	// acknowledge received data
+	if (iAckTime && iNow >= iAckTime)
+		Check(true);
+	// fragments that weren't acknowledged in time are lost
+	CStdLock OutLock(&OutCSec);
+	if (!fSack) return;
+	const unsigned int iTimeoutRTO = iRTO;
+	bool fTimeout = false;
+	for (size_t i = 0; i < OFragments.size(); i++)
+		if (!OFragments[i].fAcked && !OFragments[i].fLost && iNow - OFragments[i].iSent >= iTimeoutRTO)
+		{
+			if (!fTimeout) OnLoss(iOAckNr + i, true);
+			fTimeout = true;
+			MarkLost(OFragments[i]);
+		}
+	// resend them
+	if (fTimeout)
+		SendWindow();
+}
+
+void C4NetIOUDP::Peer::ResetSack()
+{
+	fSack = false;
+	OFragments.clear();
+	iOAckNr = iONextSend = iOPacketCounter; iOInFlight = iOLostCnt = 0;
+	iSRTT = -1; iRTTVar = 0; iRTO = iInitialRTO;
+	iCWnd = iInitialCWnd; iSSThresh = iMaxCWnd; iCWndAcked = 0; iRecoverNr = 0;
+	iAckTime = 0;
+}
+
+void C4NetIOUDP::Peer::OnSack(unsigned int iAckNr, uint64_t iSackBits)
+{
+	const unsigned int iNow = timeGetTime();
+	// first SACK information from this peer? Take over the fragments sent so far
+	if (!fSack)
+	{
+		fSack = true;
+		iONextSend = iOPacketCounter;
+		iOAckNr = std::min(iAckNr, iONextSend);
+		OFragments.assign(iONextSend - iOAckNr, OFragment{iNow, true, false, false});
+		iOInFlight = OFragments.size(); iOLostCnt = 0;
+	}
+	// cumulative acknowledgement
+	while (iOAckNr < iAckNr && !OFragments.empty())
+	{
+		AckFragment(OFragments.front(), iNow);
+		OFragments.pop_front();
+		iOAckNr++;
+	}
+	// peer got fragments that weren't sent yet? (asked for them before it knew about the window)
+	if (iOAckNr < iAckNr && iAckNr <= iOPacketCounter)
+		iOAckNr = iONextSend = iAckNr;
+	// selective acknowledgement
+	for (unsigned int i = 0; i < 64; i++)
+		if (iSackBits & (uint64_t{1} << i))
+		{
+			const unsigned int iNr = iAckNr + i;
+			if (iNr >= iOAckNr && iNr - iOAckNr < OFragments.size())
+				AckFragment(OFragments[iNr - iOAckNr], iNow);
+		}
+	// fragments overtaken by others are lost (check at most once per round trip)
+	const unsigned int iResendGuard = iSRTT >= 0 ? std::max<unsigned int>(iSRTT, iAckDelay) : iRTO;
+	unsigned int iAckedAfter = 0;
+	for (size_t i = OFragments.size(); i-- > 0; )
+		if (OFragments[i].fAcked)
+			iAckedAfter++;
+		else if (!OFragments[i].fLost && iAckedAfter >= iFastResendThreshold && iNow - OFragments[i].iSent > iResendGuard)
+		{
+			OnLoss(iOAckNr + i, false);
+			MarkLost(OFragments[i]);
+		}
+	// resend lost fragments and send new ones as far as the window allows
+	SendWindow();
+}
+
+void C4NetIOUDP::Peer::AckFragment(OFragment &Frag, unsigned int iNow)
+{
+	if (Frag.fAcked) return;
+	Frag.fAcked = true;
+	if (Frag.fLost)
+	{
+		// arrived after all
+		Frag.fLost = false; iOLostCnt--;
+		return;
+	}
+	iOInFlight--;
+	// update round trip time estimation (see RFC 6298)
+	if (!Frag.fResent)
+	{
+		const int iRTT = iNow - Frag.iSent;
+		if (iSRTT < 0)
+		{
+			iSRTT = iRTT; iRTTVar = iRTT / 2;
+		}
+		else
+		{
+			iRTTVar = (3 * iRTTVar + std::abs(iSRTT - iRTT)) / 4;
+			iSRTT = (7 * iSRTT + iRTT) / 8;
+		}
+		iRTO = BoundBy<unsigned int>(iSRTT + std::max<int>(4 * iRTTVar, iAckDelay), iMinRTO, iMaxRTO);
+	}
+	// grow window: exponentially until the threshold, then by one fragment per window
+	if (iCWnd < iSSThresh)
+		iCWnd++;
+	else if (++iCWndAcked >= iCWnd)
+	{
+		iCWnd++; iCWndAcked = 0;
+	}
+	iCWnd = std::min(iCWnd, iMaxCWnd);
+}
+
+void C4NetIOUDP::Peer::MarkLost(OFragment &Frag)
+{
+	if (Frag.fAcked || Frag.fLost) return;
+	Frag.fLost = true; iOLostCnt++;
+	// not in flight anymore, so the window has room to resend it
+	iOInFlight--;
+}
+
+void C4NetIOUDP::Peer::OnResent(unsigned int iNr, unsigned int iNow)
+{
+	if (!fSack || iNr < iOAckNr || iNr - iOAckNr >= OFragments.size()) return;
+	OFragment &Frag = OFragments[iNr - iOAckNr];
+	Frag.iSent = iNow; Frag.fResent = true;
+	if (Frag.fLost)
+	{
+		Frag.fLost = false; iOLostCnt--;
+		iOInFlight++;
+	}
+}
+
+void C4NetIOUDP::Peer::OnLoss(unsigned int iNr, bool fTimeout)
+{
+	if (fTimeout)
+	{
+		// back off, then grow the window again from the minimum
+		// (which is big enough that control packets don't pile up behind it)
+		iRTO = std::min(iRTO * 2, iMaxRTO);
+		iSSThresh = std::max(std::min(iOInFlight, iCWnd) / 2, iMinCWnd);
+		iCWnd = iMinCWnd; iCWndAcked = 0;
+		iRecoverNr = iONextSend;
+	}
+	// halve window (once for all fragments lost in the same round trip)
+	else if (iNr >= iRecoverNr)
+	{
+		iSSThresh = iCWnd = std::max(std::min(iOInFlight, iCWnd) / 2, iMinCWnd); iCWndAcked = 0;
+		iRecoverNr = iONextSend;
+	}
+}
+
+bool C4NetIOUDP::Peer::SendWindow()
+{
+	const unsigned int iNow = timeGetTime();
+	// lost fragments first
+	for (size_t i = 0; iOLostCnt && iOInFlight < iCWnd && i < OFragments.size(); i++)
+		if (OFragments[i].fLost)
+		{
+			Packet *pPkt = OPackets.GetPacketFrgm(iOAckNr + i);
+			if (!pPkt) { Close("starvation"); return false; }
+			OnResent(iOAckNr + i, iNow);
+			if (!SendDirect(*pPkt, iOAckNr + i))
+				return false;
+		}
+	// then new ones
+	while (iONextSend < iOPacketCounter && iOInFlight < iCWnd)
+	{
+		Packet *pPkt = OPackets.GetPacketFrgm(iONextSend);
+		if (!pPkt) { Close("starvation"); return false; }
+		if (!SendDirect(*pPkt, iONextSend))
+			return false;
+		OFragments.push_back(OFragment{iNow, false, false, false});
+		iONextSend++; iOInFlight++;
+	}
+	return true;
+}
+
 void C4NetIOUDP::Peer::OnConn()
 {
 	// reset timeout
@@ -3603,6 +4145,9 @@ void C4NetIOUDP::Peer::OnConn()
 	}
 	// do packet callback (in case the peer sent data while the connection was in progress)
 	CheckCompleteIPackets();
+	// tell the peer early that selective acknowledgement is supported
+	if (eStatus == CS_Works)
+		DoCheck();
 }
 
 void C4NetIOUDP::Peer::OnClose(const char *szReason) // (mt-safe)
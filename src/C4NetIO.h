@@ -25,6 +25,7 @@
 #include "StdCompiler.h"
 #include "StdScheduler.h"
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -366,6 +367,8 @@ public:
 	virtual void UnBlock();
 #ifdef STDSCHEDULER_USE_EVENTS
 	virtual HANDLE GetEvent() override;
+#elif defined(STDSCHEDULER_USE_EPOLL)
+	virtual int GetFD() override;
 #else
 	virtual void GetFDs(fd_set *pSet, int *pMaxFD) override;
 #endif
@@ -414,6 +417,12 @@ protected:
 		bool fOpen;
 		// selected for broadcast?
 		bool fDoBroadcast;
+		// unpacking IBuf? (packets reference it, so Close must not clear it)
+		bool fUnpacking;
+#ifdef STDSCHEDULER_USE_EPOLL
+		// socket registered for writeability?
+		bool fWatchWrite;
+#endif
 		// IO critical sections
 		CStdCSec ICSec; CStdCSec OCSec;
 
@@ -443,6 +452,10 @@ protected:
 		void SetBroadcast(bool fSet) { fDoBroadcast = fSet; }
 		// statistics
 		void ClearStatistics();
+#ifdef STDSCHEDULER_USE_EPOLL
+		// (un)register the socket for writeability
+		void WatchWrite(bool fWatch);
+#endif
 
 	public:
 		// next peer
@@ -482,14 +495,27 @@ protected:
 	int Pipe[2];
 #endif
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// epoll set of the pipe, the listen socket, connect waits and peers.
+	// Event data points to the pipe, the listen socket, the ConnectWait or the Peer, respectively.
+	int EPollFD;
+#endif
+
 	// *** implementation
 
 	bool Listen(uint16_t inListenPort);
+#ifdef STDSCHEDULER_USE_EPOLL
+	bool EPollCtl(int iOp, SOCKET nsock, uint32_t iEvents, void *pData);
+#endif
 
 	SOCKET CreateSocket(addr_t::AddressFamily family);
 	bool Connect(const addr_t &addr, SOCKET nsock);
 
 	Peer *Accept(SOCKET nsock = INVALID_SOCKET, const addr_t &ConnectAddr = addr_t());
+#ifndef STDSCHEDULER_USE_EVENTS
+	bool OnConnectWaitWriteable(ConnectWait *pWait);
+#endif
+	void ReadPeer(Peer *pPeer);
 	Peer *GetPeer(const addr_t &addr);
 	void OnShareFree(CStdCSecEx *pCSec) override;
 
@@ -529,6 +555,8 @@ public:
 	virtual void UnBlock();
 #ifdef STDSCHEDULER_USE_EVENTS
 	virtual HANDLE GetEvent() override;
+#elif defined(STDSCHEDULER_USE_EPOLL)
+	virtual int GetFD() override;
 #else
 	virtual void GetFDs(fd_set *pSet, int *pMaxFD) override;
 #endif
@@ -562,6 +590,10 @@ private:
 #else
 	int Pipe[2];
 #endif
+#ifdef STDSCHEDULER_USE_EPOLL
+	// epoll set of the pipe and the socket
+	int EPollFD;
+#endif
 
 	// multicast
 	addr_t MCAddr; ipv6_mreq MCGrpInfo;
@@ -570,6 +602,9 @@ private:
 	// multibind
 	int fAllowReUse;
 
+	// receive buffer
+	StdBuf RecvBuf;
+
 protected:
 	// multicast address
 	const addr_t &getMCAddr() const { return MCAddr; }
@@ -647,7 +682,7 @@ protected:
 	// packet structures
 	struct BinAddr;
 	struct PacketHdr; struct TestPacket; struct ConnPacket; struct ConnOKPacket; struct AddAddrPacket;
-	struct DataPacketHdr; struct CheckPacketHdr; struct ClosePacket;
+	struct DataPacketHdr; struct CheckPacketHdr; struct CheckSackExt; struct ClosePacket;
 
 	// constants
 	static const unsigned int iVersion; // = 2;
@@ -746,6 +781,10 @@ protected:
 		// constants
 		static const unsigned int iConnectRetries; // = 5
 		static const unsigned int iReCheckInterval; // = 1000 (ms)
+		static const unsigned int iAckDelay; // = 10 (ms)
+		static const unsigned int iInitialRTO, iMinRTO, iMaxRTO; // = 300, 40, 1000 (ms)
+		static const unsigned int iInitialCWnd, iMinCWnd, iMaxCWnd; // = 32, 16, 4096 (fragments)
+		static const unsigned int iFastResendThreshold; // = 3 (fragments)
 
 		// parent class
 		C4NetIOUDP *const pParent;
@@ -791,6 +830,30 @@ protected:
 		unsigned int iTimeout;
 		unsigned int iRetries;
 
+		// delayed acknowledgement of received data (0 = nothing to acknowledge)
+		unsigned int iAckTime;
+
+		// selective acknowledgement: only used once the peer has sent SACK information,
+		// older peers get all packets sent immediately and ask for lost fragments
+		bool fSack;
+		struct OFragment
+		{
+			unsigned int iSent; // time of last transmission
+			bool fResent; // no round trip time samples from resent fragments
+			bool fAcked;
+			bool fLost; // to be resent as soon as the window allows
+		};
+		std::deque<OFragment> OFragments; // fragments iOAckNr to iONextSend - 1 (guarded by OutCSec)
+		unsigned int iOAckNr, iONextSend, iOInFlight, iOLostCnt;
+
+		// round trip time estimation (ms)
+		int iSRTT, iRTTVar;
+		unsigned int iRTO;
+
+		// congestion window (fragments)
+		unsigned int iCWnd, iSSThresh, iCWndAcked;
+		unsigned int iRecoverNr; // window was already reduced for losses before this fragment
+
 		// statistics
 		int iIRate, iORate, iLoss;
 		CStdCSec StatCSec;
@@ -827,6 +890,10 @@ protected:
 		int GetTimeout() { return iTimeout; }
 		void CheckTimeout();
 
+		// delayed acknowledgement and resend timers
+		unsigned int GetNextTimer(); // 0 = no timer
+		void CheckTimers();
+
 		// selected for broadcast?
 		bool doBroadcast() const { return fDoBroadcast; }
 		// select/unselect peer
@@ -849,6 +916,15 @@ protected:
 		bool SendDirect(const Packet &rPacket, unsigned int iNr = ~0);
 		bool SendDirect(C4NetIOPacket &&rPacket);
 
+		// selective acknowledgement (call with OutCSec locked)
+		void ResetSack();
+		void OnSack(unsigned int iAckNr, uint64_t iSackBits);
+		void AckFragment(OFragment &Frag, unsigned int iNow);
+		void MarkLost(OFragment &Frag);
+		void OnResent(unsigned int iNr, unsigned int iNow);
+		void OnLoss(unsigned int iNr, bool fTimeout);
+		bool SendWindow();
+
 		// events
 		void OnConn();
 		void OnClose(const char *szReason);
@@ -37,7 +37,7 @@ C4Network2Client::C4Network2Client(C4Client *pClient)
 	iLastActivity(0),
 	pMsgConn(nullptr), pDataConn(nullptr),
 	iNextConnAttempt(0),
-	pNext(nullptr), pParent(nullptr), pstatPing(nullptr) {}
+	pNext(nullptr), pParent(nullptr), pstatPing(nullptr), pstatResTransfer(nullptr) {}
 
 C4Network2Client::~C4Network2Client()
 {
@@ -328,8 +328,15 @@ void C4Network2Client::CreateGraphs()
 	pstatPing = new C4TableGraph(C4TableGraph::DefaultBlockLength, Game.pNetworkStatistics ? Game.pNetworkStatistics->SecondCounter : 0);
 	pstatPing->SetColorDw(dwClientClr);
 	pstatPing->SetTitle(getName());
+	pstatResTransfer = new C4TableGraph(C4TableGraph::DefaultBlockLength, Game.pNetworkStatistics ? Game.pNetworkStatistics->SecondCounter : 0);
+	pstatResTransfer->SetColorDw(dwClientClr);
+	pstatResTransfer->SetTitle(getName());
 	// register into stat module
-	if (Game.pNetworkStatistics) Game.pNetworkStatistics->statPings.AddGraph(pstatPing);
+	if (Game.pNetworkStatistics)
+	{
+		Game.pNetworkStatistics->statPings.AddGraph(pstatPing);
+		Game.pNetworkStatistics->statResTransfer.AddGraph(pstatResTransfer);
+	}
 }
 
 void C4Network2Client::ClearGraphs()
@@ -339,8 +346,14 @@ void C4Network2Client::ClearGraphs()
 	{
 		Game.pNetworkStatistics->statPings.RemoveGraph(pstatPing);
 	}
+	if (pstatResTransfer && Game.pNetworkStatistics)
+	{
+		Game.pNetworkStatistics->statResTransfer.RemoveGraph(pstatResTransfer);
+	}
 	delete pstatPing;
 	pstatPing = nullptr;
+	delete pstatResTransfer;
+	pstatResTransfer = nullptr;
 }
 
 // *** C4Network2ClientList
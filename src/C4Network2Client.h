@@ -83,6 +83,7 @@ protected:
 
 	// statistics
 	class C4TableGraph *pstatPing;
+	class C4TableGraph *pstatResTransfer; // ressource data received from this client
 
 public:
 	C4Client           *getClient()   const { return pClient; }
@@ -110,6 +111,7 @@ public:
 	time_t              getNextConnAttempt() const { return iNextConnAttempt; }
 	int32_t             getLastActivity()    const { return iLastActivity; }
 	class C4TableGraph *getStatPing()        const { return pstatPing; }
+	class C4TableGraph *getStatResTransfer() const { return pstatResTransfer; }
 
 	C4Network2Client *getNext() const { return pNext; }
 
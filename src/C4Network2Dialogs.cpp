@@ -974,7 +974,10 @@ C4ChartDialog::C4ChartDialog() : Dialog(DialogWidth, DialogHeight, LoadResStr("I
 	AddChart(StdStrBuf("FPS"));
 	AddChart(StdStrBuf("NetIO"));
 	if (Game.Network.isEnabled())
+	{
 		AddChart(StdStrBuf("Pings"));
+		AddChart(StdStrBuf("Transfer"));
+	}
 	AddChart(StdStrBuf("Control"));
 	AddChart(StdStrBuf("APM"));
 
@@ -32,6 +32,9 @@
 #endif
 
 #include <cassert>
+#include <chrono>
+
+#include <zlib.h>
 
 // internal structures
 struct C4Network2IO::NetEvPacketData
@@ -55,7 +58,8 @@ C4Network2IO::C4Network2IO()
 	pAutoAcceptList(nullptr),
 	iLastPing(0), iLastExecute(0), iLastStatistic(0),
 	iTCPIRate(0), iTCPORate(0), iTCPBCRate(0),
-	iUDPIRate(0), iUDPORate(0), iUDPBCRate(0)
+	iUDPIRate(0), iUDPORate(0), iUDPBCRate(0),
+	iCompressionSavedRate(0), iCompressionTimeRate(0)
 {
 }
 
@@ -567,10 +571,27 @@ void C4Network2IO::OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO)
 	if (timeGetTime() - iTime > 100)
 		Application.InteractiveThread.ThreadLogSF("OnPacket: ... blocked %d ms for finding the connection!", timeGetTime() - iTime);
 #endif
+	// unpack compressed packet
+	C4NetIOPacket Decompressed;
+	if (rPacket.getStatus() == PID_Compressed)
+	{
+		// only from identified peers that were told they may compress, so nobody else can make us allocate
+		if (!pConn->isHalfAccepted() || !pConn->isCompressing())
+		{
+			Application.InteractiveThread.ThreadLogF("Network: unexpected compressed %s packet from %s!", getNetIOName(pNetIO), rPacket.getAddr().ToString().getData());
+			return;
+		}
+		if (!pConn->Decompress(rPacket, Decompressed))
+		{
+			Application.InteractiveThread.ThreadLogF("Network: could not decompress %s packet from %s!", getNetIOName(pNetIO), rPacket.getAddr().ToString().getData());
+			return;
+		}
+	}
+	const C4NetIOPacket &Packet = Decompressed.getSize() ? Decompressed : rPacket;
 	// notify
-	pConn->OnPacketReceived(rPacket.getStatus());
+	pConn->OnPacketReceived(Packet.getStatus());
 	// handle packet
-	HandlePacket(rPacket, pConn, true);
+	HandlePacket(Packet, pConn, true);
 	// log time
 #if (C4NET2IO_DUMP_LEVEL > 1)
 	if (timeGetTime() - iTime > 100)
@@ -794,42 +815,56 @@ bool C4Network2IO::HandlePacket(const C4NetIOPacket &rPacket, C4Network2IOConnec
 			return false;
 		}
 
+	// search packet handling data: packets that are only handled in the other thread don't need to be unpacked here
+	bool fHandleHere = false, fSendToMainThread = false;
+	for (const C4PktHandlingData *pHData = PktHandlingData; pHData->ID != PID_None; pHData++)
+		if (pHData->ID == rPacket.getStatus())
+		{
+			// correct thread?
+			if (!pHData->ProcByThread == !fThread)
+				fHandleHere = true;
+			// transfer to main thread?
+			else if (!pHData->ProcByThread && fThread)
+				fSendToMainThread = true;
+		}
+	bool fHandled = fSendToMainThread;
+
 	// unpack packet (yet another no-idea-why-it's-needed-cast)
+	// (unknown packets are unpacked anyway, so they fail like before)
 	C4IDPacket Pkt; C4PacketBase &PktB = Pkt;
-	try
-	{
-		PktB.unpack(rPacket);
-	}
-	catch (const StdCompiler::Exception &e)
+	if (fHandleHere || !fSendToMainThread)
 	{
-		Application.InteractiveThread.ThreadLogF("Network: error: Failed to unpack packet id %02x: %s", rPacket.getStatus(), e.Msg.getData());
+		try
+		{
+			PktB.unpack(rPacket);
+		}
+		catch (const StdCompiler::Exception &e)
+		{
+			Application.InteractiveThread.ThreadLogF("Network: error: Failed to unpack packet id %02x: %s", rPacket.getStatus(), e.Msg.getData());
 #ifndef _DEBUG
-		pConn->Close();
+			pConn->Close();
 #endif
-		return false;
-	}
+			pConn->DelRef();
+			return false;
+		}
 
-	// dump packet (network thread only)
+		// dump packet (network thread only)
 #if (C4NET2IO_DUMP_LEVEL > 0)
-	if (fThread && Pkt.getPktType() != PID_Ping && Pkt.getPktType() != PID_Pong && Pkt.getPktType() != PID_NetResData)
-	{
-		unsigned int iTime = timeGetTime();
-		StdStrBuf PacketHeader = FormatString("HandlePacket: %d:%02d:%02d:%03d by %s (%zu bytes, counter %d)",
-			(iTime / 1000 / 60 / 60), (iTime / 1000 / 60) % 60, (iTime / 1000) % 60, iTime % 1000,
-			pConn->getPeerAddr().ToString().getData(),
-			rPacket.getSize(), pConn->getInPacketCounter());
-		StdStrBuf Dump = DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(Pkt, PacketHeader.getData()));
-		Application.InteractiveThread.ThreadLogS(Dump.getData());
-	}
+		if (fThread && Pkt.getPktType() != PID_Ping && Pkt.getPktType() != PID_Pong && Pkt.getPktType() != PID_NetResData)
+		{
+			unsigned int iTime = timeGetTime();
+			StdStrBuf PacketHeader = FormatString("HandlePacket: %d:%02d:%02d:%03d by %s (%zu bytes, counter %d)",
+				(iTime / 1000 / 60 / 60), (iTime / 1000 / 60) % 60, (iTime / 1000) % 60, iTime % 1000,
+				pConn->getPeerAddr().ToString().getData(),
+				rPacket.getSize(), pConn->getInPacketCounter());
+			StdStrBuf Dump = DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(Pkt, PacketHeader.getData()));
+			Application.InteractiveThread.ThreadLogS(Dump.getData());
+		}
 #endif
 
-	// search packet handling data
-	bool fSendToMainThread = false, fHandled = false;
-	for (const C4PktHandlingData *pHData = PktHandlingData; pHData->ID != PID_None; pHData++)
-		if (pHData->ID == rPacket.getStatus())
-			// correct thread?
-			if (!pHData->ProcByThread == !fThread)
-			{
+		// call handler(s)
+		for (const C4PktHandlingData *pHData = PktHandlingData; pHData->ID != PID_None; pHData++)
+			if (pHData->ID == rPacket.getStatus() && !pHData->ProcByThread == !fThread)
 				// connection accepted?
 				if (pHData->AcceptedOnly || pConn->isAccepted() || pConn->isClosed())
 				{
@@ -838,7 +873,6 @@ bool C4Network2IO::HandlePacket(const C4NetIOPacket &rPacket, C4Network2IOConnec
 					unsigned int iStart = timeGetTime();
 #endif
 
-					// call handler(s)
 					CallHandlers(pHData->HandlerID, &Pkt, pConn, fThread);
 
 #if (C4NET2IO_DUMP_LEVEL > 2)
@@ -846,13 +880,7 @@ bool C4Network2IO::HandlePacket(const C4NetIOPacket &rPacket, C4Network2IOConnec
 						Application.InteractiveThread.ThreadLogSF("HandlePacket: ... blocked for %d ms!", timeGetTime() - iStart);
 #endif
 				}
-			}
-	// transfer to main thread?
-			else if (!pHData->ProcByThread && fThread)
-			{
-				fHandled = true;
-				fSendToMainThread = true;
-			}
+	}
 
 	// send to main thread?
 	if (fSendToMainThread)
@@ -941,6 +969,8 @@ void C4Network2IO::HandlePacket(char cStatus, const C4PacketBase *pPacket, C4Net
 		GETPKT(C4PacketConn, rPkt);
 		// set connection ID
 		pConn->SetRemoteID(rPkt.getConnID());
+		// compress packets from now on?
+		pConn->SetCompression(Config.Network.PacketCompression && rPkt.getCompression() >= C4NetCompressionVersion);
 		// check auto-accept
 		if (doAutoAccept(rPkt.getCCore(), *pConn))
 		{
@@ -1168,6 +1198,9 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 			pConn->DoStatistics(iInterval, fTCP ? &iTCPIRateSum : &iUDPIRateSum,
 				fTCP ? &iTCPORateSum : &iUDPORateSum);
 		}
+	int iCompressionSavedSum = 0, iCompressionTimeSum = 0;
+	for (C4Network2IOConnection *pConn = pConnList; pConn; pConn = pConn->pNext)
+		pConn->DoCompressionStatistics(&iCompressionSavedSum, &iCompressionTimeSum);
 	ConnListLock.Clear();
 
 	// get broadcast statistics
@@ -1182,6 +1215,8 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 	iUDPORateSum = iUDPORateSum * 1000 / iInterval;
 	inTCPBCRate = inTCPBCRate * 1000 / iInterval;
 	inUDPBCRate = inUDPBCRate * 1000 / iInterval;
+	iCompressionSavedSum = iCompressionSavedSum * 1000 / iInterval;
+	iCompressionTimeSum = iCompressionTimeSum * 1000 / iInterval;
 
 	// clear
 	if (pNetIO_TCP) pNetIO_TCP->ClearStatistic();
@@ -1190,6 +1225,7 @@ void C4Network2IO::GenerateStatistics(int iInterval)
 	// save back
 	iTCPIRate = iTCPIRateSum; iTCPORate = iTCPORateSum; iTCPBCRate = inTCPBCRate;
 	iUDPIRate = iUDPIRateSum; iUDPORate = iUDPORateSum; iUDPBCRate = inUDPBCRate;
+	iCompressionSavedRate = iCompressionSavedSum; iCompressionTimeRate = iCompressionTimeSum;
 }
 
 void C4Network2IO::SendConnPackets()
@@ -1241,7 +1277,9 @@ C4Network2IOConnection::C4Network2IOConnection()
 	pNext(nullptr),
 	iRefCnt(0),
 	fConnSent(false),
-	fPostMortemSent(false) {}
+	fPostMortemSent(false),
+	fCompression(false),
+	iCompressionSaved(0), iCompressionTime(0) {}
 
 C4Network2IOConnection::~C4Network2IOConnection()
 {
@@ -1414,7 +1452,7 @@ bool C4Network2IOConnection::Send(const C4NetIOPacket &rPkt)
 		assert(isOpen());
 		C4NetIOPacket Copy(rPkt);
 		Copy.SetAddr(PeerAddr);
-		return pNetClass->Send(Copy);
+		return SendPacket(Copy);
 	}
 	CStdLock PacketLogLock(&PacketLogCSec);
 	// create log entry
@@ -1434,12 +1472,63 @@ bool C4Network2IOConnection::Send(const C4NetIOPacket &rPkt)
 		return true;
 	}
 	// send
-	bool fSuccess = pNetClass->Send(pLogEntry->Pkt);
+	bool fSuccess = SendPacket(pLogEntry->Pkt);
 	if (fSuccess)
 		assert(!fPostMortemSent);
 	return fSuccess;
 }
 
+// compressed packets: PID_Compressed, original status, payload size (uint32_t), deflated payload
+
+bool C4Network2IOConnection::SendPacket(const C4NetIOPacket &rPkt)
+{
+	// peer doesn't understand compressed packets or not worth it?
+	// (handshake packets are never compressed: the peer only accepts compressed packets once it has accepted us)
+	if (!fCompression || !Inside<size_t>(rPkt.getPSize(), C4NetCompressionMinSize, C4NetCompressionMaxSize) ||
+		rPkt.getStatus() == PID_Conn || rPkt.getStatus() == PID_ConnRe || rPkt.getStatus() == PID_Ping)
+		return pNetClass->Send(rPkt);
+	const auto Start = std::chrono::steady_clock::now();
+	// compress (fast, as resource chunks are mostly compressed already)
+	const size_t iHeaderSize = 2 + sizeof(uint32_t);
+	uLongf iCompressedSize = compressBound(rPkt.getPSize());
+	C4NetIOPacket Compressed;
+	Compressed.New(iHeaderSize + iCompressedSize);
+	const bool fCompressed = compress2(Compressed.getMPtr<Bytef>(iHeaderSize), &iCompressedSize, reinterpret_cast<const Bytef *>(rPkt.getPData()), rPkt.getPSize(), Z_BEST_SPEED) == Z_OK;
+	iCompressionTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+	// no gain? send original
+	if (!fCompressed || iHeaderSize + iCompressedSize >= rPkt.getSize())
+		return pNetClass->Send(rPkt);
+	// write header
+	const uint32_t iSize = rPkt.getPSize();
+	*Compressed.getMPtr<uint8_t>(0) = PID_Compressed;
+	*Compressed.getMPtr<uint8_t>(1) = rPkt.getStatus();
+	Compressed.Write(&iSize, sizeof(iSize), 2);
+	Compressed.SetSize(iHeaderSize + iCompressedSize);
+	Compressed.SetAddr(rPkt.getAddr());
+	iCompressionSaved += rPkt.getSize() - Compressed.getSize();
+	return pNetClass->Send(Compressed);
+}
+
+bool C4Network2IOConnection::Decompress(const C4NetIOPacket &rPkt, C4NetIOPacket &rOut)
+{
+	const size_t iHeaderSize = 2 + sizeof(uint32_t);
+	if (rPkt.getSize() < iHeaderSize) return false;
+	uint32_t iSize;
+	memcpy(&iSize, rPkt.getPtr(2), sizeof(iSize));
+	if (iSize > C4NetCompressionMaxSize) return false;
+	const auto Start = std::chrono::steady_clock::now();
+	// status byte, then payload
+	rOut.New(1 + iSize);
+	*rOut.getMPtr<uint8_t>(0) = *rPkt.getPtr<uint8_t>(1);
+	uLongf iDecompressedSize = iSize;
+	const bool fSuccess = uncompress(rOut.getMPtr<Bytef>(1), &iDecompressedSize, rPkt.getPtr<Bytef>(iHeaderSize), rPkt.getSize() - iHeaderSize) == Z_OK && iDecompressedSize == iSize;
+	iCompressionTime += std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count();
+	if (!fSuccess) return false;
+	rOut.SetAddr(rPkt.getAddr());
+	iCompressionSaved += rOut.getSize() - rPkt.getSize();
+	return true;
+}
+
 void C4Network2IOConnection::SetBroadcastTarget(bool fSet)
 {
 	// Note that each thread will have to make sure that this flag won't be
@@ -1467,6 +1556,13 @@ void C4Network2IOConnection::DoStatistics(int iInterval, int *pIRateSum, int *pO
 	if (pORateSum) *pORateSum += iORate;
 }
 
+void C4Network2IOConnection::DoCompressionStatistics(int *pSavedSum, int *pTimeSum)
+{
+	// collect and reset
+	*pSavedSum += iCompressionSaved.exchange(0);
+	*pTimeSum += iCompressionTime.exchange(0);
+}
+
 void C4Network2IOConnection::AddRef()
 {
 	++iRefCnt;
@@ -1572,13 +1668,14 @@ void C4PacketPostMortem::CompileFunc(StdCompiler *pComp)
 // *** C4PacketConn
 
 C4PacketConn::C4PacketConn()
-	: iVer(C4XVERBUILD) {}
+	: iVer(C4XVERBUILD), iCompression(0) {}
 
 C4PacketConn::C4PacketConn(const C4ClientCore &nCCore, uint32_t inConnID, const char *szPassword)
 	: iVer(C4XVERBUILD),
 	iConnID(inConnID),
 	CCore(nCCore),
-	Password(szPassword) {}
+	Password(szPassword),
+	iCompression(Config.Network.PacketCompression ? C4NetCompressionVersion : 0) {}
 
 void C4PacketConn::CompileFunc(StdCompiler *pComp)
 {
@@ -1586,6 +1683,15 @@ void C4PacketConn::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iVer),    "Version",  -1));
 	pComp->Value(mkNamingAdapt(Password,                "Password", ""));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iConnID), "ConnID",   ~0u));
+	// (not sent by older versions)
+	try
+	{
+		pComp->Value(mkNamingAdapt(mkIntPackAdapt(iCompression), "Compression", 0));
+	}
+	catch (const StdCompiler::EOFException &)
+	{
+		iCompression = 0;
+	}
 }
 
 // *** C4PacketConnRe
@@ -1640,7 +1746,7 @@ void C4PacketFwd::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(fNegativeList,                                                  "Negative",  false));
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iClientCnt),                                     "ClientCnt", 0));
 	pComp->Value(mkNamingAdapt(mkArrayAdaptMap(iClients, iClientCnt, mkIntPackAdapt<int32_t>), "Clients",   -1));
-	pComp->Value(mkNamingAdapt(Data,                                                           "Data"));
+	pComp->Value(mkNamingAdapt(mkBufRefAdapt(Data),                                            "Data"));
 }
 
 // *** C4PacketJoinData
@@ -1730,6 +1836,17 @@ void C4PacketResRequest::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(mkIntPackAdapt(iReqChunk), "Chunk", -1));
 }
 
+// *** C4PacketResDelta
+
+C4PacketResDelta::C4PacketResDelta(int32_t iResID, const std::vector<C4Network2ResDeltaChunk> &nChunks)
+	: iResID(iResID), Chunks(nChunks) {}
+
+void C4PacketResDelta::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(iResID,                       "ResID", -1));
+	pComp->Value(mkNamingAdapt(mkSTLContainerAdapt(Chunks), "Chunks"));
+}
+
 // *** C4PacketControlReq
 
 C4PacketControlReq::C4PacketControlReq(int32_t inCtrlTick)
@@ -39,6 +39,11 @@ const int C4NetTimer = 500, // ms
           C4NetAcceptTimeout = 10, // s
           C4NetPingTimeout = 30000; // ms
 
+// packet compression
+const int32_t C4NetCompressionVersion = 1; // per-packet deflate
+const size_t C4NetCompressionMinSize = 64, // (bytes) smaller packets are sent as they are
+             C4NetCompressionMaxSize = 16 * 1024 * 1024; // (bytes) larger packets are neither compressed nor accepted compressed
+
 // client count
 const int C4NetMaxClients = 256;
 
@@ -94,6 +99,7 @@ protected:
 	unsigned long iLastStatistic;
 	int iTCPIRate, iTCPORate, iTCPBCRate,
 		iUDPIRate, iUDPORate, iUDPBCRate;
+	int iCompressionSavedRate, iCompressionTimeRate; // bytes/s, us/s
 
 	// punching
 	C4NetIO::addr_t PuncherAddrIPv4, PuncherAddrIPv6;
@@ -148,6 +154,8 @@ public:
 	int getProtIRate (C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPIRate  : iUDPIRate; }
 	int getProtORate (C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPORate  : iUDPORate; }
 	int getProtBCRate(C4Network2IOProtocol eProt) const { return eProt == P_TCP ? iTCPBCRate : iUDPBCRate; }
+	int getCompressionSavedRate() const { return iCompressionSavedRate; } // bytes not sent or received per second
+	int getCompressionTimeRate() const { return iCompressionTimeRate; } // microseconds spent (de)compressing per second
 
 	// reference
 	void SetReference(class C4Network2Reference *pReference);
@@ -237,6 +245,8 @@ protected:
 	StdStrBuf Password; // password to use for connect
 	bool fConnSent; // initial connection packet send
 	bool fPostMortemSent; // post mortem send
+	bool fCompression; // peer accepts compressed packets
+	std::atomic<int> iCompressionSaved, iCompressionTime; // (bytes, us) since last statistics
 
 	// packet backlog
 	uint32_t iOutPacketCounter, iInPacketCounter;
@@ -270,6 +280,7 @@ public:
 	int                    getPacketLoss()  const { return iPacketLoss; }
 	const char            *getPassword()    const { return Password.getData(); }
 	bool                   isConnSent()     const { return fConnSent; }
+	bool                   isCompressing()  const { return fCompression; }
 
 	uint32_t getInPacketCounter()  const { return iInPacketCounter; }
 	uint32_t getOutPacketCounter() const { return iOutPacketCounter; }
@@ -295,6 +306,9 @@ protected:
 	void SetAutoAccepted();
 	void OnPacketReceived(uint8_t iPacketType);
 	void ClearPacketLog(uint32_t iStartNumber = ~0);
+	void SetCompression(bool fCompression) { this->fCompression = fCompression; }
+	bool Decompress(const C4NetIOPacket &rPkt, C4NetIOPacket &rOut);
+	bool SendPacket(const C4NetIOPacket &rPkt);
 
 public:
 	// status changing
@@ -312,6 +326,7 @@ public:
 
 	// statistics
 	void DoStatistics(int iInterval, int *pIRateSum, int *pORateSum);
+	void DoCompressionStatistics(int *pSavedSum, int *pTimeSum);
 
 	// reference counting
 	void AddRef(); void DelRef();
@@ -349,10 +364,12 @@ protected:
 	uint32_t iConnID;
 	C4ClientCore CCore;
 	StdStrBuf Password;
+	int32_t iCompression; // supported compression version (0 = none)
 
 public:
 	int32_t getVer()               const { return iVer; }
 	uint32_t getConnID()           const { return iConnID; }
+	int32_t getCompression()       const { return iCompression; }
 	const C4ClientCore &getCCore() const { return CCore; }
 	const char *getPassword()      const { return Password.getData(); }
 
@@ -24,6 +24,8 @@
 #include <C4Components.h>
 #include <C4Game.h>
 
+#include <StdContentChunker.h>
+
 #include <fcntl.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -32,6 +34,9 @@
 #endif
 #include <errno.h>
 
+#include <functional>
+#include <unordered_map>
+
 // compile debug options
 // #define C4NET2RES_LOAD_ALL
 // #define C4NET2RES_DEBUG_LOG
@@ -69,6 +74,46 @@ public:
 };
 uint32_t DirSizeHelper::iSize, DirSizeHelper::iMaxSize;
 
+// splits a file into content-defined chunks (see C4Network2Res::DeltaChunks); fnChunk returns false to stop
+static bool ForEachDeltaChunk(const char *szFilename, const std::function<bool(const uint8_t *, uint32_t, const uint8_t *)> &fnChunk)
+{
+	CStdFile File;
+	if (!File.Open(szFilename)) return false;
+	StdContentChunker Chunker(C4NetResDeltaMinChunk, C4NetResDeltaAvgChunk, C4NetResDeltaMaxChunk);
+	StdBuf Chunk; Chunk.New(C4NetResDeltaMaxChunk);
+	uint32_t iChunkSize = 0;
+	StdSha1 Sha1;
+	const auto EndChunk = [&]()
+	{
+		uint8_t Hash[StdSha1::DigestLength];
+		Sha1.Reset();
+		Sha1.Update(Chunk.getData(), iChunkSize);
+		Sha1.GetHash(Hash);
+		const uint32_t iSize = iChunkSize;
+		iChunkSize = 0;
+		return fnChunk(Chunk.getPtr<uint8_t>(0), iSize, Hash);
+	};
+	for (;;)
+	{
+		// read a chunk of data
+		uint8_t Data[CStdFileBufSize]; size_t iSize = 0;
+		if (!File.Read(Data, CStdFileBufSize, &iSize))
+			if (!iSize)
+				break;
+		// split it up
+		for (size_t iPos = 0; iPos < iSize; )
+		{
+			bool fBoundary;
+			const size_t iLength = Chunker.Scan(Data + iPos, iSize - iPos, fBoundary);
+			Chunk.Write(Data + iPos, iLength, iChunkSize);
+			iChunkSize += iLength;
+			iPos += iLength;
+			if (fBoundary && !EndChunk()) return false;
+		}
+	}
+	return !iChunkSize || EndChunk();
+}
+
 // *** C4Network2ResCore
 
 C4Network2ResCore::C4Network2ResCore()
@@ -79,6 +124,12 @@ C4Network2ResCore::C4Network2ResCore()
 	iChunkSize(C4NetResChunkSize),
 	fHasFileSHA(false) {}
 
+void C4Network2ResDeltaChunk::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Size,              "Size", 0U));
+	pComp->Value(mkNamingAdapt(mkHexAdapt(Hash), "Hash"));
+}
+
 void C4Network2ResCore::Set(C4Network2ResType enType, int32_t iResID, const char *strFileName, uint32_t inContentsCRC, const char *strAuthor)
 {
 	// Initialize base data
@@ -134,7 +185,7 @@ void C4Network2ResCore::CompileFunc(StdCompiler *pComp)
 // *** C4Network2ResLoad
 
 C4Network2ResLoad::C4Network2ResLoad(int32_t inChunk, int32_t inByClient)
-	: iChunk(inChunk), iByClient(inByClient), Timestamp(time(nullptr)), pNext(nullptr) {}
+	: iChunk(inChunk), iByClient(inByClient), Timestamp(time(nullptr)), iStartTime(timeGetTime()), pNext(nullptr) {}
 
 C4Network2ResLoad::~C4Network2ResLoad() {}
 
@@ -240,7 +291,7 @@ void C4Network2ResChunkData::Clear()
 	}
 }
 
-int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading) const
+int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading, const std::vector<int32_t> &Availability) const
 {
 	// (this version is highly calculation-intensitive, yet the most satisfactory
 	//  solution I could find)
@@ -254,10 +305,32 @@ int32_t C4Network2ResChunkData::GetChunkToRetrieve(const C4Network2ResChunkData
 	if (ChData.isComplete()) return -1;
 	// invert to get everything that should be retrieved
 	C4Network2ResChunkData ChData2; ChData.GetNegative(ChData2);
-	// select chunk (random)
-	int32_t iRetrieveChunk = SafeRandom(ChData2.getPresentChunkCnt());
-	// return
-	return ChData2.getPresentChunk(iRetrieveChunk);
+	// rarest first: chunks few clients have would become the bottleneck later on,
+	// while loading them early lets other clients get them from us
+	const auto GetAvailability = [&Availability](int32_t iChunk) { return iChunk < int32_t(Availability.size()) ? Availability[iChunk] : 0; };
+	int32_t iMinAvailability = INT32_MAX, iCandidateCnt = 0;
+	for (ChunkRange *pRange = ChData2.pChunkRanges; pRange; pRange = pRange->Next)
+		for (int32_t i = pRange->Start; i < pRange->Start + pRange->Length; i++)
+		{
+			const int32_t iAvailability = GetAvailability(i);
+			if (iAvailability < iMinAvailability) { iMinAvailability = iAvailability; iCandidateCnt = 0; }
+			if (iAvailability == iMinAvailability) iCandidateCnt++;
+		}
+	// select one of them (random)
+	int32_t iCandidate = SafeRandom(iCandidateCnt);
+	for (ChunkRange *pRange = ChData2.pChunkRanges; pRange; pRange = pRange->Next)
+		for (int32_t i = pRange->Start; i < pRange->Start + pRange->Length; i++)
+			if (GetAvailability(i) == iMinAvailability && !iCandidate--)
+				return i;
+	return -1;
+}
+
+void C4Network2ResChunkData::CountChunks(std::vector<int32_t> &Availability) const
+{
+	Availability.resize(iChunkCnt);
+	for (ChunkRange *pRange = pChunkRanges; pRange; pRange = pRange->Next)
+		for (int32_t i = pRange->Start; i < pRange->Start + pRange->Length; i++)
+			Availability[i]++;
 }
 
 bool C4Network2ResChunkData::MergeRanges(ChunkRange *pRange)
@@ -346,6 +419,7 @@ C4Network2Res::C4Network2Res(C4Network2ResList *pnParent)
 	iRefCnt(0), fRemoved(false),
 	iLastReqTime(0),
 	fLoading(false),
+	eDeltaState(NRD_Done), iDeltaReqTime(0), fDeltaDone(false), fDeltaAbort(false), fDeltaLoaded(false),
 	pCChunks(nullptr), iDiscoverStartTime(0), pLoads(nullptr), iLoadCnt(0),
 	pNext(nullptr),
 	pParent(pnParent)
@@ -507,11 +581,143 @@ bool C4Network2Res::SetLoad(const C4Network2ResCore &nCore) // by main thread
 	fRemoved = false;
 	iLastReqTime = time(nullptr);
 	fLoading = true;
+	eDeltaState = NRD_Done;
+	fDeltaLoaded = false;
 	// No discovery yet
 	iDiscoverStartTime = 0;
 	return true;
 }
 
+void C4Network2Res::FindDeltaFiles() // by main thread
+{
+	DeltaFiles.clear();
+	if (!fLoading || Core.getFileSize() < C4NetResDeltaMinFileSize) return;
+	// candidates: a local version of the file (see SetByCore)...
+	const char *szLocalFile = GetC4Filename(Core.getFileName());
+	if (FileExists(szLocalFile) && !DirectoryExists(szLocalFile))
+		DeltaFiles.emplace_back(szLocalFile);
+	// ...and other versions of it that have been loaded before
+	{
+		CStdShareLock ResListLock(&pParent->ResListCSec);
+		for (C4Network2Res *pRes = pParent->pFirst; pRes; pRes = pRes->pNext)
+			if (pRes != this && !pRes->isLoading() && SEqual(GetFilename(pRes->Core.getFileName()), GetFilename(Core.getFileName())))
+			{
+				CStdLock FileLock(&pRes->FileCSec);
+				if (pRes->szStandalone[0])
+					DeltaFiles.emplace_back(pRes->szStandalone);
+			}
+	}
+	// the chunks are requested from the resource's creator once it has been discovered
+	if (!DeltaFiles.empty()) eDeltaState = NRD_None;
+}
+
+void C4Network2Res::OnDelta(const C4PacketResDelta &rDelta) // by network thread
+{
+	if (!fLoading || eDeltaState != NRD_Requested) return;
+	eDeltaState = NRD_Done;
+	// check
+	const auto &Delta = rDelta.getChunks();
+	uint64_t iSize = 0;
+	for (const auto &Chunk : Delta) iSize += Chunk.Size;
+	if (Delta.empty() || iSize != Core.getFileSize()) return;
+	// remember them for others that load from us later on
+	{
+		CStdLock FileLock(&FileCSec);
+		DeltaChunks = Delta;
+	}
+	// reading and hashing whole files takes a while
+	eDeltaState = NRD_Matching;
+	fDeltaDone = fDeltaAbort = false;
+	DeltaPresentChunks.clear();
+	DeltaThread = std::thread{[this, Delta]()
+	{
+		LoadDelta(Delta);
+		fDeltaDone = true;
+	}};
+}
+
+void C4Network2Res::LoadDelta(const std::vector<C4Network2ResDeltaChunk> &Delta) // by delta thread
+{
+	// where does each chunk go?
+	std::vector<uint32_t> Offsets(Delta.size());
+	std::unordered_multimap<uint64_t, size_t> ChunksByHash;
+	uint32_t iOffset = 0;
+	for (size_t i = 0; i < Delta.size(); i++)
+	{
+		Offsets[i] = iOffset;
+		iOffset += Delta[i].Size;
+		uint64_t iKey; memcpy(&iKey, Delta[i].Hash, sizeof(iKey));
+		ChunksByHash.emplace(iKey, i);
+	}
+	// copy matching chunks of the local files
+	int32_t f = OpenFileWrite();
+	if (f == -1) return;
+	std::vector<bool> Present(Delta.size());
+	for (const auto &File : DeltaFiles)
+		ForEachDeltaChunk(File.getData(), [&](const uint8_t *pData, uint32_t iSize, const uint8_t *pHash)
+		{
+			uint64_t iKey; memcpy(&iKey, pHash, sizeof(iKey));
+			const auto Range = ChunksByHash.equal_range(iKey);
+			for (auto it = Range.first; it != Range.second; ++it)
+				if (!Present[it->second] && Delta[it->second].Size == iSize)
+					if (lseek(f, Offsets[it->second], SEEK_SET) == int32_t(Offsets[it->second]) && write(f, pData, iSize) == int32_t(iSize))
+						Present[it->second] = true;
+			return !fDeltaAbort;
+		});
+	close(f);
+	// transfer chunks that are covered completely
+	const uint32_t iChunkSize = Core.getChunkSize();
+	std::vector<uint32_t> Covered(Core.getChunkCnt());
+	for (size_t i = 0; i < Delta.size(); i++)
+		if (Present[i])
+			for (uint32_t iPos = Offsets[i], iEnd = Offsets[i] + Delta[i].Size; iPos < iEnd; )
+			{
+				const uint32_t iChunk = iPos / iChunkSize, iChunkEnd = std::min(iEnd, (iChunk + 1) * iChunkSize);
+				Covered[iChunk] += iChunkEnd - iPos;
+				iPos = iChunkEnd;
+			}
+	for (uint32_t i = 0; i < Covered.size(); i++)
+		if (Covered[i] == std::min(iChunkSize, Core.getFileSize() - i * iChunkSize))
+			DeltaPresentChunks.push_back(i);
+}
+
+void C4Network2Res::EndDelta() // by network thread
+{
+	DeltaThread.join();
+	eDeltaState = NRD_Done;
+	if (fDeltaAbort) return;
+	// mark what has been found
+	const int32_t iPresentChunkCnt = Chunks.getPresentChunkCnt();
+	for (const uint32_t iChunk : DeltaPresentChunks)
+		Chunks.AddChunk(iChunk);
+	DeltaPresentChunks.clear();
+	if (Chunks.getPresentChunkCnt() == iPresentChunkCnt) return;
+	Application.InteractiveThread.ThreadLogSF("Network: %s: %d of %d chunks taken from local files", Core.getFileName(), Chunks.getPresentChunkCnt() - iPresentChunkCnt, Chunks.getChunkCnt());
+	// the file needs to be checked when complete
+	fDeltaLoaded = true;
+	fDirty = true;
+}
+
+void C4Network2Res::StopDelta()
+{
+	if (!DeltaThread.joinable()) return;
+	fDeltaAbort = true;
+	EndDelta();
+}
+
+bool C4Network2Res::SendDelta(C4Network2IOConnection *pTo) // by network thread
+{
+	// only complete files can be chunked up
+	if (fLoading) return false;
+	std::vector<C4Network2ResDeltaChunk> Delta;
+	{
+		CStdLock FileLock(&FileCSec);
+		Delta = DeltaChunks;
+	}
+	// an empty answer tells the client not to wait for it
+	return pTo->Send(MkC4NetIOPacket(PID_NetResDelta, C4PacketResDelta(Core.getID(), Delta)));
+}
+
 bool C4Network2Res::SetDerived(const char *strName, const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iDResID)
 {
 	Clear();
@@ -600,12 +806,12 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 			{
 				if (!fSilent) Log("GetStandalone: could not find free name for temporary file!"); szStandalone[0] = '\0'; return false;
 			}
-			if (!C4Group_PackDirectoryTo(szFile, szStandalone))
+			if (!C4Group_PackDirectoryTo(szFile, szStandalone, true))
 			{
 				if (!fSilent) Log("GetStandalone: could not pack directory!"); szStandalone[0] = '\0'; return false;
 			}
 		}
-		else if (!C4Group_PackDirectory(szStandalone))
+		else if (!C4Group_PackDirectory(szStandalone, true))
 		{
 			if (!fSilent) Log("GetStandalone: could not pack directory!"); if (!SEqual(szFile, szStandalone)) EraseDirectory(szStandalone); szStandalone[0] = '\0'; return false;
 		}
@@ -680,6 +886,16 @@ bool C4Network2Res::GetStandalone(char *pTo, int32_t iMaxL, bool fSetOfficial, b
 	fStandaloneFailed = false;
 	// mark resource as loadable and safe file information
 	Core.SetLoadable(iSize, iCRC32);
+	// chunk up for clients that have a similar version
+	DeltaChunks.clear();
+	if (fSetOfficial && iSize >= C4NetResDeltaMinFileSize)
+		ForEachDeltaChunk(szStandalone, [this](const uint8_t *, uint32_t iSize, const uint8_t *pHash)
+		{
+			C4Network2ResDeltaChunk Chunk{iSize};
+			std::copy_n(pHash, C4NetResDeltaHashLength, Chunk.Hash);
+			DeltaChunks.push_back(Chunk);
+			return true;
+		});
 	// set up chunk data
 	Chunks.SetComplete(Core.getChunkCnt());
 	// ok
@@ -893,6 +1109,14 @@ void C4Network2Res::OnStatus(const C4Network2ResChunkData &rChunkData, C4Network
 	}
 	pChunks->ClientID = pBy->getClientID();
 	pChunks->Chunks = rChunkData;
+	UpdateChunkAvailability();
+	// ask the creator how to take parts from similar local files
+	if (fLoading && eDeltaState == NRD_None && pBy->getClientID() == getResClient() && rChunkData.isComplete())
+		if (pBy->Send(MkC4NetIOPacket(PID_NetResDeltaReq, C4PacketResRequest(Core.getID()))))
+		{
+			eDeltaState = NRD_Requested;
+			iDeltaReqTime = time(nullptr);
+		}
 	// load?
 	if (fLoading) StartLoad(pChunks->ClientID, pChunks->Chunks);
 }
@@ -918,7 +1142,10 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 		{
 			pNext = pLoad->Next();
 			if (pLoad->getChunk() == rChunk.getChunkNr())
+			{
+				pParent->OnPeerChunk(pLoad->getByClient(), pLoad->getTime(), rChunk.getSize());
 				RemoveLoad(pLoad);
+			}
 		}
 	}
 	// complete?
@@ -932,6 +1159,18 @@ void C4Network2Res::OnChunk(const C4Network2ResChunk &rChunk)
 bool C4Network2Res::DoLoad()
 {
 	if (!fLoading) return true;
+	// local files matched?
+	if (eDeltaState == NRD_Matching && fDeltaDone)
+		EndDelta();
+	// no answer from the creator? Just load everything
+	else if (eDeltaState == NRD_Requested && difftime(time(nullptr), iDeltaReqTime) > C4NetResDiscoverTimeout)
+		eDeltaState = NRD_Done;
+	// everything present locally?
+	if (Chunks.isComplete())
+	{
+		EndLoad();
+		return true;
+	}
 	// any loads currently active?
 	if (iLoadCnt)
 	{
@@ -942,6 +1181,7 @@ bool C4Network2Res::DoLoad()
 			pNext = pLoad->Next();
 			if (pLoad->CheckTimeout())
 			{
+				pParent->OnPeerTimeout(pLoad->getByClient());
 				RemoveLoad(pLoad);
 				iLoadsRemoved++;
 			}
@@ -971,6 +1211,7 @@ bool C4Network2Res::NeedsDiscover()
 
 void C4Network2Res::Clear()
 {
+	StopDelta();
 	CStdLock FileLock(&FileCSec);
 	// delete files
 	if (fTempFile)
@@ -986,6 +1227,7 @@ void C4Network2Res::Clear()
 	fTempFile = false;
 	Core.Clear();
 	Chunks.Clear();
+	DeltaChunks.clear();
 	fRemoved = false;
 	ClearLoad();
 }
@@ -1014,26 +1256,33 @@ void C4Network2Res::StartNewLoads()
 	ClientChunks **pC = new ClientChunks *[iCChunkCnt];
 	// initialize
 	int32_t i;
-	for (i = 0; i < iCChunkCnt; i++) pC[i] = nullptr;
-	// create shuffled order
 	for (pChunks = pCChunks, i = 0; i < iCChunkCnt; i++, pChunks = pChunks->Next)
+		pC[i] = pChunks;
+	// shuffle, faster peers tending to come first (slow or unmeasured ones still get their turn)
+	std::vector<uint32_t> Rates(iCChunkCnt); uint32_t iMaxRate = 0;
+	for (i = 0; i < iCChunkCnt; i++)
+		iMaxRate = std::max(iMaxRate, Rates[i] = pParent->GetPeerRate(pC[i]->ClientID));
+	std::vector<int32_t> Weights(iCChunkCnt);
+	for (i = 0; i < iCChunkCnt; i++)
+		Weights[i] = 250 + (iMaxRate ? static_cast<int32_t>(uint64_t{Rates[i]} * 1000 / iMaxRate) : 0);
+	for (i = 0; i < iCChunkCnt - 1; i++)
 	{
-		// determine position
-		int32_t iPos = SafeRandom(iCChunkCnt - i);
-		// find & set
-		for (int32_t j = 0; ; j++)
-			if (!pC[j] && !iPos--)
-			{
-				pC[j] = pChunks;
-				break;
-			}
+		int32_t iTotal = 0;
+		for (int32_t j = i; j < iCChunkCnt; j++) iTotal += Weights[j];
+		int32_t iPick = SafeRandom(iTotal), j = i;
+		while ((iPick -= Weights[j]) >= 0) j++;
+		std::swap(Weights[i], Weights[j]);
+		std::swap(pC[i], pC[j]);
 	}
-	// start new load until maximum count reached
-	while (iLoadCnt + 1 <= C4NetResMaxLoad)
+	// start new loads until maximum count reached, taking turns
+	for (int32_t iNext = 0; iLoadCnt + 1 <= C4NetResMaxLoad; )
 	{
 		int32_t ioLoadCnt = iLoadCnt;
-		// search someone
-		for (i = 0; i < iCChunkCnt; i++)
+		// search someone, starting after the one that got the last load
+		int32_t j;
+		for (j = 0; j < iCChunkCnt; j++)
+		{
+			i = (iNext + j) % iCChunkCnt;
 			if (pC[i])
 			{
 				// try to start load
@@ -1044,9 +1293,11 @@ void C4Network2Res::StartNewLoads()
 				// success?
 				if (iLoadCnt > ioLoadCnt) break;
 			}
+		}
 		// not found?
-		if (i >= iCChunkCnt)
+		if (j >= iCChunkCnt)
 			break;
+		iNext = i + 1;
 	}
 	// clear up
 	delete[] pC;
@@ -1057,30 +1308,24 @@ bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData
 	assert(pParent && pParent->getIOClass());
 	// all slots used? ignore
 	if (iLoadCnt + 1 >= C4NetResMaxLoad) return true;
-	int32_t loadsAtClient = 0;
-	// are there already enough loads by this client? ignore
-	for (C4Network2ResLoad *pPos = pLoads; pPos; pPos = pPos->Next())
-	{
-		if (pPos->getByClient() == iFromClient)
-		{
-			if (++loadsAtClient >= C4NetResMaxLoadPerPeerPerFile)
-				return true;
-		}
-	}
 	// find chunk to retrieve
 	int32_t iLoads[C4NetResMaxLoad]; int32_t i = 0;
 	for (C4Network2ResLoad *pLoad = pLoads; pLoad; pLoad = pLoad->Next())
 		iLoads[i++] = pLoad->getChunk();
-	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Available, i, iLoads);
+	int32_t iRetrieveChunk = Chunks.GetChunkToRetrieve(Available, i, iLoads, ChunkAvailability);
 	// nothing? ignore
 	if (iRetrieveChunk < 0 || static_cast<uint32_t>(iRetrieveChunk) >= Core.getChunkCnt())
 		return true;
+	// are there already enough requests to this client? ignore
+	if (!pParent->StartPeerLoad(iFromClient))
+		return true;
 	// search message connection for client
 	C4Network2IOConnection *pConn = pParent->getIOClass()->GetMsgConnection(iFromClient);
-	if (!pConn) return false;
+	if (!pConn) { pParent->EndPeerLoad(iFromClient); return false; }
 	// send request
 	if (!pConn->Send(MkC4NetIOPacket(PID_NetResReq, C4PacketResRequest(Core.getID(), iRetrieveChunk))))
 	{
+		pParent->EndPeerLoad(iFromClient);
 		pConn->DelRef(); return false;
 	}
 	pConn->DelRef();
@@ -1101,6 +1346,22 @@ bool C4Network2Res::StartLoad(int32_t iFromClient, const C4Network2ResChunkData
 
 void C4Network2Res::EndLoad()
 {
+	// everything has been received meanwhile: the local files aren't needed anymore
+	StopDelta();
+	// parts taken from local files could have been wrong (hash collision, file changed meanwhile)
+	if (fDeltaLoaded)
+	{
+		fDeltaLoaded = false;
+		uint32_t iCRC32;
+		if (!C4Group_GetFileCRC(szStandalone, &iCRC32) || iCRC32 != Core.getFileCRC())
+		{
+			Application.InteractiveThread.ThreadLogSF("Network: %s doesn't match after delta transfer, loading it completely", Core.getFileName());
+			Chunks.SetIncomplete(Core.getChunkCnt());
+			fDirty = true;
+			StartNewLoads();
+			return;
+		}
+	}
 	// clear loading data
 	ClearLoad();
 	// set complete
@@ -1113,10 +1374,12 @@ void C4Network2Res::EndLoad()
 void C4Network2Res::ClearLoad()
 {
 	// remove client chunks and loads
+	StopDelta();
 	fLoading = false;
 	while (pCChunks) RemoveCChunks(pCChunks);
 	while (pLoads) RemoveLoad(pLoads);
 	iDiscoverStartTime = iLoadCnt = 0;
+	ChunkAvailability.clear();
 }
 
 void C4Network2Res::RemoveLoad(C4Network2ResLoad *pLoad)
@@ -1133,6 +1396,7 @@ void C4Network2Res::RemoveLoad(C4Network2ResLoad *pLoad)
 			pPrev->pNext = pLoad->Next();
 	}
 	// delete
+	pParent->EndPeerLoad(pLoad->getByClient());
 	delete pLoad;
 	iLoadCnt--;
 }
@@ -1152,6 +1416,14 @@ void C4Network2Res::RemoveCChunks(ClientChunks *pChunks)
 	}
 	// delete
 	delete pChunks;
+	UpdateChunkAvailability();
+}
+
+void C4Network2Res::UpdateChunkAvailability()
+{
+	ChunkAvailability.assign(Chunks.getChunkCnt(), 0);
+	for (ClientChunks *pChunks = pCChunks; pChunks; pChunks = pChunks->Next)
+		pChunks->Chunks.CountChunks(ChunkAvailability);
 }
 
 bool C4Network2Res::OptimizeStandalone(bool fSilent)
@@ -1309,7 +1581,8 @@ void C4Network2ResChunk::CompileFunc(StdCompiler *pComp)
 	pComp->Value(mkNamingAdapt(iResID, "ResID", -1));
 	pComp->Value(mkNamingAdapt(iChunk, "Chunk", ~0U));
 	// Data
-	pComp->Value(mkNamingAdapt(Data, "Data"));
+	// Data (references the packet, chunks are written to the file before it is released)
+	pComp->Value(mkNamingAdapt(mkBufRefAdapt(Data), "Data"));
 }
 
 // *** C4Network2ResList
@@ -1320,7 +1593,8 @@ C4Network2ResList::C4Network2ResList()
 	pFirst(nullptr),
 	ResListCSec(this),
 	iLastDiscover(0), iLastStatus(0),
-	pIO(nullptr) {}
+	pIO(nullptr),
+	iLastPeerRateUpdate(0) {}
 
 C4Network2ResList::~C4Network2ResList()
 {
@@ -1489,6 +1763,8 @@ C4Network2Res::Ref C4Network2ResList::AddLoad(const C4Network2ResCore &Core) //
 	C4Network2Res::Ref pRes = new C4Network2Res(this);
 	// initialize
 	pRes->SetLoad(Core);
+	// look for similar files to take parts from
+	pRes->FindDeltaFiles();
 	// log
 	Application.InteractiveThread.ThreadLogSF("Network: loading %s...", Core.getFileName());
 	// add to list
@@ -1502,6 +1778,9 @@ void C4Network2ResList::RemoveAtClient(int32_t iClientID) // by main thread
 	for (C4Network2Res *pRes = pFirst; pRes; pRes = pRes->pNext)
 		if (pRes->getResClient() == iClientID)
 			pRes->Remove();
+	// forget transfer statistics
+	CStdLock PeerLock(&PeerCSec);
+	Peers.erase(iClientID);
 }
 
 void C4Network2ResList::Clear()
@@ -1514,6 +1793,8 @@ void C4Network2ResList::Clear()
 	}
 	iClientID = C4ClientIDUnknown;
 	iLastDiscover = iLastStatus = 0;
+	CStdLock PeerLock(&PeerCSec);
+	Peers.clear();
 }
 
 void C4Network2ResList::OnClientConnect(C4Network2IOConnection *pConn) // by main thread
@@ -1583,6 +1864,27 @@ void C4Network2ResList::HandlePacket(char cStatus, const C4PacketBase *pPacket,
 	}
 	break;
 
+	case PID_NetResDeltaReq: // content-defined chunks request
+	{
+		GETPKT(C4PacketResRequest, Pkt);
+		// find ressource
+		CStdShareLock ResListLock(&ResListCSec);
+		C4Network2Res *pRes = getRes(Pkt.getReqID());
+		// send chunks (or none)
+		if (pRes && pRes->IsBinaryCompatible()) pRes->SendDelta(pConn);
+	}
+	break;
+
+	case PID_NetResDelta: // content-defined chunks are coming in
+	{
+		GETPKT(C4PacketResDelta, Delta);
+		// find ressource
+		CStdShareLock ResListLock(&ResListCSec);
+		C4Network2Res *pRes = getRes(Delta.getResID());
+		if (pRes) pRes->OnDelta(Delta);
+	}
+	break;
+
 	case PID_NetResData: // a chunk of data is coming in
 	{
 		GETPKT(C4Network2ResChunk, Chunk);
@@ -1629,6 +1931,9 @@ void C4Network2ResList::OnTimer()
 		// set time accordingly
 		iLastStatus = fStatusUpdates ? time(nullptr) : 0;
 	}
+	// transfer rates
+	if (timeGetTime() - iLastPeerRateUpdate >= 1000)
+		UpdatePeerRates();
 }
 
 void C4Network2ResList::OnShareFree(CStdCSecEx *pCSec)
@@ -1757,6 +2062,70 @@ bool C4Network2ResList::FindTempResFileName(const char *szFilename, char *pTarge
 	return false;
 }
 
+bool C4Network2ResList::StartPeerLoad(int32_t iClientID)
+{
+	CStdLock PeerLock(&PeerCSec);
+	Peer &rPeer = Peers[iClientID];
+	if (rPeer.iLoadCnt >= rPeer.iWindow) return false;
+	rPeer.iLoadCnt++;
+	return true;
+}
+
+void C4Network2ResList::EndPeerLoad(int32_t iClientID)
+{
+	CStdLock PeerLock(&PeerCSec);
+	const auto it = Peers.find(iClientID);
+	if (it != Peers.end() && it->second.iLoadCnt > 0)
+		it->second.iLoadCnt--;
+}
+
+void C4Network2ResList::OnPeerChunk(int32_t iClientID, unsigned long iRequestTime, uint32_t iBytes)
+{
+	CStdLock PeerLock(&PeerCSec);
+	Peer &rPeer = Peers[iClientID];
+	const unsigned long iTime = std::max<unsigned long>(timeGetTime() - iRequestTime, 1);
+	rPeer.iBytes += iBytes;
+	rPeer.iRTT = rPeer.iRTT ? (rPeer.iRTT * 7 + iTime) / 8 : iTime;
+	if (!rPeer.iBaseRTT || iTime < rPeer.iBaseRTT) rPeer.iBaseRTT = iTime;
+	// delay-based window: requests queueing up at the peer only make the answers slower
+	// (unlike TCP, lost chunks don't tell anything, as the transport is reliable)
+	if (iTime <= 2 * rPeer.iBaseRTT)
+		rPeer.iWindow = std::min(rPeer.iWindow + 1, C4NetResMaxPeerWindow);
+	else if (iTime > 4 * rPeer.iBaseRTT)
+		rPeer.iWindow = std::max(rPeer.iWindow - 1, C4NetResMinPeerWindow);
+}
+
+void C4Network2ResList::OnPeerTimeout(int32_t iClientID)
+{
+	CStdLock PeerLock(&PeerCSec);
+	Peer &rPeer = Peers[iClientID];
+	rPeer.iWindow = std::max(rPeer.iWindow / 2, C4NetResMinPeerWindow);
+}
+
+void C4Network2ResList::UpdatePeerRates()
+{
+	const unsigned long iNow = timeGetTime();
+	const unsigned long iInterval = iNow - iLastPeerRateUpdate;
+	iLastPeerRateUpdate = iNow;
+	CStdLock PeerLock(&PeerCSec);
+	for (auto &Entry : Peers)
+	{
+		Peer &rPeer = Entry.second;
+		const uint32_t iRate = iInterval < 10000 ? static_cast<uint32_t>(uint64_t(rPeer.iBytes) * 1000 / iInterval) : 0;
+		rPeer.iRate = (rPeer.iRate + iRate) / 2;
+		rPeer.iBytes = 0;
+		// allow the fastest time to go up again if the connection got slower for good
+		rPeer.iBaseRTT += rPeer.iBaseRTT / 64;
+	}
+}
+
+uint32_t C4Network2ResList::GetPeerRate(int32_t iClientID)
+{
+	CStdLock PeerLock(&PeerCSec);
+	const auto it = Peers.find(iClientID);
+	return it != Peers.end() ? it->second.iRate : 0;
+}
+
 int32_t C4Network2ResList::GetClientProgress(int32_t clientID)
 {
 	int32_t sumPresentChunkCnt = 0, sumChunkCnt = 0;
@@ -22,14 +22,34 @@
 #include <StdSync.h>
 
 #include <atomic>
+#include <map>
+#include <thread>
+#include <vector>
 
 const uint32_t C4NetResChunkSize = 100U * 1024U;
 
+// delta transfer: content-defined chunks, matched against local files before loading
+const uint32_t C4NetResDeltaMinFileSize = 4 * C4NetResChunkSize, // smaller files are always loaded completely
+               C4NetResDeltaMinChunk = 4U * 1024U,
+               C4NetResDeltaAvgChunk = 16U * 1024U,
+               C4NetResDeltaMaxChunk = 64U * 1024U;
+const size_t C4NetResDeltaHashLength = 8; // (leading bytes of the chunk's SHA-1)
+
+struct C4Network2ResDeltaChunk
+{
+	uint32_t Size;
+	uint8_t Hash[C4NetResDeltaHashLength];
+
+	void CompileFunc(StdCompiler *pComp);
+};
+
 const int32_t C4NetResDiscoverTimeout = 10, // (s)
               C4NetResDiscoverInterval = 1, // (s)
               C4NetResStatusInterval = 1, // (s)
-              C4NetResMaxLoadPerPeerPerFile = 3,
-              C4NetResMaxLoad = 20,
+              C4NetResMaxLoad = 32, // per file
+              C4NetResMinPeerWindow = 1, // chunk requests in flight per peer, adjusted to its round-trip time
+              C4NetResInitialPeerWindow = 3,
+              C4NetResMaxPeerWindow = 12,
               C4NetResLoadTimeout = 60, // (s)
               C4NetResDeleteTime = 60, // (s)
               C4NetResMaxBigicon = 20; // maximum size, in KB, of bigicon
@@ -62,6 +82,7 @@ const StdEnumEntry<C4Network2ResType> C4Network2ResType_EnumMap[] =
 #include "C4Network2IO.h"
 class C4Network2ResList;
 class C4Network2ResChunk;
+class C4PacketResDelta;
 
 // classes
 class C4Network2ResCore : public C4PacketBase
@@ -115,14 +136,16 @@ protected:
 	// chunk download data
 	int32_t iChunk;
 	time_t Timestamp;
+	unsigned long iStartTime; // (ms, for round-trip time)
 	int32_t iByClient;
 
 	// list (C4Network2Res)
 	C4Network2ResLoad *pNext;
 
 public:
-	int32_t getChunk()    const { return iChunk; }
-	int32_t getByClient() const { return iByClient; }
+	int32_t getChunk()     const { return iChunk; }
+	int32_t getByClient()  const { return iByClient; }
+	unsigned long getTime() const { return iStartTime; }
 
 	C4Network2ResLoad *Next() const { return pNext; }
 
@@ -161,7 +184,8 @@ public:
 
 	void Clear();
 
-	int32_t GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading) const;
+	int32_t GetChunkToRetrieve(const C4Network2ResChunkData &Available, int32_t iLoadingCnt, int32_t *pLoading, const std::vector<int32_t> &Availability) const;
+	void CountChunks(std::vector<int32_t> &Availability) const; // increments the count of every present chunk
 
 protected:
 	// helpers
@@ -225,6 +249,16 @@ protected:
 	// loading
 	bool fLoading;
 
+	// delta transfer: parts of the file are taken from similar local files (see LoadDelta)
+	std::vector<C4Network2ResDeltaChunk> DeltaChunks; // of the complete file, for clients loading it
+	enum { NRD_None, NRD_Requested, NRD_Matching, NRD_Done } eDeltaState; // (loading only)
+	time_t iDeltaReqTime;
+	std::vector<StdStrBuf> DeltaFiles; // similar local files
+	std::thread DeltaThread; // matches the local files, so the network thread isn't blocked
+	std::atomic<bool> fDeltaDone, fDeltaAbort;
+	std::vector<uint32_t> DeltaPresentChunks; // transfer chunks found by the delta thread
+	bool fDeltaLoaded; // parts were taken from local files
+
 	// not savable if true
 	bool local{false};
 	struct ClientChunks { C4Network2ResChunkData Chunks; int32_t ClientID; ClientChunks *Next; }
@@ -232,6 +266,7 @@ protected:
 	time_t iDiscoverStartTime;
 	C4Network2ResLoad *pLoads;
 	int32_t iLoadCnt;
+	std::vector<int32_t> ChunkAvailability; // number of clients having each chunk
 
 	// list (C4Network2ResList)
 	C4Network2Res *pNext;
@@ -256,6 +291,7 @@ public:
 	bool SetByGroup(C4Group *pGrp, bool fTemp, C4Network2ResType eType, int32_t iResID, const char *szResName = nullptr, bool fSilent = false);
 	bool SetByCore(const C4Network2ResCore &nCore, bool fSilent = false, const char *szAsFilename = nullptr, int32_t iRecursion = 0);
 	bool SetLoad(const C4Network2ResCore &nCore);
+	void FindDeltaFiles();
 
 	bool SetDerived(const char *strName, const char *strFilePath, bool fTemp, C4Network2ResType eType, int32_t iDResID);
 
@@ -271,6 +307,7 @@ public:
 
 	bool SendStatus(C4Network2IOConnection *pTo = nullptr);
 	bool SendChunk(uint32_t iChunk, int32_t iToClient);
+	bool SendDelta(C4Network2IOConnection *pTo);
 
 	// references
 	void AddRef(); void DelRef();
@@ -279,6 +316,7 @@ public:
 	void OnDiscover(C4Network2IOConnection *pBy);
 	void OnStatus(const C4Network2ResChunkData &rChunkData, C4Network2IOConnection *pBy);
 	void OnChunk(const C4Network2ResChunk &rChunk);
+	void OnDelta(const C4PacketResDelta &rDelta);
 	bool DoLoad();
 
 	bool NeedsDiscover();
@@ -298,8 +336,12 @@ protected:
 
 	void RemoveLoad(C4Network2ResLoad *pLoad);
 	void RemoveCChunks(ClientChunks *pChunks);
+	void UpdateChunkAvailability();
 
 	bool OptimizeStandalone(bool fSilent);
+	void LoadDelta(const std::vector<C4Network2ResDeltaChunk> &Delta); // by delta thread
+	void EndDelta();
+	void StopDelta();
 };
 
 class C4Network2ResChunk : public C4PacketBase
@@ -316,6 +358,7 @@ protected:
 public:
 	int32_t  getResID()   const { return iResID; }
 	uint32_t getChunkNr() const { return iChunk; }
+	size_t   getSize()    const { return Data.getSize(); }
 
 	bool Set(C4Network2Res *pRes, uint32_t iChunk);
 	bool AddTo(C4Network2Res *pRes, C4Network2IO *pIO) const;
@@ -346,6 +389,19 @@ protected:
 	// object used for network i/o
 	C4Network2IO *pIO;
 
+	// chunk transfers by peer, over all ressources
+	struct Peer
+	{
+		int32_t iWindow = C4NetResInitialPeerWindow; // maximum number of chunk requests in flight
+		int32_t iLoadCnt = 0;
+		unsigned long iBaseRTT = 0, iRTT = 0; // fastest / smoothed time from request to chunk arrival (ms)
+		uint32_t iBytes = 0; // received since last rate update
+		uint32_t iRate = 0; // (bytes/s)
+	};
+	std::map<int32_t, Peer> Peers;
+	CStdCSec PeerCSec;
+	unsigned long iLastPeerRateUpdate;
+
 public:
 	// initialization
 	bool Init(int32_t iClientID, C4Network2IO *pIOClass); // by main thread
@@ -385,10 +441,18 @@ public:
 	C4Network2IO *getIOClass() { return pIO; }
 
 	int32_t GetClientProgress(int32_t clientID);
+	uint32_t GetPeerRate(int32_t iClientID); // (bytes/s of chunk data received)
 
 protected:
 	void OnResComplete(C4Network2Res *pRes);
 
+	// peer windows (by both)
+	bool StartPeerLoad(int32_t iClientID); // false if the peer's window is full
+	void EndPeerLoad(int32_t iClientID);
+	void OnPeerChunk(int32_t iClientID, unsigned long iRequestTime, uint32_t iBytes);
+	void OnPeerTimeout(int32_t iClientID);
+	void UpdatePeerRates();
+
 	// misc
 	bool CreateNetworkFolder();
 	bool FindTempResFileName(const char *szFilename, char *pTarget);
@@ -444,3 +508,19 @@ public:
 
 	virtual void CompileFunc(StdCompiler *pComp) override;
 };
+
+class C4PacketResDelta : public C4PacketBase
+{
+public:
+	C4PacketResDelta(int32_t iResID = -1, const std::vector<C4Network2ResDeltaChunk> &nChunks = {});
+
+protected:
+	int32_t iResID;
+	std::vector<C4Network2ResDeltaChunk> Chunks;
+
+public:
+	int32_t                                     getResID()  const { return iResID; }
+	const std::vector<C4Network2ResDeltaChunk> &getChunks() const { return Chunks; }
+
+	virtual void CompileFunc(StdCompiler *pComp) override;
+};
@@ -306,6 +306,8 @@ C4Network2Stats::C4Network2Stats() : pSec1Timer(nullptr)
 	statNetO.SetTitle(LoadResStr("IDS_NET_OUTPUT"));
 	statNetO.SetColorDw(0xff0000);
 	graphNetIO.AddGraph(&statNetI); graphNetIO.AddGraph(&statNetO);
+	statNetCompressionSaved.SetTitle(LoadResStr("IDS_NET_COMPRESSIONSAVED"));
+	statNetCompressionTime.SetTitle(LoadResStr("IDS_NET_COMPRESSIONTIME"));
 	statControls.SetTitle(LoadResStr("IDS_NET_CONTROL"));
 	statControls.SetAverageTime(100);
 	statActions.SetTitle(LoadResStr("IDS_NET_APM"));
@@ -333,6 +335,8 @@ void C4Network2Stats::ExecuteSecond()
 	statFPS.RecordValue(C4Graph::ValueType(Game.FPS));
 	statNetI.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getProtIRate(P_TCP) + Game.Network.NetIO.getProtIRate(P_UDP)));
 	statNetO.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getProtORate(P_TCP) + Game.Network.NetIO.getProtORate(P_UDP)));
+	statNetCompressionSaved.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getCompressionSavedRate()));
+	statNetCompressionTime.RecordValue(C4Graph::ValueType(Game.Network.NetIO.getCompressionTimeRate()));
 	// pings for all clients
 	C4Network2Client *pClient = nullptr;
 	while (pClient = Game.Network.Clients.GetNextClient(pClient)) if (pClient->getStatPing())
@@ -342,6 +346,10 @@ void C4Network2Stats::ExecuteSecond()
 		if (pConn) iPing = pConn->getLag();
 		pClient->getStatPing()->RecordValue(C4Graph::ValueType(iPing));
 	}
+	// ressource transfer rates
+	pClient = nullptr;
+	while (pClient = Game.Network.Clients.GetNextClient(pClient)) if (pClient->getStatResTransfer())
+		pClient->getStatResTransfer()->RecordValue(C4Graph::ValueType(Game.Network.ResList.GetPeerRate(pClient->getID())));
 	++SecondCounter;
 }
 
@@ -374,7 +382,10 @@ C4Graph *C4Network2Stats::GetGraphByName(const StdStrBuf &rszName, bool &rfIsTem
 	if (SEqualNoCase(rszName.getData(), "oc")) return &statObjCount;
 	if (SEqualNoCase(rszName.getData(), "fps")) return &statFPS;
 	if (SEqualNoCase(rszName.getData(), "netio")) return &graphNetIO;
+	if (SEqualNoCase(rszName.getData(), "compression")) return &statNetCompressionSaved;
+	if (SEqualNoCase(rszName.getData(), "compressiontime")) return &statNetCompressionTime;
 	if (SEqualNoCase(rszName.getData(), "pings")) return &statPings;
+	if (SEqualNoCase(rszName.getData(), "transfer")) return &statResTransfer;
 	if (SEqualNoCase(rszName.getData(), "control")) return &statControls;
 	if (SEqualNoCase(rszName.getData(), "apm")) return &statActions;
 	// no match
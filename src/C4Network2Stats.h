@@ -179,8 +179,12 @@ private:
 	C4TableGraph statNetI, statNetO;
 	C4GraphCollection graphNetIO;
 
+	// packet compression: bytes saved and time spent per second
+	C4TableGraph statNetCompressionSaved, statNetCompressionTime;
+
 protected:
 	C4GraphCollection statPings; // for all clients
+	C4GraphCollection statResTransfer; // ressource data received per client (bytes/s)
 
 	// per-controlframe stats
 	C4GraphCollection statControls;
@@ -252,7 +252,7 @@ void C4Object::AssignRemoval(bool fExitContents)
 		if (!Status) return;
 	}
 	// Destruction call
-	Call(PSF_Destruction);
+	Call(OCB_Destruction);
 	// Destruction-callback might have deleted the object already
 	if (!Status) return;
 	// remove all effects (extinguishes as well)
@@ -1196,6 +1196,7 @@ bool C4Object::ChangeDef(C4ID idNew)
 	Def = pDef;
 	id = pDef->id;
 	Def->Count++;
+	Game.Objects.InvalidateIDIndex();
 	LocalNamed.SetNameList(&pDef->Script.LocalNamed);
 	// new def: Needs to be resorted
 	Unsorted = true;
@@ -1284,7 +1285,7 @@ void C4Object::DoDamage(int32_t iChange, int32_t iCausedBy, int32_t iCause)
 	// Change value
 	Damage = std::max<int32_t>(Damage + iChange, 0);
 	// Engine script call
-	Call(PSF_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
+	Call(OCB_Damage, {C4VInt(iChange), C4VInt(iCausedBy)});
 }
 
 // returns x * y, but returns std::numeric_limits<T>::min() or std::numeric_limits<T>::max() in case of a negative or positive overflow respectively
@@ -1530,7 +1531,7 @@ bool C4Object::Exit(int32_t iX, int32_t iY, int32_t iR, C4Fixed iXDir, C4Fixed i
 	SetOCF();
 	// Engine calls
 	if (fCalls) pContainer->Call(PSF_Ejection, {C4VObj(this)});
-	if (fCalls) Call(PSF_Departure, {C4VObj(pContainer)});
+	if (fCalls) Call(OCB_Departure, {C4VObj(pContainer)});
 	// Success (if the obj wasn't "re-entered" by script)
 	return !Contained;
 }
@@ -1547,14 +1548,14 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	// No target or target is self
 	if (!pTarget || (pTarget == this)) return false;
 	// check if entrance is allowed
-	if (Call(PSF_RejectEntrance, {C4VObj(pTarget)})) return false;
+	if (Call(OCB_RejectEntrance, {C4VObj(pTarget)})) return false;
 	// check if we end up in an endless container-recursion
 	for (C4Object *pCnt = pTarget->Contained; pCnt; pCnt = pCnt->Contained)
 		if (pCnt == this) return false;
 	// Check RejectCollect, if desired
 	if (pfRejectCollect)
 	{
-		if (pTarget->Call(PSF_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
+		if (pTarget->Call(OCB_RejectCollection, {C4VID(Def->id), C4VObj(this)}))
 		{
 			*pfRejectCollect = true;
 			return false;
@@ -1598,7 +1599,7 @@ bool C4Object::Enter(C4Object *pTarget, bool fCalls, bool fCopyMotion, bool *pfR
 	if (fCalls) pTarget->Call(PSF_Collection2, {C4VObj(this)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Entrance call
-	if (fCalls) Call(PSF_Entrance, {C4VObj(Contained)});
+	if (fCalls) Call(OCB_Entrance, {C4VObj(Contained)});
 	if (!Contained || !Contained->Status || !pTarget->Status) return true;
 	// Base auto sell contents
 	if (ValidPlr(Contained->Base))
@@ -1800,7 +1801,7 @@ bool C4Object::Push(C4Fixed txdir, C4Fixed dforce, bool fStraighten)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(FormatString(LoadResStr("IDS_OBJ_STUCK"), GetName()).getData(), this);
-			Call(PSF_Stuck);
+			Call(OCB_Stuck);
 		}
 
 	return true;
@@ -1830,7 +1831,7 @@ bool C4Object::Lift(C4Fixed tydir, C4Fixed dforce)
 		if (ContactCheck(x, y)) // Resets t_contact
 		{
 			GameMsgObject(FormatString(LoadResStr("IDS_OBJ_STUCK"), GetName()).getData(), this);
-			Call(PSF_Stuck);
+			Call(OCB_Stuck);
 		}
 	return true;
 }
@@ -2195,6 +2196,12 @@ C4Value C4Object::Call(const char *szFunctionCall, const C4AulParSet &pPars, boo
 	return Def->Script.ObjectCall(this, this, szFunctionCall, pPars, fPassError);
 }
 
+C4Value C4Object::Call(C4ObjectCallback eCallback, const C4AulParSet &pPars, bool fPassError)
+{
+	if (!Status || !Def) return C4VNull;
+	return Def->Script.ObjectCallback(this, eCallback, pPars, fPassError);
+}
+
 bool C4Object::SetPhase(int32_t iPhase)
 {
 	if (Action.Act <= ActIdle) return false;
@@ -5652,11 +5659,11 @@ bool C4Object::Collect(C4Object *pObj)
 	// Cancel attach (hacky)
 	ObjectComCancelAttach(pObj);
 	// Container Collection call
-	Call(PSF_Collection, {C4VObj(pObj)});
+	Call(OCB_Collection, {C4VObj(pObj)});
 	// Object Hit call
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(PSF_Hit);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(PSF_Hit2);
-	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(PSF_Hit3);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed1) pObj->Call(OCB_Hit);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed2) pObj->Call(OCB_Hit2);
+	if (pObj->Status && pObj->OCF & OCF_HitSpeed3) pObj->Call(OCB_Hit3);
 	// post-copy the motion of the new container
 	if (pObj->Contained == this) pObj->CopyMotion(this);
 	// done, success
@@ -236,6 +236,7 @@ public:
 
 	bool CallControl(C4Player *pPlr, uint8_t byCom, const C4AulParSet &pPars = C4AulParSet{});
 	C4Value Call(const char *szFunctionCall, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false);
+	C4Value Call(C4ObjectCallback eCallback, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false);
 
 	bool ContainedControl(uint8_t byCom);
 
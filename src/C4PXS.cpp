@@ -23,14 +23,30 @@
 #include <C4Random.h>
 #include <C4Wrappers.h>
 
+#include <chrono>
+
 static const C4Fixed WindDrift_Factor = itofix(1, 800);
 
-void C4PXS::Execute()
+bool C4PXSSystem::ExecutePXS(const size_t i)
 {
+	// work on local copies: reactions may create new PXS and thereby reallocate the arrays
+	int32_t mat = Mat[i];
+	C4Fixed x = X[i], y = Y[i], xdir = XDir[i], ydir = YDir[i];
+	const auto store = [&]
+	{
+		Mat[i] = mat; X[i] = x; Y[i] = y; XDir[i] = xdir; YDir[i] = ydir;
+	};
+	const auto deactivate = [&]
+	{
+		store();
+		Deactivate(i);
+		return false;
+	};
+
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = x; rc.y = y; rc.iMat = mat;
 		rc.pos = 0;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
@@ -38,30 +54,26 @@ void C4PXS::Execute()
 	int32_t inmat;
 
 	// Safety
-	if (!MatValid(Mat))
-	{
-		Deactivate(); return;
-	}
+	if (!MatValid(mat))
+		return deactivate();
 
 	// Out of bounds
-	if ((x < 0) || (x >= GBackWdt) || (y < -10) || (y >= GBackHgt))
-	{
-		Deactivate(); return;
-	}
+	const int32_t iWdt = GBackWdt, iHgt = GBackHgt;
+	if ((x < 0) || (x >= iWdt) || (y < -10) || (y >= iHgt))
+		return deactivate();
 
 	// Material conversion
 	int32_t iX = fixtoi(x), iY = fixtoi(y);
 	inmat = GBackMat(iX, iY);
-	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
-	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, Mat, inmat, meePXSPos, nullptr))
-	{
-		Deactivate(); return;
-	}
+	C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(mat, inmat);
+	if (pReact && (*pReact->pFunc)(pReact, iX, iY, iX, iY, xdir, ydir, mat, inmat, meePXSPos, nullptr))
+		return deactivate();
 
 	// Gravity
 	ydir += GravAccel;
 
-	if (GBackDensity(iX, iY + 1) < Game.Material.Map[Mat].Density)
+	const C4Material &material = Game.Material.Map[mat];
+	if (GBackDensity(iX, iY + 1) < material.Density)
 	{
 		// Air speed: Wind plus some random
 		int32_t iWind = GBackWind(iX, iY);
@@ -69,7 +81,7 @@ void C4PXS::Execute()
 		C4Fixed tydir = FIXED256(Random(1200) - 600);
 
 		// Air friction, based on WindDrift. MaxSpeed is ignored.
-		int32_t iWindDrift = (std::max)(Game.Material.Map[Mat].WindDrift - 20, 0);
+		int32_t iWindDrift = (std::max)(material.WindDrift - 20, 0);
 		xdir += ((txdir - xdir) * iWindDrift) * WindDrift_Factor;
 		ydir += ((tydir - ydir) * iWindDrift) * WindDrift_Factor;
 	}
@@ -80,12 +92,13 @@ void C4PXS::Execute()
 	int32_t iToX = fixtoi(ctcox), iToY = fixtoi(ctcoy);
 
 	// In bounds?
-	if (Inside<int32_t>(iToX, 0, GBackWdt - 1) && Inside<int32_t>(iToY, 0, GBackHgt - 1))
+	if (Inside<int32_t>(iToX, 0, iWdt - 1) && Inside<int32_t>(iToY, 0, iHgt - 1))
 		// Check path
 		if (Game.Landscape._PathFree(iX, iY, iToX, iToY))
 		{
 			x = ctcox; y = ctcoy;
-			return;
+			store();
+			return true;
 		}
 
 	// Test path to target position
@@ -96,13 +109,12 @@ void C4PXS::Execute()
 		int32_t inX = iX + Sign(iToX - iX), inY = iY + Sign(iToY - iY);
 		// Contact?
 		inmat = GBackMat(inX, inY);
-		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(Mat, inmat);
+		C4MaterialReaction *pReact = Game.Material.GetReactionUnsafe(mat, inmat);
 		if (pReact)
-			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, Mat, inmat, meePXSMove, &fStopMovement))
+			if ((*pReact->pFunc)(pReact, iX, iY, inX, inY, xdir, ydir, mat, inmat, meePXSMove, &fStopMovement))
 			{
 				// destructive contact
-				Deactivate();
-				return;
+				return deactivate();
 			}
 			else
 			{
@@ -110,7 +122,8 @@ void C4PXS::Execute()
 				if (fStopMovement)
 				{
 					x = itofix(iX); y = itofix(iY);
-					return;
+					store();
+					return true;
 				}
 				// there was a reaction func, but it didn't do anything - continue movement
 			}
@@ -119,27 +132,29 @@ void C4PXS::Execute()
 
 	// No contact? Free movement
 	x = ctcox; y = ctcoy;
+	store();
 #ifdef DEBUGREC_PXS
 	{
 		C4RCExecPXS rc;
-		rc.x = x; rc.y = y; rc.iMat = Mat;
+		rc.x = x; rc.y = y; rc.iMat = mat;
 		rc.pos = 1;
 		AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 	}
 #endif
-	return;
+	return true;
 }
 
-void C4PXS::Deactivate()
+void C4PXSSystem::Deactivate(const size_t i)
 {
 #ifdef DEBUGREC_PXS
 	C4RCExecPXS rc;
-	rc.x = x; rc.y = y; rc.iMat = Mat;
+	rc.x = X[i]; rc.y = Y[i]; rc.iMat = Mat[i];
 	rc.pos = 2;
 	AddDbgRec(RCT_ExecPXS, &rc, sizeof(rc));
 #endif
-	Mat = MNone;
-	Game.PXS.Delete(this);
+	Mat[i] = MNone;
+	--ChunkPXS[i / PXSChunkSize];
+	--PXSNum;
 }
 
 C4PXSSystem::C4PXSSystem()
@@ -155,82 +170,82 @@ C4PXSSystem::~C4PXSSystem()
 void C4PXSSystem::Default()
 {
 	Count = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	PXSNum = 0;
 }
 
 void C4PXSSystem::Clear()
 {
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		delete[] Chunk[cnt];
-		Chunk[cnt] = nullptr;
-		iChunkPXS[cnt] = 0;
-	}
+	Mat.clear(); X.clear(); Y.clear(); XDir.clear(); YDir.clear();
+	ChunkPXS.clear();
+	PXSNum = 0;
+}
+
+void C4PXSSystem::ResizeChunks(const size_t iChunks)
+{
+	const size_t iSize = iChunks * PXSChunkSize;
+	Mat.resize(iSize, MNone);
+	X.resize(iSize); Y.resize(iSize);
+	XDir.resize(iSize); YDir.resize(iSize);
+	ChunkPXS.resize(iChunks, 0);
 }
 
-C4PXS *C4PXSSystem::New()
+size_t C4PXSSystem::New()
 {
-	unsigned int cnt, cnt2;
-	C4PXS *pxp;
-	// Check chunks for available space
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
+	// only PXS that still exist count against the budget
+	const size_t iMaxPXS = std::max<int32_t>(Game.C4S.Landscape.MaxPXS, 0);
+	if (PXSNum >= iMaxPXS) return SIZE_MAX;
+	const size_t iMaxChunks = (iMaxPXS + PXSChunkSize - 1) / PXSChunkSize;
+	// check chunks for available space
+	for (size_t iChunk = 0; iChunk < iMaxChunks; iChunk++)
 	{
-		// Create new chunk if necessary
-		if (!Chunk[cnt])
-		{
-			Chunk[cnt] = new C4PXS[PXSChunkSize];
-			iChunkPXS[cnt] = 0;
-		}
-		// Check this chunk for space
-		if (iChunkPXS[cnt] < PXSChunkSize)
-			for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat == MNone)
+		// new chunk if necessary
+		if (iChunk >= ChunkPXS.size()) ResizeChunks(iChunk + 1);
+		if (ChunkPXS[iChunk] < PXSChunkSize)
+			for (size_t i = iChunk * PXSChunkSize; i < (iChunk + 1) * PXSChunkSize; i++)
+				if (Mat[i] == MNone)
 				{
-					// count theam
-					iChunkPXS[cnt]++;
-					return pxp;
+					++ChunkPXS[iChunk];
+					++PXSNum;
+					return i;
 				}
 	}
-	return nullptr;
+	return SIZE_MAX;
 }
 
 bool C4PXSSystem::Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir, C4Fixed iydir)
 {
-	C4PXS *pxp;
 	if (!MatValid(mat)) return false;
-	if (!(pxp = New())) return false;
-	pxp->Mat = mat;
-	pxp->x = ix; pxp->y = iy;
-	pxp->xdir = ixdir; pxp->ydir = iydir;
+	const size_t i = New();
+	if (i == SIZE_MAX) return false;
+	Mat[i] = mat;
+	X[i] = ix; Y[i] = iy;
+	XDir[i] = ixdir; YDir[i] = iydir;
 	return true;
 }
 
+void C4PXSSystem::ExecuteChunk(const size_t iChunk)
+{
+	// PXS created meanwhile in a later slot are executed in this frame as well
+	const size_t iEnd = (iChunk + 1) * PXSChunkSize;
+	for (size_t i = iChunk * PXSChunkSize; i < iEnd; i++)
+		if (Mat[i] != MNone)
+		{
+			ExecutePXS(i);
+			Count++;
+		}
+}
+
 void C4PXSSystem::Execute()
 {
-	// Execute all chunks
+	// Execute all chunks; the chunk count may grow meanwhile
 	Count = 0;
-	for (unsigned int cchunk = 0; cchunk < PXSMaxChunk; cchunk++)
-		if (Chunk[cchunk])
-			// empty chunk?
-			if (!iChunkPXS[cchunk])
-			{
-				delete[] Chunk[cchunk]; Chunk[cchunk] = nullptr;
-			}
-			else
-			{
-				// Execute chunk pxs, check for empty
-				C4PXS *pxp = Chunk[cchunk];
-				for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-					if (pxp->Mat != MNone)
-					{
-						pxp->Execute();
-						Count++;
-					}
-			}
+	for (size_t iChunk = 0; iChunk < ChunkPXS.size(); iChunk++)
+		if (ChunkPXS[iChunk])
+			ExecuteChunk(iChunk);
+	// empty chunks at the end are not needed anymore
+	size_t iChunks = ChunkPXS.size();
+	while (iChunks && !ChunkPXS[iChunks - 1]) --iChunks;
+	if (iChunks < ChunkPXS.size()) ResizeChunks(iChunks);
 }
 
 void C4PXSSystem::Draw(C4FacetEx &cgo)
@@ -241,33 +256,28 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 
 	// First pass: draw old-style PXS (lines/pixels)
 	int32_t cgox = cgo.X - cgo.TargetX, cgoy = cgo.Y - cgo.TargetY;
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	const size_t iSize = Mat.size();
+	for (size_t i = 0; i < iSize; i++)
+		if (Mat[i] != MNone && VisibleRect.Contains(fixtoi(X[i]), fixtoi(Y[i])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
-						continue;
-					// old-style: unicolored pixels or lines
-					uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(pxp->Mat));
-					if (fixtoi(pxp->xdir) || fixtoi(pxp->ydir))
-					{
-						// lines for stuff that goes whooosh!
-						int len = fixtoi(Abs(pxp->xdir) + Abs(pxp->ydir));
-						dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
-						Application.DDraw->DrawLineDw(cgo.Surface,
-							fixtof(pxp->x - pxp->xdir) + cgox, fixtof(pxp->y - pxp->ydir) + cgoy,
-							fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy,
-							dwMatClr);
-					}
-					else
-						// single pixels for slow stuff
-						Application.DDraw->DrawPix(cgo.Surface, fixtof(pxp->x) + cgox, fixtof(pxp->y) + cgoy, dwMatClr);
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[i]];
+			if (pMat->PXSFace.Surface && Config.Graphics.PXSGfx)
+				continue;
+			// old-style: unicolored pixels or lines
+			uint32_t dwMatClr = Game.Landscape.GetPal()->GetClr(Mat2PixColDefault(Mat[i]));
+			if (fixtoi(XDir[i]) || fixtoi(YDir[i]))
+			{
+				// lines for stuff that goes whooosh!
+				int len = fixtoi(Abs(XDir[i]) + Abs(YDir[i]));
+				dwMatClr = uint32_t(std::max<int>(dwMatClr >> 24, 195 - (195 - (dwMatClr >> 24)) / len)) << 24 | (dwMatClr & 0xffffff);
+				Application.DDraw->DrawLineDw(cgo.Surface,
+					fixtof(X[i] - XDir[i]) + cgox, fixtof(Y[i] - YDir[i]) + cgoy,
+					fixtof(X[i]) + cgox, fixtof(Y[i]) + cgoy,
+					dwMatClr);
+			}
+			else
+				// single pixels for slow stuff
+				Application.DDraw->DrawPix(cgo.Surface, fixtof(X[i]) + cgox, fixtof(Y[i]) + cgoy, dwMatClr);
 		}
 
 	// PXS graphics disabled?
@@ -275,28 +285,24 @@ void C4PXSSystem::Draw(C4FacetEx &cgo)
 		return;
 
 	// Second pass: draw new-style PXS (graphics)
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	for (size_t i = 0; i < iSize; i++)
+		if (Mat[i] != MNone && VisibleRect.Contains(fixtoi(X[i]), fixtoi(Y[i])))
 		{
-			C4PXS *pxp = Chunk[cnt];
-			for (unsigned int cnt2 = 0; cnt2 < PXSChunkSize; cnt2++, pxp++)
-				if (pxp->Mat != MNone && VisibleRect.Contains(fixtoi(pxp->x), fixtoi(pxp->y)))
-				{
-					C4Material *pMat = &Game.Material.Map[pxp->Mat];
-					if (!pMat->PXSFace.Surface)
-						continue;
-					// new-style: graphics
-					int32_t pnx, pny;
-					pMat->PXSFace.GetPhaseNum(pnx, pny);
-					int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
-					// calculate draw width and tile to use (random-ish)
-					int32_t z = 1 + ((cnt2 / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
-					pny = (cnt2 / pnx) % pny; pnx = cnt2 % pnx;
-					// draw
-					Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
-					pMat->PXSFace.DrawX(cgo.Surface, fixtoi(pxp->x) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(pxp->y) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
-					Application.DDraw->DeactivateBlitModulation();
-				}
+			C4Material *pMat = &Game.Material.Map[Mat[i]];
+			if (!pMat->PXSFace.Surface)
+				continue;
+			// new-style: graphics
+			const int32_t iSeed = i % PXSChunkSize;
+			int32_t pnx, pny;
+			pMat->PXSFace.GetPhaseNum(pnx, pny);
+			int32_t fcWdt = pMat->PXSFace.Wdt; int32_t fcWdtH = (std::max)(fcWdt / 3, 1);
+			// calculate draw width and tile to use (random-ish)
+			int32_t z = 1 + ((iSeed / std::max<int32_t>(pnx * pny, 1)) ^ 341) % pMat->PXSGfxSize;
+			pny = (iSeed / pnx) % pny; pnx = iSeed % pnx;
+			// draw
+			Application.DDraw->ActivateBlitModulation((std::min)((fcWdtH - z) * 16, 255) << 24 | 0xffffff);
+			pMat->PXSFace.DrawX(cgo.Surface, fixtoi(X[i]) + cgox + z * pMat->PXSGfxRt.tx / fcWdt, fixtoi(Y[i]) + cgoy + z * pMat->PXSGfxRt.ty / fcWdt, z, z * pMat->PXSFace.Hgt / fcWdt, pnx, pny);
+			Application.DDraw->DeactivateBlitModulation();
 		}
 }
 
@@ -317,14 +323,8 @@ void C4PXSSystem::Cast(int32_t mat, int32_t num, int32_t tx, int32_t ty, int32_t
 
 bool C4PXSSystem::Save(C4Group &hGroup)
 {
-	unsigned int cnt;
-
-	// Check used chunk count
-	int32_t iChunks = 0;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			iChunks++;
-	if (!iChunks)
+	// Nothing to save?
+	if (!PXSNum)
 	{
 		hGroup.Delete(C4CFN_PXS);
 		return true;
@@ -337,10 +337,21 @@ bool C4PXSSystem::Save(C4Group &hGroup)
 	int32_t iNumFormat = 1;
 	if (!hTempFile.Write(&iNumFormat, sizeof(iNumFormat)))
 		return false;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt]) // must save all chunks in order to keep order consistent on all clients
-			if (!hTempFile.Write(Chunk[cnt], PXSChunkSize * sizeof(C4PXS)))
-				return false;
+	// must save all chunks in order to keep order consistent on all clients
+	std::vector<C4PXS> chunk(PXSChunkSize);
+	for (size_t iChunk = 0; iChunk < ChunkPXS.size(); iChunk++)
+	{
+		for (size_t cnt = 0; cnt < PXSChunkSize; cnt++)
+		{
+			C4PXS &pxs = chunk[cnt];
+			const size_t i = iChunk * PXSChunkSize + cnt;
+			pxs.Mat = Mat[i];
+			pxs.x = X[i]; pxs.y = Y[i];
+			pxs.xdir = XDir[i]; pxs.ydir = YDir[i];
+		}
+		if (!hTempFile.Write(chunk.data(), PXSChunkSize * sizeof(C4PXS)))
+			return false;
+	}
 
 	if (!hTempFile.Close())
 		return false;
@@ -373,21 +384,25 @@ bool C4PXSSystem::Load(C4Group &hGroup)
 	else if (iBinSize % iChunkSize != 0) return false;
 	// calc chunk count
 	iChunkNum = iBinSize / iChunkSize;
-	if (iChunkNum > PXSMaxChunk) return false;
-	for (uint32_t cnt = 0; cnt < iChunkNum; cnt++)
+	ResizeChunks(iChunkNum);
+	std::vector<C4PXS> chunk(PXSChunkSize);
+	for (size_t cnt = 0; cnt < iChunkNum; cnt++)
 	{
-		Chunk[cnt] = new C4PXS[PXSChunkSize];
-		if (!hGroup.Read(Chunk[cnt], iChunkSize)) return false;
+		if (!hGroup.Read(chunk.data(), iChunkSize)) return false;
 		// count the PXS, Peter!
-		// convert num format, if neccessary
-		C4PXS *pxp; iChunkPXS[cnt] = 0;
-		for (cnt2 = 0, pxp = Chunk[cnt]; cnt2 < PXSChunkSize; cnt2++, pxp++)
-			if (pxp->Mat != MNone)
-			{
-				++iChunkPXS[cnt];
-				// convert number format
-				if (iNumForm == 2) { FLOAT_TO_FIXED(&pxp->x); FLOAT_TO_FIXED(&pxp->y); FLOAT_TO_FIXED(&pxp->xdir); FLOAT_TO_FIXED(&pxp->ydir); }
-			}
+		for (cnt2 = 0; cnt2 < PXSChunkSize; cnt2++)
+		{
+			C4PXS &pxs = chunk[cnt2];
+			if (pxs.Mat == MNone) continue;
+			// convert number format
+			if (iNumForm == 2) { FLOAT_TO_FIXED(&pxs.x); FLOAT_TO_FIXED(&pxs.y); FLOAT_TO_FIXED(&pxs.xdir); FLOAT_TO_FIXED(&pxs.ydir); }
+			const size_t i = cnt * PXSChunkSize + cnt2;
+			Mat[i] = pxs.Mat;
+			X[i] = pxs.x; Y[i] = pxs.y;
+			XDir[i] = pxs.xdir; YDir[i] = pxs.ydir;
+			++ChunkPXS[cnt];
+			++PXSNum;
+		}
 	}
 	return true;
 }
@@ -400,32 +415,52 @@ void C4PXSSystem::Synchronize()
 void C4PXSSystem::SyncClearance()
 {
 	// consolidate chunks; remove empty chunks
-	C4PXS **pDestChunk = Chunk;
-	int32_t iDestChunk = 0;
-	for (unsigned int cnt = 0; cnt < PXSMaxChunk; cnt++)
-	{
-		if (Chunk[cnt] && iChunkPXS[cnt])
+	size_t iDestChunk = 0;
+	for (size_t iChunk = 0; iChunk < ChunkPXS.size(); iChunk++)
+		if (ChunkPXS[iChunk])
 		{
-			*pDestChunk++ = Chunk[cnt];
-			iChunkPXS[iDestChunk++] = iChunkPXS[cnt];
-		}
-		else
-		{
-			delete[] Chunk[cnt];
-			Chunk[cnt] = nullptr;
+			if (iChunk != iDestChunk)
+			{
+				const auto Move = [iChunk, iDestChunk](auto &Data)
+				{
+					std::copy_n(Data.begin() + iChunk * PXSChunkSize, PXSChunkSize, Data.begin() + iDestChunk * PXSChunkSize);
+				};
+				Move(Mat); Move(X); Move(Y); Move(XDir); Move(YDir);
+				ChunkPXS[iDestChunk] = ChunkPXS[iChunk];
+			}
+			iDestChunk++;
 		}
-	}
+	ResizeChunks(iDestChunk);
 }
 
-void C4PXSSystem::Delete(C4PXS *pPXS)
+bool C4PXSSystem::Benchmark(int32_t iFrames)
 {
-	// find chunk
-	unsigned int cnt;
-	for (cnt = 0; cnt < PXSMaxChunk; cnt++)
-		if (Chunk[cnt] && iChunkPXS[cnt])
-			if (pPXS >= Chunk[cnt] && pPXS < Chunk[cnt] + PXSChunkSize)
-				break;
-	// decrease pxs counter
-	if (cnt < PXSMaxChunk)
-		iChunkPXS[cnt]--;
+	if (Game.Control.SyncMode()) return false;
+	int32_t iMat = Game.Material.Get("Water");
+	if (!MatValid(iMat)) iMat = 0;
+	if (!MatValid(iMat)) return false;
+	// the PXS fall freely for a while if they start in the sky with enough room below
+	const int32_t iFallHeight = fixtoi(GravAccel * (iFrames * iFrames / 2)) + 10;
+	const unsigned int iRandomHold = RandomHold; const int iRandomCount = RandomCount;
+	const int32_t iMaxPXS = Game.C4S.Landscape.MaxPXS;
+	for (const int32_t iCount : {10000, 50000, 200000})
+	{
+		Game.C4S.Landscape.MaxPXS = iCount;
+		C4PXSSystem PXS;
+		for (int32_t iTries = 0; PXS.PXSNum < static_cast<size_t>(iCount) && iTries < iCount * 10; iTries++)
+		{
+			const int32_t iX = SafeRandom(GBackWdt), iY = SafeRandom(GBackHgt - iFallHeight);
+			if (Game.Landscape._PathFree(iX, iY, iX, iY + iFallHeight))
+				PXS.Create(iMat, itofix(iX), itofix(iY), itofix(SafeRandom(21) - 10, 10), Fix0);
+		}
+		const int32_t iPlaced = static_cast<int32_t>(PXS.PXSNum);
+		const auto Start = std::chrono::steady_clock::now();
+		for (int32_t iFrame = 0; iFrame < iFrames; iFrame++)
+			PXS.Execute();
+		const double dTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+		LogF("Benchmark: %6d PXS: %.2f ms/frame (%d placed, %d left)", iCount, dTime / iFrames, iPlaced, static_cast<int32_t>(PXS.PXSNum));
+	}
+	Game.C4S.Landscape.MaxPXS = iMaxPXS;
+	RandomHold = iRandomHold; RandomCount = iRandomCount;
+	return true;
 }
@@ -20,22 +20,19 @@
 
 #include <C4Material.h>
 
+#include <vector>
+
+// one pixel sprite as stored in PXS.c4b
 class C4PXS
 {
+public:
 	C4PXS() : Mat(MNone), x(Fix0), y(Fix0), xdir(Fix0), ydir(Fix0) {}
 
-	friend class C4PXSSystem;
-
-protected:
 	int32_t Mat;
 	C4Fixed x, y, xdir, ydir;
-
-protected:
-	void Execute();
-	void Deactivate();
 };
 
-const size_t PXSChunkSize = 500, PXSMaxChunk = 20;
+const size_t PXSChunkSize = 500; // PXS per chunk in PXS.c4b
 
 class C4PXSSystem
 {
@@ -47,11 +44,14 @@ public:
 	int32_t Count;
 
 protected:
-	C4PXS *Chunk[PXSMaxChunk];
-	size_t iChunkPXS[PXSMaxChunk];
+	// structure of arrays in chunks of PXSChunkSize slots; free slots have MNone as material
+	// PXS keep their slot, so new ones fill the first free slot like they always did and the execution order stays the same
+	std::vector<int32_t> Mat;
+	std::vector<C4Fixed> X, Y, XDir, YDir;
+	std::vector<size_t> ChunkPXS; // PXS per chunk
+	size_t PXSNum; // PXS in all chunks; limited by the scenario
 
 public:
-	void Delete(C4PXS *pPXS);
 	void Default();
 	void Clear();
 	void Execute();
@@ -62,7 +62,12 @@ public:
 	bool Create(int32_t mat, C4Fixed ix, C4Fixed iy, C4Fixed ixdir = Fix0, C4Fixed iydir = Fix0);
 	bool Load(C4Group &hGroup);
 	bool Save(C4Group &hGroup);
+	static bool Benchmark(int32_t iFrames); // not for synchronized games: changes random and maybe landscape
 
 protected:
-	C4PXS *New();
+	size_t New(); // index of a free slot in the first chunk with space; SIZE_MAX if the budget is exhausted
+	void ExecuteChunk(size_t iChunk);
+	bool ExecutePXS(size_t i); // returns false if the PXS got deactivated
+	void Deactivate(size_t i);
+	void ResizeChunks(size_t iChunks);
 };
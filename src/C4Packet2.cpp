@@ -90,6 +90,8 @@ const C4PktHandlingData PktHandlingData[] =
 	{ PID_NetResDerive,       PC_Network, "Resource Derive",             false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4Network2ResCore) },
 	{ PID_NetResReq,          PC_Network, "Resource Request",            false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4PacketResRequest) },
 	{ PID_NetResData,         PC_Network, "Resource Data",               false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4Network2ResChunk) },
+	{ PID_NetResDeltaReq,     PC_Network, "Resource Delta Request",      false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4PacketResRequest) },
+	{ PID_NetResDelta,        PC_Network, "Resource Delta",              false, true,  PH_C4Network2ResList,    PKT_UNPACK(C4PacketResDelta) },
 
 	// C4GameControlNetwork (network thread)
 	{ PID_Control,            PC_Network, "Control",                     false, true,  PH_C4GameControlNetwork, PKT_UNPACK(C4GameControlPacket) },
@@ -145,7 +147,10 @@ C4NetIOPacket C4PacketBase::pack(uint8_t cStatus, const C4NetIO::addr_t &addr) c
 void C4PacketBase::unpack(const C4NetIOPacket &Pkt, char *pStatus)
 {
 	if (pStatus) *pStatus = Pkt.getStatus();
-	CompileFromBuf<StdCompilerBinRead>(*this, pStatus ? Pkt.getPBuf() : Pkt.getRef());
+	StdCompilerBinRead Compiler;
+	Compiler.setInput(pStatus ? Pkt.getPBuf() : Pkt.getRef());
+	Compiler.setAllowRawRef(true);
+	Compiler.Compile(*this);
 }
 
 // C4IDPacket
@@ -34,6 +34,7 @@ public:
 
 	// conversion (using above functions)
 	C4NetIOPacket pack(uint8_t cStatus, const C4NetIO::addr_t &addr = C4NetIO::addr_t()) const;
+	// note: bulk data may reference Pkt, so it must outlive the unpacked packet
 	void unpack(const C4NetIOPacket &Pkt, char *pStatus = nullptr);
 };
 
@@ -97,6 +98,9 @@ enum C4PacketType
 	// post mortem
 	PID_PostMortem = 0x06,
 
+	// compressed packet (unpacked by C4Network2IO before handling)
+	PID_Compressed = 0x07,
+
 	// (packets before this ID won't be recovered post-mortem)
 	PID_PacketLogStart = 0x04,
 
@@ -128,11 +132,13 @@ enum C4PacketType
 	PID_ReadyCheck     = 0x21,
 
 	// * ressources
-	PID_NetResDis    = 0x30,
-	PID_NetResStat   = 0x31,
-	PID_NetResDerive = 0x32,
-	PID_NetResReq    = 0x33,
-	PID_NetResData   = 0x34,
+	PID_NetResDis      = 0x30,
+	PID_NetResStat     = 0x31,
+	PID_NetResDerive   = 0x32,
+	PID_NetResReq      = 0x33,
+	PID_NetResData     = 0x34,
+	PID_NetResDeltaReq = 0x35,
+	PID_NetResDelta    = 0x36,
 
 	// * control
 	PID_Control      = 0x40,
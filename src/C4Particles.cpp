@@ -27,6 +27,8 @@
 #include <C4Components.h>
 #include <C4Wrappers.h>
 
+#include <chrono>
+
 void C4ParticleDefCore::CompileFunc(StdCompiler *pComp)
 {
 	pComp->Value(mkNamingAdapt(toC4CStrBuf(Name),                "Name",         ""));
@@ -85,6 +87,8 @@ C4ParticleDef::C4ParticleDef() :
 	ExecProc(&fxStdExec),
 	DrawProc(&fxStdDraw),
 	CollisionProc(nullptr),
+	BatchExecProc(&fxStdExecBatch),
+	BatchDrawProc(&fxStdDrawBatch),
 	Count(0)
 {
 	// zero fields
@@ -165,6 +169,7 @@ bool C4ParticleDef::Load(C4Group &rGrp)
 			DebugLogF("exec proc for particle '%s' not found: '%s'", Name.getData(), ExecFn.getData());
 			return false;
 		}
+		BatchExecProc = ParticleSystem.GetBatchExecProc(ExecFn.getData());
 		if (CollisionFn && CollisionFn[0]) if (!(CollisionProc = ParticleSystem.GetProc(CollisionFn.getData())))
 		{
 			DebugLogF("collision proc for particle '%s' not found: '%s'", Name.getData(), CollisionFn.getData());
@@ -175,6 +180,7 @@ bool C4ParticleDef::Load(C4Group &rGrp)
 			DebugLogF("draw proc for particle '%s' not found: '%s'", Name.getData(), DrawFn.getData());
 			return false;
 		}
+		BatchDrawProc = ParticleSystem.GetBatchDrawProc(DrawFn.getData());
 		// particle overloading
 		C4ParticleDef *pDefOverload;
 		if (pDefOverload = ParticleSystem.GetDef(Name.getData(), this))
@@ -204,111 +210,111 @@ bool C4ParticleDef::Reload()
 	return Load(hGroup);
 }
 
-void C4Particle::MoveList(C4ParticleList &rFrom, C4ParticleList &rTo)
+void C4ParticleBatch::Exec(C4Object *pObj)
 {
-	// remove from current list
-	if (pPrev)
-		pPrev->pNext = pNext;
+	const size_t iCount = Particles.size();
+	size_t iAlive;
+	if (pDef->BatchExecProc)
+		iAlive = pDef->BatchExecProc(Particles.data(), iCount, pObj);
 	else
-		// is it the first item in the list? then set this to the next one
-		if (rFrom.pFirst == this) rFrom.pFirst = pNext;
-	if (pNext) pNext->pPrev = pPrev;
-	// add to the other list - insert before first
-	if (pNext = rTo.pFirst) pNext->pPrev = this;
-	rTo.pFirst = this; pPrev = nullptr;
+	{
+		// execute one by one, moving survivors over dead particles
+		C4ParticleExecProc ExecProc = pDef->ExecProc;
+		iAlive = 0;
+		for (size_t i = 0; i < iCount; ++i)
+			if (ExecProc(&Particles[i], pObj))
+			{
+				if (iAlive != i) Particles[iAlive] = Particles[i];
+				++iAlive;
+			}
+	}
+	// sorry, life is over for you :P
+	pDef->Count -= static_cast<int32_t>(iCount - iAlive);
+	Particles.resize(iAlive);
 }
 
-C4ParticleChunk::C4ParticleChunk()
+void C4ParticleBatch::Draw(C4FacetEx &cgo, C4Object *pObj)
 {
-	// zero linked list
-	pNext = nullptr;
-	// zero buffer
-	Clear();
+	if (pDef->BatchDrawProc)
+	{
+		pDef->BatchDrawProc(Particles.data(), Particles.size(), cgo, pObj);
+		return;
+	}
+	C4ParticleDrawProc DrawProc = pDef->DrawProc;
+	for (C4Particle &rPrt : Particles)
+		DrawProc(&rPrt, cgo, pObj);
 }
 
-C4ParticleChunk::~C4ParticleChunk()
+int32_t C4ParticleBatch::Remove()
 {
-	// list stuff done by C4ParticleSystem
+	const auto iCount = static_cast<int32_t>(Particles.size());
+	pDef->Count -= iCount;
+	Particles.clear();
+	return iCount;
 }
 
-void C4ParticleChunk::Clear()
+C4ParticleBatch &C4ParticleList::GetBatch(C4ParticleDef *pOfDef)
 {
-	// note that this method is called in ctor with uninitialized data!
-	// simply clear mem - this won't adjust any counts!
-	std::memset(Data, 0, sizeof(Data));
-	// init list
-	C4Particle *pPrt = Data;
-	for (int32_t i = 0; i < C4Px_BufSize; ++i)
-	{
-		pPrt->pPrev = pPrt - 1;
-		pPrt->pNext = pPrt + 1;
-		++pPrt;
-	}
-	Data[0].pPrev = Data[C4Px_BufSize - 1].pNext = nullptr;
+	// there are only a few defs per list
+	for (C4ParticleBatch &Batch : Batches)
+		if (Batch.pDef == pOfDef)
+			return Batch;
+	return Batches.emplace_back(pOfDef);
 }
 
 void C4ParticleList::Exec(C4Object *pObj)
 {
 	// execute all particles
-	C4Particle *pPrtNext = pFirst, *pPrt;
-	while (pPrt = pPrtNext)
-	{
-		// get next now, because destruction could corrupt the list
-		pPrtNext = pPrt->pNext;
-		// execute it
-		if (!pPrt->pDef->ExecProc(pPrt, pObj))
-		{
-			// sorry, life is over for you :P
-			--pPrt->pDef->Count;
-			pPrt->MoveList(*this, Game.Particles.FreeParticles);
-		}
-	}
-	// done
+	for (C4ParticleBatch &Batch : Batches)
+		if (!Batch.Particles.empty())
+			Batch.Exec(pObj);
 }
 
 void C4ParticleList::Draw(C4FacetEx &cgo, C4Object *pObj)
 {
 	// draw all particles
-	for (C4Particle *pPrt = pFirst; pPrt; pPrt = pPrt->pNext)
-		pPrt->pDef->DrawProc(pPrt, cgo, pObj);
-	// done
+	for (C4ParticleBatch &Batch : Batches)
+		if (!Batch.Particles.empty())
+			Batch.Draw(cgo, pObj);
 }
 
 void C4ParticleList::Clear()
 {
 	// remove all particles
-	C4Particle *pPrtNext = pFirst, *pPrt;
-	while (pPrt = pPrtNext)
-	{
-		// get next now, because destruction could corrupt the list
-		pPrtNext = pPrt->pNext;
-		// sorry, life is over for you :P
-		--pPrt->pDef->Count;
-		pPrt->MoveList(*this, Game.Particles.FreeParticles);
-	}
+	for (C4ParticleBatch &Batch : Batches)
+		Batch.Remove();
+	Batches.clear();
+	Batches.shrink_to_fit();
 }
 
 int32_t C4ParticleList::Remove(C4ParticleDef *pOfDef)
 {
 	int32_t iNumRemoved = 0;
-	// check all particles for def
-	C4Particle *pPrtNext = pFirst, *pPrt;
-	while (pPrt = pPrtNext)
-	{
-		// get next now, because destruction could corrupt the list
-		pPrtNext = pPrt->pNext;
-		// execute it
-		if (!pOfDef || pPrt->pDef == pOfDef)
-		{
-			// sorry, life is over for you :P
-			--pPrt->pDef->Count;
-			pPrt->MoveList(*this, Game.Particles.FreeParticles);
-		}
-	}
+	// check all batches for def
+	for (C4ParticleBatch &Batch : Batches)
+		if (!pOfDef || Batch.pDef == pOfDef)
+			iNumRemoved += Batch.Remove();
 	// done
 	return iNumRemoved;
 }
 
+int32_t C4ParticleList::Push(C4ParticleDef *pOfDef, float dxdir, float dydir)
+{
+	int32_t iNumPushed = 0;
+	for (C4ParticleBatch &Batch : Batches)
+		if (!pOfDef || Batch.pDef == pOfDef)
+		{
+			// push them!
+			for (C4Particle &rPrt : Batch.Particles)
+			{
+				rPrt.xdir += dxdir;
+				rPrt.ydir += dydir;
+			}
+			iNumPushed += static_cast<int32_t>(Batch.Particles.size());
+		}
+	return iNumPushed;
+}
+
 C4ParticleSystem::C4ParticleSystem()
 {
 	// zero fields
@@ -326,39 +332,21 @@ C4ParticleSystem::~C4ParticleSystem()
 	Clear();
 }
 
-C4ParticleChunk *C4ParticleSystem::AddChunk()
-{
-	// add another chunk
-	C4ParticleChunk *pNewChnk = new C4ParticleChunk();
-	pNewChnk->pNext = Chunk.pNext;
-	Chunk.pNext = pNewChnk;
-	// register into free-particle-list
-	if (pNewChnk->Data[C4Px_BufSize - 1].pNext = FreeParticles.pFirst)
-		FreeParticles.pFirst->pPrev = &pNewChnk->Data[C4Px_BufSize - 1];
-	FreeParticles.pFirst = &pNewChnk->Data[0];
-	// return it
-	return pNewChnk;
-}
-
 void C4ParticleSystem::ClearParticles()
 {
 	// clear particle lists
 	C4ObjectLink *pLnk;
 	for (pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
-		pLnk->Obj->FrontParticles.pFirst = pLnk->Obj->BackParticles.pFirst = nullptr;
+	{
+		pLnk->Obj->FrontParticles.Clear();
+		pLnk->Obj->BackParticles.Clear();
+	}
 	for (pLnk = Game.Objects.InactiveObjects.First; pLnk; pLnk = pLnk->Next)
-		pLnk->Obj->FrontParticles.pFirst = pLnk->Obj->BackParticles.pFirst = nullptr;
-	GlobalParticles.pFirst = nullptr;
-	// reset chunks
-	C4ParticleChunk *pNextChnk = Chunk.pNext, *pChnk;
-	while (pChnk = pNextChnk)
 	{
-		pNextChnk = pChnk->pNext;
-		delete pChnk;
+		pLnk->Obj->FrontParticles.Clear();
+		pLnk->Obj->BackParticles.Clear();
 	}
-	Chunk.pNext = nullptr;
-	Chunk.Clear();
-	FreeParticles.pFirst = Chunk.Data;
+	GlobalParticles.Clear();
 	// adjust counts
 	for (C4ParticleDef *pDef = pDef0; pDef; pDef = pDef->pNext)
 		pDef->Count = 0;
@@ -392,10 +380,18 @@ C4Particle *C4ParticleSystem::Create(C4ParticleDef *pOfDef,
 	// reduce creation if limit is nearly reached
 	if (iRoom < (MaxCount >> 1))
 		if (SafeRandom(iRoom) < SafeRandom(MaxCount)) return nullptr;
-	// get free particle
-	if (!FreeParticles.pFirst) AddChunk();
-	C4Particle *pPrt = FreeParticles.pFirst;
-	if (!pPrt) return nullptr;
+	return Add(pOfDef, x, y, xdir, ydir, a, b, *pPxList, pObj);
+}
+
+C4Particle *C4ParticleSystem::Add(C4ParticleDef *pOfDef,
+	float x, float y,
+	float xdir, float ydir,
+	float a, int32_t b, C4ParticleList &rPxList,
+	C4Object *pObj)
+{
+	// append to the def's batch in the desired list
+	C4ParticleBatch &rBatch = rPxList.GetBatch(pOfDef);
+	C4Particle *pPrt = &rBatch.Particles.emplace_back();
 	// set values
 	pPrt->x = x; pPrt->y = y;
 	pPrt->xdir = xdir; pPrt->ydir = ydir;
@@ -408,12 +404,13 @@ C4Particle *C4ParticleSystem::Create(C4ParticleDef *pOfDef,
 	}
 	// call initialization
 	if (!pOfDef->InitProc(pPrt, pObj))
+	{
 		// failed :(
+		rBatch.Particles.pop_back();
 		return nullptr;
+	}
 	// count particle
 	++pOfDef->Count;
-	// more to desired list
-	pPrt->MoveList(Game.Particles.FreeParticles, *pPxList);
 	// return newly created particle
 	return pPrt;
 }
@@ -462,6 +459,26 @@ C4ParticleDrawProc C4ParticleSystem::GetDrawProc(const char *szName)
 	return nullptr;
 }
 
+C4ParticleBatchExecProc C4ParticleSystem::GetBatchExecProc(const char *szName)
+{
+	// seek in map
+	for (int32_t i = 0; C4ParticleProcMap[i].Name[0]; ++i)
+		if (SEqual(C4ParticleProcMap[i].Name, szName))
+			return C4ParticleProcMap[i].BatchExecProc;
+	// nothing found...
+	return nullptr;
+}
+
+C4ParticleBatchDrawProc C4ParticleSystem::GetBatchDrawProc(const char *szName)
+{
+	// seek in map
+	for (int32_t i = 0; C4ParticleDrawProcMap[i].Name[0]; ++i)
+		if (SEqual(C4ParticleDrawProcMap[i].Name, szName))
+			return C4ParticleDrawProcMap[i].BatchProc;
+	// nothing found...
+	return nullptr;
+}
+
 C4ParticleDef *C4ParticleSystem::GetDef(const char *szName, C4ParticleDef *pExclude)
 {
 	// seek list
@@ -493,29 +510,63 @@ void C4ParticleSystem::SetDefParticles()
 
 int32_t C4ParticleSystem::Push(C4ParticleDef *pOfDef, float dxdir, float dydir)
 {
-	int32_t iNumPushed = 0;
-	// go through all particle chunks
-	for (C4ParticleChunk *pChnk = &Chunk; pChnk; pChnk = pChnk->pNext)
+	int32_t iNumPushed = GlobalParticles.Push(pOfDef, dxdir, dydir);
+	// go through all object particle lists
+	C4ObjectLink *pLnk;
+	for (pLnk = Game.Objects.First; pLnk; pLnk = pLnk->Next)
+		iNumPushed += pLnk->Obj->FrontParticles.Push(pOfDef, dxdir, dydir) + pLnk->Obj->BackParticles.Push(pOfDef, dxdir, dydir);
+	for (pLnk = Game.Objects.InactiveObjects.First; pLnk; pLnk = pLnk->Next)
+		iNumPushed += pLnk->Obj->FrontParticles.Push(pOfDef, dxdir, dydir) + pLnk->Obj->BackParticles.Push(pOfDef, dxdir, dydir);
+	// done
+	return iNumPushed;
+}
+
+bool C4ParticleSystem::Benchmark(int32_t iCount, int32_t iFrames)
+{
+	C4ParticleDef *pFire = GetDef("Fire"), *pFire2 = GetDef("Fire2");
+	if (!pSmoke || !pFire)
+	{
+		Log("Benchmark: Smoke and fire particles are not loaded");
+		return false;
+	}
+	// half smoke, half fire, spread over the whole landscape; dead particles are replaced after each frame
+	C4ParticleList List;
+	const auto Fill = [&]()
 	{
-		// go through all particles
-		C4Particle *pPrt = pChnk->Data; int32_t i = C4Px_BufSize;
-		while (i--)
+		size_t iAlive = 0;
+		for (const C4ParticleBatch &Batch : List.Batches) iAlive += Batch.Particles.size();
+		for (auto i = static_cast<int32_t>(iAlive); i < iCount; ++i)
 		{
-			// def fits?
-			if (!pOfDef || pPrt->pDef == pOfDef)
-			{
-				// push it!
-				pPrt->xdir += dxdir;
-				pPrt->ydir += dydir;
-				// count pushed
-				++iNumPushed;
-			}
-			// next particle
-			++pPrt;
+			const auto x = static_cast<float>(SafeRandom(GBackWdt)), y = static_cast<float>(SafeRandom(GBackHgt));
+			if (i % 2)
+				Add(pSmoke, x, y, 0.0f, 0.0f, static_cast<float>(5 + SafeRandom(20)), 0, List, nullptr);
+			else
+				Add((i % 4 || !pFire2) ? pFire : pFire2, x, y, (SafeRandom(11) - 5) / 10.0f, -(SafeRandom(11) / 10.0f), static_cast<float>(4 + SafeRandom(8)), 0, List, nullptr);
+		}
+	};
+	// draw over the whole landscape, so no particle is skipped as being off screen
+	C4FacetEx cgo;
+	const bool fDraw = Application.DDraw && Application.DDraw->lpPrimary;
+	if (fDraw) cgo.Set(Application.DDraw->lpPrimary, 0, 0, GBackWdt, GBackHgt, 0, 0);
+	std::chrono::steady_clock::duration ExecTime{}, DrawTime{};
+	for (int32_t i = 0; i < iFrames; ++i)
+	{
+		Fill();
+		auto Start = std::chrono::steady_clock::now();
+		List.Exec();
+		auto End = std::chrono::steady_clock::now();
+		ExecTime += End - Start;
+		if (fDraw)
+		{
+			List.Draw(cgo);
+			DrawTime += std::chrono::steady_clock::now() - End;
 		}
 	}
-	// done
-	return iNumPushed;
+	List.Clear();
+	const auto PerFrame = [iFrames](std::chrono::steady_clock::duration Time) { return std::chrono::duration<double, std::micro>(Time).count() / std::max<int32_t>(iFrames, 1); };
+	LogF("Benchmark: %d particles, %d frames: Exec %.1f us/frame, Draw %.1f us/frame", iCount, iFrames, PerFrame(ExecTime), PerFrame(DrawTime));
+	if (!fDraw) Log("Benchmark: Drawing skipped (no graphics)");
+	return true;
 }
 
 bool fxSmokeInit(C4Particle *pPrt, C4Object *pTarget)
@@ -611,6 +662,53 @@ bool fxStdInit(C4Particle *pPrt, C4Object *pTarget)
 	return true;
 }
 
+// alpha fade of the current frame; negative AlphaFade values fade only every few frames
+static inline int32_t fxStdFade(C4ParticleDef *pDef)
+{
+	int32_t iFade = pDef->AlphaFade;
+	if (iFade < 0) if (Game.FrameCounter % -iFade == 0) iFade = 1; else iFade = 0;
+	return iFade;
+}
+
+// fading, lifetime and range check of fxStdExec, using position and movement before this frame's move
+static inline bool fxStdExecLife(C4Particle *pPrt, C4ParticleDef *pDef, int32_t iFade, float dx, float dy, float dxdir, float dydir)
+{
+	// fade out
+	if (iFade)
+	{
+		uint32_t dwClr = pPrt->b;
+		int32_t iAlpha = dwClr >> 24;
+		iAlpha += pDef->AlphaFade;
+		if (iAlpha >= 0xff) return false;
+		pPrt->b = (dwClr & 0xffffff) | (iAlpha << 24);
+	}
+	// if delay is given, advance lifetime
+	if (pDef->Delay)
+	{
+		if (pPrt->life < 0)
+		{
+			// decay
+			return pPrt->life-- >= -pDef->FadeOutLen * pDef->FadeOutDelay;
+		}
+		++pPrt->life;
+		// check if still alive
+		int32_t iPhase = pPrt->life / pDef->Delay;
+		int32_t length = pDef->Length - pDef->Reverse;
+		if (iPhase >= length * pDef->Repeats + pDef->Reverse)
+		{
+			// do fadeout, if assigned
+			if (!pDef->FadeOutLen) return false;
+			pPrt->life = -1;
+		}
+		return true;
+	}
+	// outside landscape range?
+	bool kp;
+	if (dxdir > 0) kp =       (dx - pPrt->a < GBackWdt); else kp =       (dx + pPrt->a > 0);
+	if (dydir > 0) kp = kp && (dy - pPrt->a < GBackHgt); else kp = kp && (dy + pPrt->a > pDef->YOff);
+	return kp;
+}
+
 bool fxStdExec(C4Particle *pPrt, C4Object *pTarget)
 {
 	float dx = pPrt->x, dy = pPrt->y;
@@ -658,42 +756,46 @@ bool fxStdExec(C4Particle *pPrt, C4Object *pTarget)
 		pPrt->xdir += ((txdir - dxdir) * iWindDrift) / 800;
 		pPrt->ydir += ((tydir - dydir) * iWindDrift) / 800;
 	}
-	// fade out
-	int32_t iFade = pPrt->pDef->AlphaFade;
-	if (iFade < 0) if (Game.FrameCounter % -iFade == 0) iFade = 1; else iFade = 0;
-	if (iFade)
+	return fxStdExecLife(pPrt, pPrt->pDef, fxStdFade(pPrt->pDef), dx, dy, dxdir, dydir);
+}
+
+size_t fxStdExecBatch(C4Particle *pPrt, size_t iCount, C4Object *pTarget)
+{
+	if (!iCount) return 0;
+	C4ParticleDef *pDef = pPrt->pDef;
+	size_t iAlive = 0;
+	// collisions, wind and attachment need the landscape or the target for each particle
+	if (pDef->VertexCount || pDef->WindDrift || (pDef->Attach && pTarget != nullptr))
 	{
-		uint32_t dwClr = pPrt->b;
-		int32_t iAlpha = dwClr >> 24;
-		iAlpha += pPrt->pDef->AlphaFade;
-		if (iAlpha >= 0xff) return false;
-		pPrt->b = (dwClr & 0xffffff) | (iAlpha << 24);
+		for (size_t i = 0; i < iCount; ++i)
+			if (fxStdExec(&pPrt[i], pTarget))
+			{
+				if (iAlive != i) pPrt[iAlive] = pPrt[i];
+				++iAlive;
+			}
+		return iAlive;
 	}
-	// if delay is given, advance lifetime
-	if (pPrt->pDef->Delay)
-	{
-		if (pPrt->life < 0)
+	// otherwise, sort out dying particles first, as their fate depends on the old position...
+	const int32_t iFade = fxStdFade(pDef);
+	for (size_t i = 0; i < iCount; ++i)
+		if (fxStdExecLife(&pPrt[i], pDef, iFade, pPrt[i].x, pPrt[i].y, pPrt[i].xdir, pPrt[i].ydir))
 		{
-			// decay
-			return pPrt->life-- >= -pPrt->pDef->FadeOutLen * pPrt->pDef->FadeOutDelay;
+			if (iAlive != i) pPrt[iAlive] = pPrt[i];
+			++iAlive;
 		}
-		++pPrt->life;
-		// check if still alive
-		int32_t iPhase = pPrt->life / pPrt->pDef->Delay;
-		int32_t length = pPrt->pDef->Length - pPrt->pDef->Reverse;
-		if (iPhase >= length * pPrt->pDef->Repeats + pPrt->pDef->Reverse)
+	// ...then move the survivors in one go
+	const float fGravity = fixtof(GravAccel * pDef->GravityAcc) / 100.0f;
+	if (pDef->RByV != 2)
+		for (size_t i = 0; i < iAlive; ++i)
 		{
-			// do fadeout, if assigned
-			if (!pPrt->pDef->FadeOutLen) return false;
-			pPrt->life = -1;
+			pPrt[i].x += pPrt[i].xdir;
+			pPrt[i].y += pPrt[i].ydir;
+			pPrt[i].ydir += fGravity;
 		}
-		return true;
-	}
-	// outside landscape range?
-	bool kp;
-	if (dxdir > 0) kp =       (dx - pPrt->a < GBackWdt); else kp =       (dx + pPrt->a > 0);
-	if (dydir > 0) kp = kp && (dy - pPrt->a < GBackHgt); else kp = kp && (dy + pPrt->a > pPrt->pDef->YOff);
-	return kp;
+	else if (pDef->GravityAcc)
+		for (size_t i = 0; i < iAlive; ++i)
+			pPrt[i].ydir += fGravity;
+	return iAlive;
 }
 
 bool fxBounce(C4Particle *pPrt, C4Object *pTarget)
@@ -724,18 +826,13 @@ bool fxDie(C4Particle *pPrt, C4Object *pTarget)
 	return false;
 }
 
-void fxStdDraw(C4Particle *pPrt, C4FacetEx &cgo, C4Object *pTarget)
+// draws one particle of a fxStdDrawBatch; clipper and blit mode have been set already
+static inline void fxStdDrawParticle(C4Particle *pPrt, C4ParticleDef *pDef, C4FacetEx &cgo, int32_t tx, int32_t ty, C4Object *pTarget)
 {
-	// get def
-	C4ParticleDef *pDef = pPrt->pDef;
-	// apply parallaxity to target pos
-	int32_t tx = cgo.TargetX * pDef->Parallaxity[0] / 100;
-	int32_t ty = cgo.TargetY * pDef->Parallaxity[1] / 100;
-
 	float dx = pPrt->x, dy = pPrt->y;
 	float dxdir = pPrt->xdir, dydir = pPrt->ydir;
 	// relative position & movement
-	if (pPrt->pDef->Attach && pTarget != nullptr)
+	if (pDef->Attach && pTarget != nullptr)
 	{
 		dx += pTarget->x;
 		dy += pTarget->y;
@@ -765,44 +862,62 @@ void fxStdDraw(C4Particle *pPrt, C4FacetEx &cgo, C4Object *pTarget)
 			else iPhase %= length;
 		}
 		else iPhase = (iPhase + 1) / -pDef->FadeOutDelay + pDef->Length;
-		// get rotation
-		int32_t r = 0;
-		if ((pDef->RByV == 1) || (pDef->RByV == 2)) // rotation by direction
-			r = Angle(0, 0, static_cast<int32_t>(dxdir * 10.0f), static_cast<int32_t>(dydir * 10.0f)) * 100;
-		if (pDef->RByV == 3) // random rotation - currently a pseudo random rotation by x/y position
-			r = (static_cast<int32_t>(pPrt->x * 23 + pPrt->y * 12) % 360) * 100;
-		// draw at pos
-		Application.DDraw->ActivateBlitModulation(pPrt->b);
-		Application.DDraw->StorePrimaryClipper();
-		Application.DDraw->SubPrimaryClipper(cgox, cgoy + pDef->YOff, 100000, 100000);
-		if (pDef->Additive) lpDDraw->SetBlitMode(C4GFXBLIT_ADDITIVE);
-		int32_t iDrawWdt = int32_t(pPrt->a);
-		int32_t iDrawHgt = int32_t(pDef->Aspect * iDrawWdt);
-		if (r)
-			pDef->Gfx.DrawXR(cgo.Surface, cx - iDrawWdt, cy - iDrawHgt, iDrawWdt * 2, iDrawHgt * 2, iPhase, 0, r);
-		else
-			pDef->Gfx.DrawX(cgo.Surface, cx - iDrawWdt, cy - iDrawHgt, iDrawWdt * 2, iDrawHgt * 2, iPhase, 0);
-		Application.DDraw->ResetBlitMode();
-		Application.DDraw->RestorePrimaryClipper();
-		Application.DDraw->DeactivateBlitModulation();
+	// get rotation
+	int32_t r = 0;
+	if ((pDef->RByV == 1) || (pDef->RByV == 2)) // rotation by direction
+		r = Angle(0, 0, static_cast<int32_t>(dxdir * 10.0f), static_cast<int32_t>(dydir * 10.0f)) * 100;
+	if (pDef->RByV == 3) // random rotation - currently a pseudo random rotation by x/y position
+		r = (static_cast<int32_t>(pPrt->x * 23 + pPrt->y * 12) % 360) * 100;
+	// draw at pos
+	Application.DDraw->ActivateBlitModulation(pPrt->b);
+	int32_t iDrawWdt = int32_t(pPrt->a);
+	int32_t iDrawHgt = int32_t(pDef->Aspect * iDrawWdt);
+	if (r)
+		pDef->Gfx.DrawXR(cgo.Surface, cx - iDrawWdt, cy - iDrawHgt, iDrawWdt * 2, iDrawHgt * 2, iPhase, 0, r);
+	else
+		pDef->Gfx.DrawX(cgo.Surface, cx - iDrawWdt, cy - iDrawHgt, iDrawWdt * 2, iDrawHgt * 2, iPhase, 0);
+}
+
+void fxStdDraw(C4Particle *pPrt, C4FacetEx &cgo, C4Object *pTarget)
+{
+	fxStdDrawBatch(pPrt, 1, cgo, pTarget);
+}
+
+void fxStdDrawBatch(C4Particle *pPrt, size_t iCount, C4FacetEx &cgo, C4Object *pTarget)
+{
+	if (!iCount) return;
+	// get def
+	C4ParticleDef *pDef = pPrt->pDef;
+	// apply parallaxity to target pos
+	int32_t tx = cgo.TargetX * pDef->Parallaxity[0] / 100;
+	int32_t ty = cgo.TargetY * pDef->Parallaxity[1] / 100;
+	// clipper and blit mode are the same for all particles of the def
+	Application.DDraw->StorePrimaryClipper();
+	Application.DDraw->SubPrimaryClipper(cgo.X - tx, cgo.Y - ty + pDef->YOff, 100000, 100000);
+	if (pDef->Additive) lpDDraw->SetBlitMode(C4GFXBLIT_ADDITIVE);
+	for (size_t i = 0; i < iCount; ++i)
+		fxStdDrawParticle(&pPrt[i], pDef, cgo, tx, ty, pTarget);
+	Application.DDraw->ResetBlitMode();
+	Application.DDraw->RestorePrimaryClipper();
+	Application.DDraw->DeactivateBlitModulation();
 }
 
 C4ParticleProcRec C4ParticleProcMap[] =
 {
-	{ "SmokeInit", fxSmokeInit },
-	{ "SmokeExec", fxSmokeExec },
-	{ "StdInit",   fxStdInit },
-	{ "StdExec",   fxStdExec },
-	{ "Bounce",    fxBounce },
-	{ "BounceY",   fxBounceY },
-	{ "Stop",      fxStop },
-	{ "Die",       fxDie },
-	{ "",          nullptr }
+	{ "SmokeInit", fxSmokeInit, nullptr },
+	{ "SmokeExec", fxSmokeExec, nullptr },
+	{ "StdInit",   fxStdInit,   nullptr },
+	{ "StdExec",   fxStdExec,   fxStdExecBatch },
+	{ "Bounce",    fxBounce,    nullptr },
+	{ "BounceY",   fxBounceY,   nullptr },
+	{ "Stop",      fxStop,      nullptr },
+	{ "Die",       fxDie,       nullptr },
+	{ "",          nullptr,     nullptr }
 };
 
 C4ParticleDrawProcRec C4ParticleDrawProcMap[] =
 {
-	{ "Smoke", fxSmokeDraw },
-	{ "Std",   fxStdDraw },
-	{ "",      nullptr }
+	{ "Smoke", fxSmokeDraw, nullptr },
+	{ "Std",   fxStdDraw,   fxStdDrawBatch },
+	{ "",      nullptr,     nullptr }
 };
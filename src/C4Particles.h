@@ -32,11 +32,13 @@
 #include <C4Group.h>
 #include <C4Shape.h>
 
+#include <vector>
+
 // class predefs
 class C4ParticleDefCore;
 class C4ParticleDef;
 class C4Particle;
-class C4ParticleChunk;
+class C4ParticleBatch;
 class C4ParticleList;
 class C4ParticleSystem;
 
@@ -45,6 +47,8 @@ typedef C4ParticleProc C4ParticleInitProc; // particle init proc - init and retu
 typedef C4ParticleProc C4ParticleExecProc; // particle execution proc - returns whether particle died
 typedef C4ParticleProc C4ParticleCollisionProc; // particle collision proc - returns whether particle died
 typedef void(*C4ParticleDrawProc)(C4Particle *, C4FacetEx &, C4Object *); // particle drawing code
+typedef size_t(*C4ParticleBatchExecProc)(C4Particle *, size_t, C4Object *); // execution of consecutive particles of one def - moves survivors to the front and returns their number
+typedef void(*C4ParticleBatchDrawProc)(C4Particle *, size_t, C4FacetEx &, C4Object *); // drawing of consecutive particles of one def
 
 #define ParticleSystem Game.Particles
 
@@ -99,6 +103,8 @@ public:
 	C4ParticleExecProc      ExecProc;      // procedure used for execution of one particle
 	C4ParticleCollisionProc CollisionProc; // procedure called upon collision with the landscape; may be nullptr
 	C4ParticleDrawProc      DrawProc;      // procedure used for drawing of one particle
+	C4ParticleBatchExecProc BatchExecProc; // replaces ExecProc for whole batches; may be nullptr
+	C4ParticleBatchDrawProc BatchDrawProc; // replaces DrawProc for whole batches; may be nullptr
 
 	int32_t Count; // number of particles currently existent of this kind
 
@@ -112,74 +118,73 @@ public:
 };
 
 // one tiny little particle
-// note: list management done by the chunk, which spares one ptr here
-// the chunk initializes the values to zero here, too; so no ctors here...
+// particles are stored by value in the batches of their list, so pointers to them
+// only stay valid until particles are added to or removed from that list
 class C4Particle
 {
-protected:
-	C4Particle *pPrev, *pNext; // previous/next particle of the same list in the buffer
-
-	void MoveList(C4ParticleList &rFrom, C4ParticleList &rTo); // move from one list to another
-
 public:
 	C4ParticleDef *pDef; // kind of particle
 	float x, y, xdir, ydir; // position and movement
 	int32_t life; // lifetime remaining for this particle
 	float a; int32_t b; // all-purpose values
-
-	friend class C4ParticleChunk;
-	friend class C4ParticleList;
-	friend class C4ParticleSystem;
 };
 
-// one chunk of particles
-// linked list is managed by owner
-class C4ParticleChunk
+// all particles of one def in a list, kept contiguous so they can be executed and drawn in one go
+class C4ParticleBatch
 {
-protected:
-	C4ParticleChunk *pNext; // single linked list
-	C4Particle Data[C4Px_BufSize]; // the particles
-
 public:
-	C4ParticleChunk();
-	~C4ParticleChunk();
+	C4ParticleDef *pDef;
+	std::vector<C4Particle> Particles; // dead particles are removed in place, keeping the order
 
-	void Clear(); // clear all particles
+	C4ParticleBatch(C4ParticleDef *pDef) : pDef(pDef) {}
 
-	friend class C4ParticleSystem;
+	void Exec(C4Object *pObj);
+	void Draw(C4FacetEx &cgo, C4Object *pObj);
+	int32_t Remove(); // remove all particles; returns the number of removed particles
 };
 
 // a subset of particles
 class C4ParticleList
 {
-public:
-	C4Particle *pFirst; // first particle in list - others follow in linked list
+protected:
+	std::vector<C4ParticleBatch> Batches; // in order of first use; emptied batches are kept to reuse their memory
 
-	C4ParticleList() { pFirst = nullptr; }
+	C4ParticleBatch &GetBatch(C4ParticleDef *pOfDef); // get or add the batch of a def
 
+public:
 	void Exec(C4Object *pObj = nullptr); // execute all particles
 	void Draw(C4FacetEx &cgo, C4Object *pObj = nullptr); // draw all particles
-	void Clear(); // remove all particles
+	void Clear(); // remove all particles and free their memory
 	int32_t Remove(C4ParticleDef *pOfDef); // remove all particles of def
+	int32_t Push(C4ParticleDef *pOfDef, float dxdir, float dydir); // add movement to all particles of def
+
+	operator bool() const // checks whether list contains particles
+	{
+		for (const C4ParticleBatch &Batch : Batches)
+			if (!Batch.Particles.empty()) return true;
+		return false;
+	}
 
-	operator bool() { return !!pFirst; } // checks whether list contains particles
+	friend class C4ParticleSystem;
 };
 
 // the main particle system
 class C4ParticleSystem
 {
 protected:
-	C4ParticleChunk Chunk; // linked list for particle chunks
 	C4ParticleDef *pDef0, *pDefL; // linked list for particle defs
 
-	C4ParticleChunk *AddChunk(); // add a new chunk to the list
-
 	C4ParticleProc GetProc(const char *szName); // get init/exec proc for a particle type
 	C4ParticleDrawProc GetDrawProc(const char *szName); // get draw proc for a particle type
+	C4ParticleBatchExecProc GetBatchExecProc(const char *szName); // get batch exec proc for a particle type; may be nullptr
+	C4ParticleBatchDrawProc GetBatchDrawProc(const char *szName); // get batch draw proc for a particle type; may be nullptr
+
+	C4Particle *Add(C4ParticleDef *pOfDef, // create one particle regardless of the def's particle limit
+		float x, float y, float xdir, float ydir,
+		float a, int32_t b, C4ParticleList &rPxList, C4Object *pObj);
 
 public:
-	C4ParticleList FreeParticles; // list of free particles
-	C4ParticleList GlobalParticles; // list of free particles
+	C4ParticleList GlobalParticles; // list of particles not attached to an object
 
 	C4ParticleDef *pSmoke;  // default particle: smoke
 	C4ParticleDef *pBlast;  // default particle: blast
@@ -209,27 +214,31 @@ public:
 
 	bool IsFireParticleLoaded() { return pFire1 && pFire2; }
 
+	bool Benchmark(int32_t iCount, int32_t iFrames); // execute and draw iCount smoke and fire particles iFrames times and log the timings
+
 	friend class C4ParticleDef;
-	friend class C4Particle;
-	friend class C4ParticleChunk;
 };
 
 // default particle execution/drawing functions
 bool fxStdInit(C4Particle *pPrt, C4Object *pTarget);
 bool fxStdExec(C4Particle *pPrt, C4Object *pTarget);
 void fxStdDraw(C4Particle *pPrt, C4FacetEx &cgo, C4Object *pTarget);
+size_t fxStdExecBatch(C4Particle *pPrt, size_t iCount, C4Object *pTarget);
+void fxStdDrawBatch(C4Particle *pPrt, size_t iCount, C4FacetEx &cgo, C4Object *pTarget);
 
 // structures used for static function maps
 struct C4ParticleProcRec
 {
 	char Name[C4Px_MaxIDLen + 1]; // name of procedure
 	C4ParticleProc Proc; // procedure
+	C4ParticleBatchExecProc BatchExecProc; // procedure for whole batches, if the procedure is an exec proc that has one
 };
 
 struct C4ParticleDrawProcRec
 {
 	char Name[C4Px_MaxIDLen + 1]; // name of procedure
 	C4ParticleDrawProc Proc; // procedure
+	C4ParticleBatchDrawProc BatchProc; // procedure for whole batches; may be nullptr
 };
 
 extern C4ParticleProcRec C4ParticleProcMap[]; // particle init/execution function map
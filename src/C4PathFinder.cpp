@@ -46,6 +46,11 @@
 
 #include <C4FacetEx.h>
 #include <C4Game.h>
+#include <C4Random.h>
+#include <C4Wrappers.h>
+
+#include <array>
+#include <chrono>
 
 const int32_t C4PF_MaxDepth  = 35,
               C4PF_MaxCrawl  = 800,
@@ -532,6 +537,7 @@ void C4PathFinder::Default()
 	TransferZones = nullptr;
 	TransferZonesEnabled = true;
 	Level = 1;
+	NavigationGrid.reset();
 }
 
 void C4PathFinder::Clear()
@@ -558,10 +564,19 @@ void C4PathFinder::SetLevel(int iLevel)
 	Level = BoundBy(iLevel, 1, 10);
 }
 
+void C4PathFinder::SetNavigationGrid(bool fEnabled, int32_t iLandscapeWdt, int32_t iLandscapeHgt)
+{
+	if (fEnabled)
+		NavigationGrid = std::make_unique<C4NavigationGrid>(iLandscapeWdt, iLandscapeHgt, PointFree, TransferZones);
+	else
+		NavigationGrid.reset();
+}
+
 void C4PathFinder::Draw(C4FacetEx &cgo)
 {
 	if (TransferZones) TransferZones->Draw(cgo);
 	for (C4PathFinderRay *pRay = FirstRay; pRay; pRay = pRay->Next) pRay->Draw(cgo);
+	if (NavigationGrid) NavigationGrid->Draw(cgo);
 }
 
 void C4PathFinder::Run()
@@ -605,12 +620,22 @@ bool C4PathFinder::Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iT
 
 	// Parameter safety
 	if (!fnSetWaypoint) return false;
-	SetWaypoint = fnSetWaypoint;
-	WaypointParameter = iWaypointParameter;
 
 	// Start & target coordinates must be free
 	if (!PointFree(iFromX, iFromY) || !PointFree(iToX, iToY)) return false;
 
+	// Search on the navigation grid, if the scenario wants it
+	if (NavigationGrid)
+		return NavigationGrid->Find(iFromX, iFromY, iToX, iToY, Level, TransferZonesEnabled, fnSetWaypoint, iWaypointParameter);
+
+	return FindByRays(iFromX, iFromY, iToX, iToY, fnSetWaypoint, iWaypointParameter);
+}
+
+bool C4PathFinder::FindByRays(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter)
+{
+	SetWaypoint = fnSetWaypoint;
+	WaypointParameter = iWaypointParameter;
+
 	// Add the first two rays
 	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Left, nullptr)) return false;
 	if (!AddRay(iFromX, iFromY, iToX, iToY, 0, C4PF_Direction_Right, nullptr)) return false;
@@ -662,3 +687,55 @@ bool C4PathFinder::SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY)
 	pRay->X = iAtX; pRay->Y = iAtY;
 	return true;
 }
+
+static bool CountWaypoint(int32_t iX, int32_t iY, intptr_t iTransferTarget, intptr_t ipCount)
+{
+	++*reinterpret_cast<int32_t *>(ipCount);
+	return true;
+}
+
+bool C4PathFinder::Benchmark(int32_t iCount)
+{
+	if (!PointFree) return false;
+	// random pairs of free points
+	std::vector<std::array<int32_t, 4>> Points;
+	for (int32_t i = 0; i < iCount * 100 && static_cast<int32_t>(Points.size()) < iCount; ++i)
+	{
+		const std::array<int32_t, 4> Pair{SafeRandom(GBackWdt), SafeRandom(GBackHgt), SafeRandom(GBackWdt), SafeRandom(GBackHgt)};
+		if (PointFree(Pair[0], Pair[1]) && PointFree(Pair[2], Pair[3]))
+			Points.push_back(Pair);
+	}
+	if (Points.empty())
+	{
+		Log("Benchmark: No free points found");
+		return false;
+	}
+	const int iOldLevel = Level;
+	Level = 1;
+	const auto Run = [&Points](const char *szName, auto &&fnFind)
+	{
+		int32_t iFound = 0, iWaypoints = 0;
+		const auto Start = std::chrono::steady_clock::now();
+		for (const auto &Pair : Points)
+			if (fnFind(Pair[0], Pair[1], Pair[2], Pair[3], &CountWaypoint, reinterpret_cast<intptr_t>(&iWaypoints)))
+				++iFound;
+		const double dTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - Start).count();
+		LogF("Benchmark: %-18s %d/%d paths found, %d waypoints, %.1f ms (%.1f us/path)",
+			szName, iFound, static_cast<int32_t>(Points.size()), iWaypoints, dTime, dTime * 1000.0 / Points.size());
+	};
+	Run("Rays", [this](auto... Args) { Clear(); return FindByRays(Args...); });
+	// use the scenario's grid (and its cache) if there is one
+	std::unique_ptr<C4NavigationGrid> TempGrid;
+	C4NavigationGrid *pGrid = NavigationGrid.get();
+	if (!pGrid) pGrid = (TempGrid = std::make_unique<C4NavigationGrid>(GBackWdt, GBackHgt, PointFree, TransferZones)).get();
+	const auto FindOnGrid = [this, pGrid](int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, C4NavigationGrid::SetWaypointFn fnSetWaypoint, intptr_t iParameter)
+	{
+		return pGrid->Find(iFromX, iFromY, iToX, iToY, Level, TransferZonesEnabled, fnSetWaypoint, iParameter);
+	};
+	Run("Grid", FindOnGrid);
+	// the same searches again are answered from the cache
+	Run("Grid (again)", FindOnGrid);
+	Clear();
+	Level = iOldLevel;
+	return true;
+}
@@ -18,8 +18,11 @@
 
 #pragma once
 
+#include <C4NavigationGrid.h>
 #include <C4TransferZone.h>
 
+#include <memory>
+
 class C4PathFinderRay
 {
 	friend class C4PathFinder;
@@ -78,6 +81,7 @@ protected:
 	C4TransferZones *TransferZones;
 	bool TransferZonesEnabled;
 	int Level;
+	std::unique_ptr<C4NavigationGrid> NavigationGrid; // if set, paths are searched on the grid instead of by rays
 
 public:
 	void Draw(C4FacetEx &cgo);
@@ -87,8 +91,15 @@ public:
 	bool Find(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter);
 	void EnableTransferZones(bool fEnabled);
 	void SetLevel(int iLevel);
+	void SetNavigationGrid(bool fEnabled, int32_t iLandscapeWdt, int32_t iLandscapeHgt); // resets the grid
+	bool Benchmark(int32_t iCount); // search paths between random points with both methods and log the timings
+
+	// the landscape solidity has changed here
+	void InvalidatePoint(int32_t iX, int32_t iY) { if (NavigationGrid) NavigationGrid->InvalidatePoint(iX, iY); }
+	void InvalidateRect(const C4Rect &rRect) { if (NavigationGrid) NavigationGrid->InvalidateRect(rRect); }
 
 protected:
+	bool FindByRays(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, bool(*fnSetWaypoint)(int32_t, int32_t, intptr_t, intptr_t), intptr_t iWaypointParameter);
 	void Run();
 	bool AddRay(int32_t iFromX, int32_t iFromY, int32_t iToX, int32_t iToY, int32_t iDepth, int32_t iDirection, C4PathFinderRay *pFrom, C4TransferZone *pUseZone = nullptr);
 	bool SplitRay(C4PathFinderRay *pRay, int32_t iAtX, int32_t iAtY);
@@ -108,8 +108,16 @@ void C4RecordChunk::CompileFunc(StdCompiler *pComp)
 	}
 }
 
+void C4RecordKeyframe::CompileFunc(StdCompiler *pComp)
+{
+	pComp->Value(mkNamingAdapt(Frame,        "Frame"));
+	pComp->Value(mkNamingAdapt(CtrlRecPos,   "CtrlRecPos"));
+	pComp->Value(mkNamingAdapt(CtrlRecFrame, "CtrlRecFrame"));
+	pComp->Value(mkNamingAdapt(Filename,     "Filename"));
+}
+
 C4Record::C4Record()
-	: fRecording(false), fStreaming(false) {}
+	: fRecording(false), fStreaming(false), iCtrlRecPos(0), iLastCtrlPos(0), iLastCtrlFrame(0), iNextKeyframe(-1) {}
 
 C4Record::~C4Record() {}
 
@@ -170,6 +178,9 @@ bool C4Record::Start(bool fInitial)
 	fStreaming = false;
 	fRecording = true;
 	iLastFrame = 0;
+	iCtrlRecPos = iLastCtrlPos = iLastCtrlFrame = 0;
+	Keyframes.clear();
+	ScheduleKeyframe();
 	return true;
 }
 
@@ -223,6 +234,9 @@ bool C4Record::Rec(const C4Control &Ctrl, int iFrame)
 	C4Control Cpy; Cpy.Copy(Ctrl);
 	// prepare it for record
 	Cpy.PreRec(this);
+	// remember where it starts for keyframes taken during its execution
+	iLastCtrlPos = iCtrlRecPos;
+	iLastCtrlFrame = iLastFrame;
 	// record it
 	return Rec(iFrame, DecompileToBuf<StdCompilerBinWrite>(Cpy), RCT_Ctrl);
 }
@@ -252,6 +266,7 @@ bool C4Record::Rec(uint32_t iFrame, const StdBuf &sBuf, C4RecordChunkType eType)
 	// pack
 	CtrlRec.Write(&Head, sizeof(Head));
 	CtrlRec.Write(sBuf.getData(), sBuf.getSize());
+	iCtrlRecPos += sizeof(Head) + sBuf.getSize();
 #ifdef IMMEDIATEREC
 	// immediate rec: always flush
 	CtrlRec.Flush();
@@ -313,6 +328,34 @@ bool C4Record::AddFile(const char *szLocalFilename, const char *szAddAs, bool fD
 	return true;
 }
 
+void C4Record::ScheduleKeyframe()
+{
+	// the host synchronizes at multiples of the interval, so any synchronization from the next one on will do
+	const int32_t iInterval = Game.Parameters.KeyframeInterval;
+	iNextKeyframe = iInterval > 0 ? (Game.FrameCounter / iInterval + 1) * iInterval : -1;
+}
+
+bool C4Record::SaveKeyframe(bool fInControl)
+{
+	if (!fRecording) return false;
+	// schedule the next one in any case
+	ScheduleKeyframe();
+	// like for runtime records, a control that is being executed is executed again after loading the keyframe
+	C4RecordKeyframe Keyframe;
+	Keyframe.Frame = Game.FrameCounter;
+	Keyframe.CtrlRecPos = fInControl ? iLastCtrlPos : iCtrlRecPos;
+	Keyframe.CtrlRecFrame = fInControl ? iLastCtrlFrame : iLastFrame;
+	Keyframe.Filename.Format("Keyframe%d.c4s", Game.FrameCounter);
+	LogSilentF("Record: Saving keyframe (Frame %d)", Game.FrameCounter);
+	C4GameSaveRecord saveRec(false, Index, Game.Parameters.isLeague());
+	if (!saveRec.Save(FormatString("%s" DirSep "%s", sFilename.getData(), Keyframe.Filename.getData()).getData())) return false;
+	saveRec.Close();
+	// the index is rewritten every time, so it is complete even if the record is never stopped properly
+	Keyframes.push_back(Keyframe);
+	return DecompileToBuf<StdCompilerINIWrite>(mkNamingAdapt(mkSTLContainerAdapt(Keyframes), "Keyframe"))
+		.SaveToFile(FormatString("%s" DirSep C4CFN_RecKeyframes, sFilename.getData()).getData());
+}
+
 bool C4Record::StartStreaming(bool fInitial)
 {
 	if (!fRecording) return false;
@@ -390,9 +433,22 @@ bool C4Playback::Open(C4Group &rGrp)
 	fLoadSequential = false;
 	iLastSequentialFrame = 0;
 	bool fStrip = false;
+	// keyframe inside a record? Then the control is read from the record, starting at the keyframe
+	C4Group *pCtrlGrp = &rGrp, RecordGrp;
+	C4RecordKeyframe Keyframe; bool fKeyframe = false;
+	if (!rGrp.FindEntry(C4CFN_CtrlRec) && !rGrp.FindEntry(C4CFN_CtrlRecText) && rGrp.GetMother())
+	{
+		// the mother is busy reading the keyframe, so open the record separately
+		if (!RecordGrp.Open(rGrp.GetMother()->GetFullName().getData()) || !FindKeyframe(RecordGrp, GetFilename(rGrp.GetName()), &Keyframe))
+		{
+			LogFatal("Record: Keyframe not found in record index!");
+			return false;
+		}
+		pCtrlGrp = &RecordGrp; fKeyframe = true;
+	}
 	// get text record file
 	StdStrBuf TextBuf;
-	if (rGrp.LoadEntryString(C4CFN_CtrlRecText, TextBuf))
+	if (!fKeyframe && rGrp.LoadEntryString(C4CFN_CtrlRecText, TextBuf))
 	{
 		if (!ReadText(TextBuf))
 			return false;
@@ -402,12 +458,17 @@ bool C4Playback::Open(C4Group &rGrp)
 		// open group? Then do some sequential reading for large files
 		// Can't do this when a dump is forced, because the dump needs all data
 		// Also can't do this when stripping is desired
-		if (!rGrp.IsPacked()) if (!Game.RecordDumpFile.getLength()) if (!fStrip) fLoadSequential = true;
+		if (!pCtrlGrp->IsPacked()) if (!Game.RecordDumpFile.getLength()) if (!fStrip) fLoadSequential = true;
 		// get record file
 		if (fLoadSequential)
 		{
-			if (!rGrp.FindEntry(C4CFN_CtrlRec)) return false;
-			if (!playbackFile.Open(FormatString("%s%c%s", rGrp.GetFullName().getData(), DirectorySeparator, C4CFN_CtrlRec).getData())) return false;
+			if (!pCtrlGrp->FindEntry(C4CFN_CtrlRec)) return false;
+			if (!playbackFile.Open(FormatString("%s%c%s", pCtrlGrp->GetFullName().getData(), DirectorySeparator, C4CFN_CtrlRec).getData())) return false;
+			if (fKeyframe)
+			{
+				if (!playbackFile.Advance(Keyframe.CtrlRecPos)) return false;
+				iLastSequentialFrame = Keyframe.CtrlRecFrame;
+			}
 			// forcing first chunk to be read; will call ReadBinary
 			currChunk = chunks.end();
 			if (!NextSequentialChunk())
@@ -421,9 +482,19 @@ bool C4Playback::Open(C4Group &rGrp)
 		{
 			// non-sequential reading: Just read as a whole
 			StdBuf BinaryBuf;
-			if (rGrp.LoadEntry(C4CFN_CtrlRec, BinaryBuf))
+			if (pCtrlGrp->LoadEntry(C4CFN_CtrlRec, BinaryBuf))
 			{
-				if (!ReadBinary(BinaryBuf))
+				if (fKeyframe)
+				{
+					if (Keyframe.CtrlRecPos > BinaryBuf.getSize())
+					{
+						LogFatal("Record: Keyframe beyond end of control data!");
+						return false;
+					}
+					if (!ReadBinary(BinaryBuf.getPart(Keyframe.CtrlRecPos, BinaryBuf.getSize() - Keyframe.CtrlRecPos), Keyframe.CtrlRecFrame))
+						return false;
+				}
+				else if (!ReadBinary(BinaryBuf))
 					return false;
 			}
 			else
@@ -468,10 +539,10 @@ bool C4Playback::Open(C4Group &rGrp)
 	return true;
 }
 
-bool C4Playback::ReadBinary(const StdBuf &Buf)
+bool C4Playback::ReadBinary(const StdBuf &Buf, uint32_t iStartFrame)
 {
 	// sequential reading: Take over rest from last buffer
-	const StdBuf *pUseBuf; uint32_t iFrame = 0;
+	const StdBuf *pUseBuf; uint32_t iFrame = iStartFrame;
 	if (fLoadSequential)
 	{
 		sequentialBuffer.Append(Buf);
@@ -1171,3 +1242,36 @@ bool C4Playback::StreamToRecord(const char *szStream, StdStrBuf *pRecordFile)
 	pRecordFile->Copy(szRecord);
 	return true;
 }
+
+bool C4Playback::LoadKeyframes(C4Group &rRecordGrp, std::vector<C4RecordKeyframe> &rKeyframes)
+{
+	StdStrBuf Buf;
+	if (!rRecordGrp.LoadEntryString(C4CFN_RecKeyframes, Buf)) return false;
+	return CompileFromBuf_LogWarn<StdCompilerINIRead>(mkNamingAdapt(mkSTLContainerAdapt(rKeyframes), "Keyframe"), Buf, C4CFN_RecKeyframes);
+}
+
+bool C4Playback::FindKeyframe(C4Group &rRecordGrp, int32_t iFrame, C4RecordKeyframe *pKeyframe)
+{
+	std::vector<C4RecordKeyframe> Keyframes;
+	if (!LoadKeyframes(rRecordGrp, Keyframes)) return false;
+	const C4RecordKeyframe *pBest = nullptr;
+	for (const auto &Keyframe : Keyframes)
+		if (Keyframe.Frame <= iFrame && (!pBest || Keyframe.Frame > pBest->Frame))
+			pBest = &Keyframe;
+	if (!pBest) return false;
+	*pKeyframe = *pBest;
+	return true;
+}
+
+bool C4Playback::FindKeyframe(C4Group &rRecordGrp, const char *szFilename, C4RecordKeyframe *pKeyframe)
+{
+	std::vector<C4RecordKeyframe> Keyframes;
+	if (!LoadKeyframes(rRecordGrp, Keyframes)) return false;
+	for (const auto &Keyframe : Keyframes)
+		if (SEqualNoCase(Keyframe.Filename.getData(), szFilename))
+		{
+			*pKeyframe = Keyframe;
+			return true;
+		}
+	return false;
+}
@@ -24,6 +24,8 @@ class C4Record;
 #include "C4Group.h"
 #include "C4Control.h"
 
+#include <vector>
+
 #ifdef DEBUGREC
 extern int DoNoDebugRec; // debugrec disable counter in C4Record.cpp
 
@@ -246,6 +248,17 @@ public:
 	virtual void CompileFunc(StdCompiler *pComp) override;
 };
 
+// savegame inside a record to start playback from, and where the control continues
+struct C4RecordKeyframe
+{
+	int32_t Frame;
+	uint32_t CtrlRecPos; // offset in CtrlRec of the first control chunk to execute after loading
+	uint32_t CtrlRecFrame; // frame of the chunk before that; chunk frames are relative
+	StdStrBuf Filename; // entry in the record group
+
+	void CompileFunc(StdCompiler *pComp);
+};
+
 class C4Record // demo recording
 {
 private:
@@ -257,6 +270,12 @@ private:
 	bool fStreaming; // perdiodically sent new control to server
 	unsigned int iStreamingPos; // Position of current buffer in stream
 	StdBuf StreamingData; // accumulated control data since last stream sync
+	uint32_t iCtrlRecPos; // bytes written to CtrlRec
+	uint32_t iLastCtrlPos, iLastCtrlFrame; // CtrlRec position and frame before the last control chunk
+	int32_t iNextKeyframe; // frame from which on a keyframe is due; -1 if disabled
+	std::vector<C4RecordKeyframe> Keyframes;
+
+	void ScheduleKeyframe();
 
 public:
 	C4Record(); // creates control file etc
@@ -275,6 +294,9 @@ public:
 
 	bool AddFile(const char *szLocalFilename, const char *szAddAs, bool fDelete = false);
 
+	bool IsKeyframeDue(int32_t iFrame) const { return iNextKeyframe >= 0 && iFrame >= iNextKeyframe; }
+	bool SaveKeyframe(bool fInControl); // must be called while the game is synchronizing
+
 	bool StartStreaming(bool fInitial);
 	void ClearStreamingBuf(unsigned int iAmount);
 	void StopStreaming();
@@ -305,7 +327,7 @@ public:
 	~C4Playback();
 
 	bool Open(C4Group &rGrp);
-	bool ReadBinary(const StdBuf &Buf);
+	bool ReadBinary(const StdBuf &Buf, uint32_t iStartFrame = 0);
 	bool ReadText(const StdStrBuf &Buf);
 	void NextChunk(); // point to next prepared chunk in mem or read it
 	bool NextSequentialChunk(); // read from seq file until a new chunk has been filled
@@ -319,4 +341,9 @@ public:
 	void DebugRecError(const char *szError);
 #endif
 	static bool StreamToRecord(const char *szStream, StdStrBuf *pRecord);
+	static bool FindKeyframe(C4Group &rRecordGrp, int32_t iFrame, C4RecordKeyframe *pKeyframe); // last keyframe at or before iFrame
+	static bool FindKeyframe(C4Group &rRecordGrp, const char *szFilename, C4RecordKeyframe *pKeyframe);
+
+private:
+	static bool LoadKeyframes(C4Group &rRecordGrp, std::vector<C4RecordKeyframe> &rKeyframes);
 };
@@ -0,0 +1,117 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// replays a record as fast as possible without graphics and reports engine performance
+
+#include <C4Include.h>
+#include <C4ReplayBenchmark.h>
+
+#include <C4Application.h>
+#include <C4Game.h>
+#include <C4Log.h>
+#include <C4Stat.h>
+
+#include <algorithm>
+#include <vector>
+
+#ifdef _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace
+{
+	// peak resident memory of the process in KiB; 0 if unknown
+	uint64_t GetPeakMemoryUsage()
+	{
+#ifdef _WIN32
+		PROCESS_MEMORY_COUNTERS Counters;
+		if (GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)))
+			return Counters.PeakWorkingSetSize / 1024;
+#else
+		rusage Usage;
+		if (!getrusage(RUSAGE_SELF, &Usage))
+#ifdef __APPLE__
+			return Usage.ru_maxrss / 1024; // bytes
+#else
+			return Usage.ru_maxrss;
+#endif
+#endif
+		return 0;
+	}
+}
+
+C4ReplayBenchmark::C4ReplayBenchmark()
+	: fStarted(false), fFinished(false), fSucceeded(false), iStartFrame(0) {}
+
+bool C4ReplayBenchmark::Start()
+{
+	fStarted = true;
+	if (!Game.Control.isReplay())
+	{
+		LogFatal("Benchmark: Scenario is not a record!");
+		return false;
+	}
+	LogF("Benchmark: Replaying %s...", Game.ScenarioFilename);
+	// nobody is there to unpause
+	Game.HaltCount = 0;
+	// phase totals only; per-definition timing would distort the results
+	Game.FrameProfiler.Start(false);
+	C4ST_RESET
+	iStartFrame = Game.FrameCounter;
+	StartTime = std::chrono::steady_clock::now();
+	return true;
+}
+
+bool C4ReplayBenchmark::Execute()
+{
+	if (!fStarted && !Start()) return false;
+	Game.Execute();
+	// the game may already have quit the application at the end of the replay
+	if (!Game.IsRunning || Game.GameOver || !Game.Control.isReplay()) return false;
+	// next frame right away
+	Application.NextTick(false);
+	return true;
+}
+
+void C4ReplayBenchmark::Finish()
+{
+	if (fFinished) return;
+	fFinished = true;
+	if (!Game.FrameProfiler.IsActive()) return; // not started
+	const double dDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - StartTime).count();
+	const int32_t iFrames = Game.FrameCounter - iStartFrame;
+	LogF("Benchmark: %d frames in %.3f s (%.1f frames/s)", iFrames, dDuration, dDuration > 0 ? iFrames / dDuration : 0.0);
+	// execution phases, most expensive first
+	std::vector<C4FrameProfiler::PhaseTotal> Totals(Game.FrameProfiler.GetPhaseTotals());
+	std::stable_sort(Totals.begin(), Totals.end(), [](const auto &a, const auto &b) { return a.Duration > b.Duration; });
+	for (const auto &Total : Totals)
+		LogF("Benchmark:   %-16s %10.1f ms %8.1f us/frame", Total.Name, Total.Duration / 1000.0, iFrames ? static_cast<double>(Total.Duration) / iFrames : 0.0);
+	Game.FrameProfiler.Stop();
+	C4ST_SHOWSTAT
+	LogF("Benchmark: Peak memory usage: %llu KiB", static_cast<unsigned long long>(GetPeakMemoryUsage()));
+	// sync state at the end, to compare runs of different builds
+	C4ControlSyncCheck SyncCheck;
+	SyncCheck.Set();
+	LogF("Benchmark: Final state: %s", SyncCheck.GetSummary().getData());
+	if (Game.Control.SyncLossFrame >= 0)
+		LogF("Benchmark: FAILED - synchronization loss in frame %d (%d sync checks passed)", Game.Control.SyncLossFrame, Game.Control.SyncChecksPassed);
+	else
+	{
+		LogF("Benchmark: OK - %d sync checks passed", Game.Control.SyncChecksPassed);
+		fSucceeded = true;
+	}
+}
@@ -0,0 +1,40 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2017-2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// replays a record as fast as possible without graphics and reports engine performance
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+class C4ReplayBenchmark
+{
+public:
+	C4ReplayBenchmark();
+
+private:
+	bool fStarted, fFinished, fSucceeded;
+	int32_t iStartFrame;
+	std::chrono::steady_clock::time_point StartTime;
+
+public:
+	bool Execute(); // execute the next frame; returns false once the replay is over
+	void Finish(); // log results
+	bool Succeeded() const { return fSucceeded; } // replay ran to its end without sync loss
+
+private:
+	bool Start();
+};
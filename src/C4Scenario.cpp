@@ -319,6 +319,8 @@ void C4SLandscape::Default()
 	NewStyleLandscape = 0;
 	FoWRes = CClrModAddMap::iDefResolutionX;
 	ShadeMaterials = true;
+	MaxPXS = C4S_DefaultMaxPXS;
+	PathFinder = C4S_PathFinder_Rays;
 }
 
 void C4SLandscape::GetMapSize(int32_t &rWdt, int32_t &rHgt, int32_t iPlayerNum)
@@ -364,6 +366,8 @@ void C4SLandscape::CompileFunc(StdCompiler *pComp, bool newScenario)
 	pComp->Value(mkNamingAdapt(NewStyleLandscape,         "NewStyleLandscape", 0));
 	pComp->Value(mkNamingAdapt(FoWRes,                    "FoWRes",            static_cast<int32_t>(CClrModAddMap::iDefResolutionX)));
 	pComp->Value(mkNamingAdapt(ShadeMaterials,            "ShadeMaterials",    newScenario));
+	pComp->Value(mkNamingAdapt(MaxPXS,                    "MaxPXS",            C4S_DefaultMaxPXS));
+	pComp->Value(mkNamingAdapt(PathFinder,                "PathFinder",        C4S_PathFinder_Rays));
 }
 
 void C4SWeather::Default()
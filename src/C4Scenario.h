@@ -189,6 +189,15 @@ const int32_t C4S_NoGoal      = 0,
 
 const int32_t C4S_MaxMapPlayerExtend = 4;
 
+// Default pixel sprite budget
+
+const int32_t C4S_DefaultMaxPXS = 10000;
+
+// Path search methods
+
+const int32_t C4S_PathFinder_Rays = 0, // crawling rays along the landscape
+              C4S_PathFinder_Grid = 1; // A* on a grid of landscape cells
+
 class C4SPlrStart
 {
 public:
@@ -240,6 +249,8 @@ public:
 	int32_t NewStyleLandscape; // if set to 2, the landscape uses up to 125 mat/texture pairs
 	int32_t FoWRes; // chunk size of FoGOfWar
 	bool ShadeMaterials;
+	int32_t MaxPXS; // maximum number of pixel sprites
+	int32_t PathFinder; // path search method
 
 public:
 	void Default();
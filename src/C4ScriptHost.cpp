@@ -24,6 +24,9 @@
 #include <C4Object.h>
 #include <C4Wrappers.h>
 
+#include <algorithm>
+#include <iterator>
+
 // C4ScriptHost
 
 C4ScriptHost::C4ScriptHost() { Default(); }
@@ -185,9 +188,42 @@ const char *C4ScriptHost::GetControlDesc(const char *szFunctionFormat, int32_t i
 
 // C4DefScriptHost
 
+namespace
+{
+	// function names of C4ObjectCallback
+	const char *const ObjectCallbackNames[] =
+	{
+		PSF_Construction,
+		PSF_Destruction,
+		PSF_Hit,
+		PSF_Hit2,
+		PSF_Hit3,
+		PSF_Damage,
+		PSF_Entrance,
+		PSF_Departure,
+		PSF_RejectEntrance,
+		PSF_RejectCollection,
+		PSF_Collection,
+		PSF_Stuck,
+		PSF_RejectFight,
+		PSF_QueryCatchBlow,
+		PSF_CatchBlow,
+		"~ContactLeft",
+		"~ContactRight",
+		"~ContactTop",
+		"~ContactBottom",
+		"~ContactCenter"
+	};
+	static_assert(std::size(ObjectCallbackNames) == OCB_Count, "missing callback name");
+}
+
+uint32_t C4DefScriptHost::CallbackHits[OCB_Count];
+uint32_t C4DefScriptHost::CallbackMisses[OCB_Count];
+
 void C4DefScriptHost::Default()
 {
 	C4ScriptHost::Default();
+	std::fill(std::begin(Callbacks), std::end(Callbacks), nullptr);
 	SFn_CalcValue = SFn_SellTo = SFn_ControlTransfer = SFn_CustomComponents = nullptr;
 	ControlMethod[0] = ControlMethod[1] = ContainedControlMethod[0] = ContainedControlMethod[1] = ActivationControlMethod[0] = ActivationControlMethod[1] = 0;
 }
@@ -196,6 +232,8 @@ void C4DefScriptHost::AfterLink()
 {
 	C4AulScript::AfterLink();
 	// Search cached functions
+	for (int32_t i = 0; i < OCB_Count; ++i)
+		Callbacks[i] = GetSFunc(ObjectCallbackNames[i]);
 	char WhereStr[C4MaxName + 18];
 	SFn_CalcValue        = GetSFunc(PSF_CalcValue,           AA_PROTECTED);
 	SFn_SellTo           = GetSFunc(PSF_SellTo,              AA_PROTECTED);
@@ -220,6 +258,32 @@ void C4DefScriptHost::AfterLink()
 	GetControlMethodMask(PSF_Activate,         ActivationControlMethod[0], ActivationControlMethod[1]);
 }
 
+void C4DefScriptHost::UnLink()
+{
+	// functions might be deleted or replaced until the next AfterLink
+	std::fill(std::begin(Callbacks), std::end(Callbacks), nullptr);
+	C4ScriptHost::UnLink();
+}
+
+void C4DefScriptHost::LogCallbackStats()
+{
+	uint64_t iTotalHits = 0, iTotalCalls = 0;
+	for (int32_t i = 0; i < OCB_Count; ++i)
+	{
+		const uint64_t iCalls = uint64_t{CallbackHits[i]} + CallbackMisses[i];
+		if (!iCalls) continue;
+		LogF("%-24s %10llu calls, %3d%% defined", ObjectCallbackNames[i] + 1, static_cast<unsigned long long>(iCalls), static_cast<int>(uint64_t{CallbackHits[i]} * 100 / iCalls));
+		iTotalHits += CallbackHits[i]; iTotalCalls += iCalls;
+	}
+	LogF("%-24s %10llu calls, %3d%% defined", "Total", static_cast<unsigned long long>(iTotalCalls), static_cast<int>(iTotalCalls ? iTotalHits * 100 / iTotalCalls : 0));
+}
+
+void C4DefScriptHost::ResetCallbackStats()
+{
+	std::fill(std::begin(CallbackHits), std::end(CallbackHits), 0);
+	std::fill(std::begin(CallbackMisses), std::end(CallbackMisses), 0);
+}
+
 // C4GameScriptHost
 
 C4GameScriptHost::C4GameScriptHost() : Counter(0), Go(false) {}
@@ -22,6 +22,34 @@
 
 #include <C4Aul.h>
 
+#include <cstdint>
+
+// engine callbacks into object scripts that are looked up once per definition after linking
+enum C4ObjectCallback
+{
+	OCB_Construction = 0,
+	OCB_Destruction,
+	OCB_Hit,
+	OCB_Hit2,
+	OCB_Hit3,
+	OCB_Damage,
+	OCB_Entrance,
+	OCB_Departure,
+	OCB_RejectEntrance,
+	OCB_RejectCollection,
+	OCB_Collection,
+	OCB_Stuck,
+	OCB_RejectFight,
+	OCB_QueryCatchBlow,
+	OCB_CatchBlow,
+	OCB_ContactLeft,
+	OCB_ContactRight,
+	OCB_ContactTop,
+	OCB_ContactBottom,
+	OCB_ContactCenter,
+	OCB_Count
+};
+
 // generic script host for objects
 class C4ScriptHost : public C4AulScript, public C4ComponentHost
 {
@@ -69,8 +97,25 @@ public:
 
 	bool Delete() override { return false; } // do NOT delete this - it's just a class member!
 
+	// call an engine callback of pObj without looking up its name
+	C4Value ObjectCallback(C4Object *pObj, C4ObjectCallback eCallback, const C4AulParSet &pPars = C4AulParSet{}, bool fPassError = false)
+	{
+		C4AulScriptFunc *pFn = Callbacks[eCallback];
+		if (!pFn) { ++CallbackMisses[eCallback]; return C4VNull; }
+		++CallbackHits[eCallback];
+		return pFn->Exec(pObj, pPars, fPassError);
+	}
+
+	// calls of each callback that did or did not find a script function, over all definitions
+	static uint32_t CallbackHits[OCB_Count], CallbackMisses[OCB_Count];
+	static void LogCallbackStats();
+	static void ResetCallbackStats();
+
 protected:
+	C4AulScriptFunc *Callbacks[OCB_Count]; // resolved engine callbacks; nullptr if the script does not define them
+
 	void AfterLink() override; // get common funcs
+	void UnLink() override;
 
 public:
 	C4AulScriptFunc *SFn_CalcValue; // get object value
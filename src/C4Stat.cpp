@@ -142,7 +142,11 @@ void C4MainStat::Show()
 		pAkt = StatArray[i];
 
 		// output it!
-		if (pAkt->iCount)
+		if (pAkt->iValueSum)
+			fprintf(StatFile, "%s: n = %d, v = %u, vd = %.2f\n",
+				pAkt->strName, pAkt->iCount, pAkt->iValueSum,
+				double(pAkt->iValueSum) / pAkt->iCount);
+		else if (pAkt->iCount)
 			fprintf(StatFile, "%s: n = %d, t = %d, td = %.2f\n",
 				pAkt->strName, pAkt->iCount, pAkt->iTimeSum,
 				double(pAkt->iTimeSum) / std::max<int>(1, pAkt->iCount - 100) * 1000);
@@ -169,7 +173,10 @@ void C4MainStat::ShowPart()
 
 	// insert all stats
 	for (pAkt = pFirst; pAkt; pAkt = pAkt->pNext)
-		fprintf(StatFile, "%s: n=%d, t=%d\n", pAkt->strName, pAkt->iCountPart, pAkt->iTimeSumPart);
+		if (pAkt->iValueSumPart)
+			fprintf(StatFile, "%s: n=%d, v=%u\n", pAkt->strName, pAkt->iCountPart, pAkt->iValueSumPart);
+		else
+			fprintf(StatFile, "%s: n=%d, t=%d\n", pAkt->strName, pAkt->iCountPart, pAkt->iTimeSumPart);
 
 	// insert part stat end idtf
 	fprintf(StatFile, "** PartStat end\n");
@@ -221,6 +228,7 @@ void C4Stat::Reset()
 
 	iTimeSum = 0;
 	iCount = 0;
+	iValueSum = 0;
 
 	ResetPart();
 }
@@ -229,6 +237,7 @@ void C4Stat::ResetPart()
 {
 	iTimeSumPart = 0;
 	iCountPart = 0;
+	iValueSumPart = 0;
 }
 
 C4MainStat *C4Stat::getMainStat()
@@ -83,6 +83,15 @@ public:
 		}
 	}
 
+	// adds a sample to a value statistic (e.g. a per-frame count)
+	inline void Add(unsigned int iValue)
+	{
+		iCount++;
+		iCountPart++;
+		iValueSum += iValue;
+		iValueSumPart += iValue;
+	}
+
 	void Reset();
 	void ResetPart();
 
@@ -107,6 +116,9 @@ protected:
 	// number of starts called
 	unsigned int iCount;
 
+	// sum of added values
+	unsigned int iValueSum;
+
 	// ** statistic data (partial stat)
 
 	// sum of times
@@ -115,6 +127,9 @@ protected:
 	// number of starts called
 	unsigned int iCountPart;
 
+	// sum of added values
+	unsigned int iValueSumPart;
+
 	// name of statistic
 	const char *strName;
 };
@@ -134,6 +149,9 @@ protected:
 // used to stop an existing C4Stat object
 #define C4ST_STOP(StatName) StatName.Stop();
 
+// used to add a sample to an existing C4Stat object
+#define C4ST_ADD(StatName, iValue) StatName.Add(iValue);
+
 // shows the statistic (to log)
 #define C4ST_SHOWSTAT C4Stat::getMainStat()->Show();
 
@@ -152,6 +170,7 @@ protected:
 #define C4ST_NEW(StatName, strName)
 #define C4ST_START(StatName)
 #define C4ST_STOP(StatName)
+#define C4ST_ADD(StatName, iValue)
 #define C4ST_SHOWSTAT
 #define C4ST_SHOWPARTSTAT
 #define C4ST_RESET
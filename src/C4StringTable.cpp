@@ -22,6 +22,10 @@
 #include <C4Group.h>
 #include <C4Components.h>
 #include <C4Aul.h>
+#include <C4Log.h>
+
+#include <chrono>
+#include <vector>
 
 // *** C4String
 
@@ -79,12 +83,15 @@ void C4String::Reg(C4StringTable *pnTable)
 	pnTable->Last = this;
 
 	pTable = pnTable;
+	pTable->AddToIndex(this);
 }
 
 void C4String::UnReg()
 {
 	if (!pTable) return;
 
+	pTable->RemoveFromIndex(this);
+
 	if (Next)
 		Next->Prev = Prev;
 	else
@@ -105,7 +112,7 @@ void C4String::UnReg()
 // *** C4StringTable
 
 C4StringTable::C4StringTable()
-	: First(nullptr), Last(nullptr) {}
+	: First(nullptr), Last(nullptr), EnumIndexDirty(false) {}
 
 C4StringTable::~C4StringTable()
 {
@@ -116,19 +123,86 @@ C4StringTable::~C4StringTable()
 
 void C4StringTable::Clear()
 {
-	bool bContinue;
-	do
+	// unreg all hold strings
+	// (unreg may delete the string itself, but never touches its neighbours)
+	C4String *pNext;
+	for (C4String *pAct = First; pAct; pAct = pNext)
 	{
-		bContinue = false;
-		// find string to delete / unreg
-		for (C4String *pAct = First; pAct; pAct = pAct->Next)
-			if (pAct->Hold)
-			{
-				pAct->UnReg();
-				bContinue = true;
-				break;
-			}
-	} while (bContinue);
+		pNext = pAct->Next;
+		if (pAct->Hold)
+			pAct->UnReg();
+	}
+}
+
+void C4StringTable::AddToIndex(C4String *pString)
+{
+	Members.insert(pString);
+
+	pString->NextSame = pString->PrevSame = nullptr;
+	// strings without data never equal anything (see SEqual)
+	const char *szData = pString->Data.getData();
+	if (!szData) return;
+
+	const auto [it, fInserted] = ContentIndex.try_emplace(std::string_view{szData}, SameList{pString, pString});
+	if (!fInserted)
+	{
+		// new strings are always added to the tail of the table, so this keeps table order
+		SameList &rList = it->second;
+		pString->PrevSame = rList.Last;
+		rList.Last->NextSame = pString;
+		rList.Last = pString;
+	}
+}
+
+void C4StringTable::RemoveFromIndex(C4String *pString)
+{
+	Members.erase(pString);
+
+	if (pString->iEnumID > -1) EnumIndexDirty = true;
+
+	const char *szData = pString->Data.getData();
+	if (!szData) return;
+
+	const auto it = ContentIndex.find(std::string_view{szData});
+	if (it == ContentIndex.end()) return;
+	SameList &rList = it->second;
+
+	if (pString->NextSame)
+		pString->NextSame->PrevSame = pString->PrevSame;
+	else
+		rList.Last = pString->PrevSame;
+	if (pString->PrevSame)
+		pString->PrevSame->NextSame = pString->NextSame;
+	else
+	{
+		rList.First = pString->NextSame;
+		if (!rList.First)
+		{
+			ContentIndex.erase(it);
+		}
+		else
+		{
+			// the key views the removed string's data: rekey to the new list head
+			auto node = ContentIndex.extract(it);
+			node.key() = std::string_view{rList.First->Data.getData()};
+			ContentIndex.insert(std::move(node));
+		}
+	}
+	pString->NextSame = pString->PrevSame = nullptr;
+}
+
+void C4StringTable::UpdateEnumIndex()
+{
+	EnumIndex.clear();
+	for (C4String *pAct = First; pAct; pAct = pAct->Next)
+	{
+		const int iID = pAct->iEnumID;
+		if (iID < 0) continue;
+		if (static_cast<size_t>(iID) >= EnumIndex.size()) EnumIndex.resize(iID + 1, nullptr);
+		// first string in table order wins
+		if (!EnumIndex[iID]) EnumIndex[iID] = pAct;
+	}
+	EnumIndexDirty = false;
 }
 
 int C4StringTable::EnumStrings()
@@ -153,6 +227,7 @@ int C4StringTable::EnumStrings()
 			pAct->iEnumID = -1;
 		}
 	}
+	EnumIndexDirty = true;
 	return iCurrID;
 }
 
@@ -163,33 +238,28 @@ C4String *C4StringTable::RegString(const char *strString)
 
 C4String *C4StringTable::FindString(const char *strString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (SEqual(pAct->Data.getData(), strString))
-			return pAct;
-	return nullptr;
+	if (!strString) return nullptr;
+	const auto it = ContentIndex.find(std::string_view{strString});
+	return it != ContentIndex.end() ? it->second.First : nullptr;
 }
 
 C4String *C4StringTable::FindString(C4String *pString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (pAct == pString)
-			return pAct;
-	return nullptr;
+	return Members.count(pString) ? pString : nullptr;
 }
 
 C4String *C4StringTable::FindString(int iEnumID)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
-		if (pAct->iEnumID == iEnumID)
-			return pAct;
-	return nullptr;
+	if (iEnumID < 0) return nullptr;
+	if (EnumIndexDirty) UpdateEnumIndex();
+	return static_cast<size_t>(iEnumID) < EnumIndex.size() ? EnumIndex[iEnumID] : nullptr;
 }
 
 C4String *C4StringTable::FindSaveString(C4String *pString)
 {
-	for (C4String *pAct = First; pAct; pAct = pAct->Next)
+	for (C4String *pAct = FindString(pString->Data.getData()); pAct; pAct = pAct->NextSame)
 	{
-		if (SEqual(pAct->Data.getData(), pString->Data.getData()) && (!pAct->Hold || pAct->iRefCnt))
+		if (!pAct->Hold || pAct->iRefCnt)
 		{
 			return pAct;
 		}
@@ -215,6 +285,7 @@ bool C4StringTable::Load(C4Group &ParentGroup)
 			pnString = RegString(strBuf);
 		pnString->iEnumID = i;
 	}
+	EnumIndexDirty = true;
 	// delete data
 	delete[] pData;
 	return true;
@@ -263,3 +334,50 @@ bool C4StringTable::Save(C4Group &ParentGroup)
 	// write in group
 	return !!ParentGroup.Add(C4CFN_Strings, pData, iTableSize - 1, false, true);
 }
+
+void C4StringTable::Benchmark()
+{
+	using Clock = std::chrono::steady_clock;
+	for (const int32_t iSize : {1000, 10000, 100000})
+	{
+		C4StringTable Table;
+		// every fourth string has the contents of another one, like repeated script strings
+		std::vector<StdStrBuf> Contents(iSize);
+		for (int32_t i = 0; i < iSize; i++)
+			Contents[i].Format("BenchmarkString%d", (i % 4) ? i : i / 2);
+		std::vector<C4String *> Strings(iSize);
+		// register like C4AulParse and Load do it
+		Clock::time_point Start = Clock::now();
+		for (int32_t i = 0; i < iSize; i++)
+		{
+			C4String *pString = Table.FindString(Contents[i].getData());
+			if (!pString || (i % 4)) pString = Table.RegString(Contents[i].getData());
+			pString->IncRef();
+			Strings[i] = pString;
+		}
+		const Clock::duration RegTime = Clock::now() - Start;
+		// look up by contents and by pointer like C4Value denumeration does it
+		int64_t iFound = 0;
+		Start = Clock::now();
+		for (int32_t i = 0; i < iSize; i++)
+		{
+			iFound += Table.FindString(Contents[i].getData()) != nullptr;
+			iFound += Table.FindString(Strings[i]) != nullptr;
+		}
+		const Clock::duration FindTime = Clock::now() - Start;
+		// number for saving
+		Start = Clock::now();
+		const int iEnumCnt = Table.EnumStrings();
+		for (int32_t i = 0; i < iSize; i++)
+			iFound += Table.FindString(Strings[i]->iEnumID) != nullptr;
+		const Clock::duration EnumTime = Clock::now() - Start;
+		// release
+		Start = Clock::now();
+		for (C4String *pString : Strings)
+			pString->DecRef();
+		const Clock::duration ReleaseTime = Clock::now() - Start;
+		const auto PerString = [&](Clock::duration Time) { return std::chrono::duration<double, std::nano>(Time).count() / iSize; };
+		LogF("Benchmark: %6d strings: register %.1f ns/string, find %.1f ns/string, enumerate %.1f ns/string, release %.1f ns/string (%d saved, checksum %lld)",
+			iSize, PerString(RegTime), PerString(FindTime), PerString(EnumTime), PerString(ReleaseTime), iEnumCnt, static_cast<long long>(iFound));
+	}
+}
@@ -18,6 +18,11 @@
 
 #pragma once
 
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 class C4StringTable;
 class C4Group;
 
@@ -39,6 +44,7 @@ public:
 	int iEnumID;
 
 	C4String *Next, *Prev; // double-linked list
+	C4String *NextSame, *PrevSame; // double-linked list of strings with equal contents, in table order
 
 	C4StringTable *pTable; // owning table
 
@@ -65,5 +71,27 @@ public:
 	bool Load(C4Group &ParentGroup);
 	bool Save(C4Group &ParentGroup);
 
+	static void Benchmark(); // log registration, lookup and release speed for several table sizes
+
 	C4String *First, *Last; // string list
+
+private:
+	struct SameList
+	{
+		C4String *First, *Last;
+	};
+
+	// all strings with equal contents, keyed by a view into the first string's data
+	std::unordered_map<std::string_view, SameList> ContentIndex;
+	// all registered strings, to validate pointers
+	std::unordered_set<const C4String *> Members;
+	// first string in table order for each enum ID; rebuilt on demand
+	std::vector<C4String *> EnumIndex;
+	bool EnumIndexDirty;
+
+	void AddToIndex(C4String *pString);
+	void RemoveFromIndex(C4String *pString);
+	void UpdateEnumIndex();
+
+	friend class C4String;
 };
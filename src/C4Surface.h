@@ -26,6 +26,9 @@
 #endif
 
 #include <list>
+#include <memory>
+
+class StdBitmap;
 
 // config settings
 #define C4GFXCFG_NO_ALPHA_ADD    1
@@ -167,6 +170,8 @@ public:
 	bool SavePNG(C4Group &hGroup, const char *szFilename, bool fSaveAlpha = true, bool fApplyGamma = false, bool fSaveOverlayOnly = false);
 	bool Copy(C4Surface &fromSfc);
 	bool ReadPNG(CStdStream &hGroup);
+	bool ReadBitmap(const StdBitmap &rBitmap); // create from decoded image data
+	static std::unique_ptr<StdBitmap> DecodePNG(const void *pData, size_t iSize); // throws std::runtime_error; may be called from any thread
 	bool ReadJPEG(CStdStream &hGroup);
 
 private:
@@ -56,6 +56,7 @@ C4TransferZones::~C4TransferZones()
 void C4TransferZones::Default()
 {
 	First = nullptr;
+	Changes = 0;
 }
 
 void C4TransferZones::Clear()
@@ -63,6 +64,7 @@ void C4TransferZones::Clear()
 	C4TransferZone *pZone, *pNext;
 	for (pZone = First; pZone; pZone = pNext) { pNext = pZone->Next; delete pZone; }
 	First = nullptr;
+	++Changes;
 }
 
 void C4TransferZones::ClearPointers(C4Object *pObj)
@@ -83,6 +85,8 @@ bool C4TransferZones::Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	// Update existing zone
 	if (pZone = Find(pObj))
 	{
+		if (pZone->X == iX && pZone->Y == iY && pZone->Wdt == iWdt && pZone->Hgt == iHgt) return true;
+		++Changes;
 		pZone->X = iX; pZone->Y = iY;
 		pZone->Wdt = iWdt; pZone->Hgt = iHgt;
 	}
@@ -103,6 +107,7 @@ bool C4TransferZones::Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4
 	pZone->Object = pObj;
 	pZone->Next = First;
 	First = pZone;
+	++Changes;
 	// Success
 	return true;
 }
@@ -151,6 +156,7 @@ int32_t C4TransferZones::RemoveNullZones()
 		pNext = pZone->Next;
 		if (!pZone->Object)
 		{
+			++Changes;
 			delete pZone;
 			if (pPrev) pPrev->Next = pNext;
 			else First = pNext;
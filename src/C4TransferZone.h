@@ -53,6 +53,7 @@ public:
 protected:
 	int32_t RemoveNullZones();
 	C4TransferZone *First;
+	uint32_t Changes; // counts changes to the zones, so pathfinder results can be reused until a zone changes
 
 public:
 	void Default();
@@ -65,4 +66,5 @@ public:
 	C4TransferZone *Find(int32_t iX, int32_t iY);
 	bool Add(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
 	bool Set(int32_t iX, int32_t iY, int32_t iWdt, int32_t iHgt, C4Object *pObj);
+	uint32_t GetChanges() const { return Changes; }
 };
@@ -14,12 +14,23 @@
  * for the above references.
  */
 
+#include <C4Include.h>
 #include "C4ValueHash.h"
 #include "C4StringTable.h"
 
+#include <C4Log.h>
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
 #include <optional>
 #include <stdexcept>
 
+namespace
+{
+	bool KeyEqual(const C4Value &lhs, const C4Value &rhs) { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+}
+
 C4ValueHash::C4ValueHash() { }
 
 C4ValueHash::C4ValueHash(const C4ValueHash &other)
@@ -39,54 +50,119 @@ void C4ValueHash::CompileFunc(StdCompiler *pComp)
 
 void C4ValueHash::DenumeratePointers()
 {
-	for (auto [key, value] : *this)
+	for (uint32_t i = 0; i < entries.size(); ++i)
 	{
-		const_cast<C4Value &>(key).DenumeratePointer();
-		value.DenumeratePointer();
+		if (!entries[i].value) continue;
+		// keys of objects that do not exist anymore are set to nil, which removes the entry
+		entries[i].key.DenumeratePointer();
+		// this might remove the entry as well
+		if (entries[i].value) entries[i].value->DenumeratePointer();
 	}
+	// denumerated keys hash differently
+	for (auto &entry : entries)
+		if (entry.value) entry.hash = std::hash<C4Value>{}(entry.key);
+	rebuild(size(), true);
 }
 
-void C4ValueHash::removeValue(C4Value *value)
+uint32_t C4ValueHash::find(const C4Value &key, std::size_t hash) const
 {
-	bool found = false;
-	auto keyIt = map.end();
-	for (auto it = map.begin(); it != map.end(); )
+	if (index.empty()) return NoEntry;
+	const std::size_t mask = index.size() - 1;
+	for (std::size_t i = hash & mask; ; i = (i + 1) & mask)
 	{
-		if (&it->first == value)
-		{
-			keyIt = it;
-		}
-		else if (it->second.value == value)
+		const uint32_t entry = index[i];
+		if (entry == NoEntry) return NoEntry;
+		// removed entries stay in the index until the next rebuild
+		const MapEntry &e = entries[entry];
+		if (e.value && e.hash == hash && KeyEqual(e.key, key)) return entry;
+	}
+}
+
+void C4ValueHash::insertIndex(uint32_t entry)
+{
+	const std::size_t mask = index.size() - 1;
+	std::size_t i = entries[entry].hash & mask;
+	while (index[i] != NoEntry) i = (i + 1) & mask;
+	index[i] = entry;
+}
+
+void C4ValueHash::rebuild(std::size_t capacity, bool compact)
+{
+	// drop removed entries, keeping the order of the others
+	if (compact && removedCount)
+	{
+		uint32_t count = 0;
+		for (auto &entry : entries)
 		{
-			keyOrder.erase(it->second.keyOrderIterator);
-			map.erase(it++);
-			found = true;
-			continue;
+			if (!entry.value) continue;
+			if (&entries[count] != &entry)
+			{
+				// a nil key being assigned must not remove the entry that is overwritten
+				entries[count].value = nullptr;
+				entries[count] = entry;
+			}
+			entries[count].value->entry = count;
+			++count;
 		}
-		++it;
+		entries.erase(entries.begin() + count, entries.end());
+		removedCount = 0;
+		++compactions;
 	}
-	if (found) emptyValues.push_front(value);
-	if (keyIt != map.end()) map.erase(keyIt);
+	// keep the index at most two thirds full
+	capacity = std::max(capacity, entries.size());
+	std::size_t indexSize = 8;
+	while (indexSize * 2 < capacity * 3) indexSize *= 2;
+	index.assign(indexSize, NoEntry);
+	for (uint32_t i = 0; i < entries.size(); ++i)
+		if (entries[i].value) insertIndex(i);
+}
+
+void C4ValueHash::removeEntry(uint32_t entry)
+{
+	MapEntry &e = entries[entry];
+	e.value->entry = NoEntry;
+	emptyValues.push_back(e.value);
+	e.value = nullptr;
+	e.key.Set0();
+	++removedCount;
+}
+
+void C4ValueHash::removeValue(C4Value *value)
+{
+	// only keys and values of this map have it as their owning map
+	if (!entries.empty() && !std::less<const C4Value *>{}(value, &entries.front().key) && !std::less<const C4Value *>{}(&entries.back().key, value))
+	{
+		const auto entry = static_cast<uint32_t>((reinterpret_cast<const char *>(value) - reinterpret_cast<const char *>(&entries.front().key)) / sizeof(MapEntry));
+		assert(&entries[entry].key == value);
+		// removed entries have their key cleared as well
+		if (entries[entry].value) removeEntry(entry);
+		return;
+	}
+	const uint32_t entry = static_cast<MapValue *>(value)->entry;
+	if (entry != NoEntry) removeEntry(entry);
 }
 
 bool C4ValueHash::contains(const C4Value &key) const
 {
-	return map.find(key) != map.end();
+	return find(key, std::hash<C4Value>{}(key)) != NoEntry;
 }
 
 void C4ValueHash::clear()
 {
-	for (auto &[key, value] : map) delete value.value;
-	map.clear();
+	for (auto &entry : entries) delete entry.value;
+	entries.clear();
+	index.clear();
+	removedCount = 0;
+	++compactions;
 	for (auto &value : emptyValues) delete value;
 	emptyValues.clear();
 }
 
 C4ValueHash &C4ValueHash::operator=(const C4ValueHash &other)
 {
-	for (const auto key : other.keyOrder)
+	for (const auto &entry : other.entries)
 	{
-		(*this)[*key].Set(*other.map.at(*key).value);
+		if (entry.value) (*this)[entry.key].Set(*entry.value);
 	}
 	return *this;
 }
@@ -95,9 +171,9 @@ bool C4ValueHash::operator==(const C4ValueHash &other) const
 {
 	if (other.size() != size()) return false;
 
-	for (const auto &it : map)
+	for (const auto &entry : entries)
 	{
-		if (!other.contains(it.first) || other[it.first] != *it.second.value)
+		if (entry.value && (!other.contains(entry.key) || other[entry.key] != *entry.value))
 			return false;
 	}
 
@@ -111,83 +187,142 @@ bool C4ValueHash::hasIndex(const C4Value &key) const
 
 C4Value &C4ValueHash::operator[](const C4Value &key)
 {
-	try
+	const std::size_t hash = std::hash<C4Value>{}(key);
+	const uint32_t found = find(key, hash);
+	if (found != NoEntry) return *entries[found].value;
+
+	if ((entries.size() + 1) * 3 > index.size() * 2)
+		rebuild((size() + 1) * 2, true);
+
+	MapValue *value;
+	if (emptyValues.empty()) value = new MapValue(this);
+	else
 	{
-		return *map.at(key).value;
+		value = emptyValues.back();
+		emptyValues.pop_back();
+		// might have been changed through a reference after its removal
+		value->Set0();
 	}
-	catch (const std::out_of_range &)
-	{
-		C4Value *value;
-		if (emptyValues.empty()) value = C4Value::OfMap(this);
-		else
-		{
-			value = emptyValues.front();
-			emptyValues.pop_front();
-		}
 
-		const auto &inserted = map.emplace(std::piecewise_construct, std::forward_as_tuple(key, this), std::forward_as_tuple(MapEntry{value, {}})).first;
-		inserted->second.keyOrderIterator = keyOrder.insert(keyOrder.end(), &inserted->first);
-		return *value;
-	}
+	value->entry = static_cast<uint32_t>(entries.size());
+	entries.push_back(MapEntry{MapKey{key, this}, value, hash, nextSeq++});
+	insertIndex(value->entry);
+	return *value;
 }
 
 const C4Value &C4ValueHash::operator[](const C4Value &key) const
 {
-	try
-	{
-		return *map.at(key).value;
-	}
-	catch (const std::out_of_range &)
-	{
-		return C4VNull;
-	}
+	const uint32_t found = find(key, std::hash<C4Value>{}(key));
+	return found != NoEntry ? *entries[found].value : C4VNull;
 }
 
 C4ValueHash::Iterator C4ValueHash::begin()
 {
-	return Iterator(this, keyOrder.begin(), keyOrder.end());
+	return Iterator(this, 0);
 }
 
 C4ValueHash::Iterator C4ValueHash::end()
 {
-	return Iterator(this, keyOrder.end(), keyOrder.end());
+	return Iterator(this, entries.size());
 }
 
-C4ValueHash::Iterator::Iterator(C4ValueHash *map, C4ValueHash::Iterator::iterator_type it, C4ValueHash::Iterator::iterator_type end) : it(it), end(end), map(map)
+void C4ValueHash::Benchmark()
 {
-	update();
+	using Clock = std::chrono::steady_clock;
+	const int32_t iElements = 1000000; // per map size
+	for (const int32_t iSize : {10, 1000, 100000, 1000000})
+	{
+		Clock::duration InsertTime{}, LookupTime{}, IterateTime{};
+		int64_t iSum = 0;
+		for (int32_t iRound = 0; iRound < iElements / iSize; iRound++)
+		{
+			C4Value Map{new C4ValueHash()};
+			C4ValueHash &rMap = *Map._getMap();
+			Clock::time_point Start = Clock::now();
+			for (int32_t i = 0; i < iSize; i++)
+				rMap[C4VInt(i)].SetInt(i);
+			InsertTime += Clock::now() - Start;
+			Start = Clock::now();
+			for (int32_t i = 0; i < iSize; i++)
+				iSum += static_cast<const C4ValueHash &>(rMap)[C4VInt(i)]._getInt();
+			LookupTime += Clock::now() - Start;
+			Start = Clock::now();
+			for (auto [key, value] : rMap)
+				iSum += value._getInt();
+			IterateTime += Clock::now() - Start;
+		}
+		const auto PerElement = [&](Clock::duration Time) { return std::chrono::duration<double, std::nano>(Time).count() / iElements; };
+		LogF("Benchmark: %7d entry maps: insert %.1f ns/entry, lookup %.1f ns/entry, iterate %.1f ns/entry (checksum %lld)",
+			iSize, PerElement(InsertTime), PerElement(LookupTime), PerElement(IterateTime), static_cast<long long>(iSum));
+	}
 }
 
-void C4ValueHash::Iterator::update()
+C4ValueHash::Iterator::Iterator(C4ValueHash *map, std::size_t pos) : map(map), compactions(map->compactions)
 {
-	if (it != end)
-	{
-		current = std::make_unique<pair_type>(**it, (*map)[**it]);
-	}
-	else
-	{
-		current.reset();
-	}
+	setPos(pos);
+}
+
+C4ValueHash::Iterator::Iterator(const C4ValueHash::Iterator &other) : map(other.map), pos(other.pos), seq(other.seq), compactions(other.compactions) {}
+
+C4ValueHash::Iterator &C4ValueHash::Iterator::operator=(const C4ValueHash::Iterator &other)
+{
+	map = other.map;
+	pos = other.pos;
+	seq = other.seq;
+	compactions = other.compactions;
+	current.reset();
+	return *this;
+}
+
+std::size_t C4ValueHash::Iterator::syncedPos() const
+{
+	if (compactions == map->compactions) return pos;
+	// the first entry that was inserted at the same time or later
+	const auto it = std::lower_bound(map->entries.begin(), map->entries.end(), seq, [](const MapEntry &entry, uint64_t seq) { return entry.seq < seq; });
+	return it - map->entries.begin();
+}
+
+std::size_t C4ValueHash::Iterator::livePos() const
+{
+	std::size_t p = syncedPos();
+	while (p < map->entries.size() && !map->entries[p].value) ++p;
+	return p;
+}
+
+void C4ValueHash::Iterator::setPos(std::size_t newPos)
+{
+	pos = newPos;
+	compactions = map->compactions;
+	// past the end: the next entry to be inserted
+	seq = pos < map->entries.size() ? map->entries[pos].seq : map->nextSeq;
 }
 
 C4ValueHash::Iterator &C4ValueHash::Iterator::operator++()
 {
-	++it;
-	update();
+	const std::size_t p = syncedPos();
+	if (current)
+		// the current entry might have been removed since it was accessed, and compacted away
+		setPos(p < map->entries.size() && map->entries[p].seq == seq ? p + 1 : p);
+	else
+		setPos(livePos() + 1);
+	current.reset();
 	return *this;
 }
 
 C4ValueHash::Iterator::pair_type &C4ValueHash::Iterator::operator*()
 {
+	setPos(livePos());
+	auto &entry = map->entries[pos];
+	current.emplace(entry.key, *entry.value);
 	return *current;
 }
 
 bool C4ValueHash::Iterator::operator==(const C4ValueHash::Iterator &other) const
 {
-	return it == other.it;
+	return livePos() == other.livePos();
 }
 
 bool C4ValueHash::Iterator::operator!=(const C4ValueHash::Iterator &other) const
 {
-	return it != other.it;
+	return livePos() != other.livePos();
 }
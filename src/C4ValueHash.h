@@ -17,11 +17,13 @@
 #include "C4Value.h"
 #include "C4ValueStandardRefCountedContainer.h"
 
-#include <unordered_map>
-#include <forward_list>
-#include <list>
-#include <memory>
+#include <cstdint>
+#include <optional>
+#include <utility>
+#include <vector>
 
+// entries are stored in insertion order (which defines a network safe order),
+// with an open addressing index of entry numbers to find them by key
 class C4ValueHash : public C4ValueStandardRefCountedContainer<C4ValueHash>
 {
 public:
@@ -29,38 +31,66 @@ public:
 	using mapped_type = C4Value;
 
 private:
-	struct MapEntry
+	static constexpr uint32_t NoEntry = UINT32_MAX;
+
+	// values are allocated separately, so references to them stay valid when the entries are moved
+	class MapValue : public C4Value
+	{
+	public:
+		MapValue(C4ValueHash *map) { OwningMap = map; }
+
+		uint32_t entry = NoEntry;
+	};
+
+	// keys are owned by the map as well, so the entry is removed when an object key is cleared
+	class MapKey : public C4Value
 	{
-		C4Value *value;
-		std::list<const C4Value *>::iterator keyOrderIterator;
+	public:
+		MapKey(const C4Value &key, C4ValueHash *map) : C4Value(key, map) {}
+		MapKey(const MapKey &other) : C4Value(other, other.OwningMap) {}
+		MapKey &operator=(const MapKey &other) { C4Value::operator=(other); return *this; }
 	};
 
-	struct KeyEqual
+	struct MapEntry
 	{
-		bool operator()(const C4Value &lhs, const C4Value &rhs) const noexcept { return lhs.Equals(rhs, C4AulScriptStrict::MAXSTRICT); }
+		MapKey key;
+		MapValue *value; // nullptr if the entry has been removed
+		std::size_t hash;
+		uint64_t seq; // insertion number; entries are sorted by it
 	};
 
-	std::unordered_map<key_type, MapEntry, std::hash<key_type>, KeyEqual> map;
-	std::forward_list<C4Value *> emptyValues;
+	std::vector<MapEntry> entries;
+	std::vector<uint32_t> index; // entry numbers or NoEntry; size is a power of two
+	std::size_t removedCount = 0; // removed entries in entries
+	std::vector<MapValue *> emptyValues; // values can not be deleted while they are being set to nil
+	uint64_t nextSeq = 0;
+	uint32_t compactions = 0; // iterators find their position again by insertion number after a compaction
 
-	// we need a defined order for network sync
-	std::list<const C4Value *> keyOrder;
+	uint32_t find(const C4Value &key, std::size_t hash) const;
+	void insertIndex(uint32_t entry);
+	void rebuild(std::size_t capacity, bool compact);
+	void removeEntry(uint32_t entry);
 
 public:
 
 	class Iterator
 	{
 		using pair_type = std::pair<const C4Value &, C4Value &>;
-		using iterator_type = decltype(keyOrder.begin());
-		iterator_type it, end;
 		C4ValueHash *map;
-		std::unique_ptr<pair_type> current;
+		std::size_t pos;
+		uint64_t seq; // insertion number of the entry at pos
+		uint32_t compactions; // of the map when pos was valid
+		std::optional<pair_type> current;
 
-		void update();
+		std::size_t syncedPos() const; // pos, adjusted to compactions in the meantime
+		std::size_t livePos() const; // skip entries that have been removed in the meantime
+		void setPos(std::size_t newPos);
 
 	public:
-		Iterator(C4ValueHash *map, iterator_type it, iterator_type end);
+		Iterator(C4ValueHash *map, std::size_t pos);
+		Iterator(const Iterator &other);
 
+		Iterator &operator=(const Iterator &other);
 		Iterator &operator++();
 		pair_type &operator*();
 		bool operator==(const Iterator &other) const;
@@ -85,6 +115,8 @@ public:
 
 	bool contains(const C4Value &key) const;
 	void removeValue(C4Value *value);
-	auto size() const { return map.size(); }
+	auto size() const { return entries.size() - removedCount; }
 	void clear();
+
+	static void Benchmark(); // log insert, lookup and iteration speed for several map sizes
 };
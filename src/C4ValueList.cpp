@@ -17,22 +17,34 @@
 #include <C4Include.h>
 #include <C4ValueList.h>
 #include <algorithm>
+#include <chrono>
 #include <stdexcept>
 
 #include <C4Aul.h>
 #include <C4FindObject.h>
+#include <C4Log.h>
+
+namespace
+{
+	// empty an element and turn references to it into copies, as deleting it would
+	void ClearElement(C4Value &rValue)
+	{
+		C4Value Dead;
+		rValue.Move(&Dead);
+	}
+}
 
 C4ValueList::C4ValueList()
-	: iSize(0), pData(nullptr) {}
+	: iSize(0), iCapacity(InlineCapacity), pData(InlineData) {}
 
 C4ValueList::C4ValueList(int32_t inSize)
-	: iSize(0), pData(nullptr)
+	: iSize(0), iCapacity(InlineCapacity), pData(InlineData)
 {
 	SetSize(inSize);
 }
 
 C4ValueList::C4ValueList(const C4ValueList &ValueList2)
-	: iSize(0), pData(nullptr)
+	: iSize(0), iCapacity(InlineCapacity), pData(InlineData)
 {
 	SetSize(ValueList2.GetSize());
 	for (int32_t i = 0; i < iSize; i++)
@@ -41,8 +53,9 @@ C4ValueList::C4ValueList(const C4ValueList &ValueList2)
 
 C4ValueList::~C4ValueList()
 {
-	delete[] pData; pData = nullptr;
-	iSize = 0;
+	if (pData != InlineData) delete[] pData;
+	pData = nullptr;
+	iSize = iCapacity = 0;
 }
 
 C4ValueList &C4ValueList::operator=(const C4ValueList &ValueList2)
@@ -126,19 +139,36 @@ void C4ValueList::SetSize(int32_t inSize)
 	// bounds check
 	if (inSize > MaxSize) return;
 
+	// grow geometrically, so appending single elements does not copy the whole list every time
+	if (inSize > iCapacity)
+		Reserve((std::min<int32_t>)((std::max)(inSize, iCapacity * 2), MaxSize));
+	else
+		// reused elements might still be referenced from the time they were part of the list
+		for (int32_t i = iSize; i < inSize; i++) ClearElement(pData[i]);
+
+	iSize = inSize;
+}
+
+void C4ValueList::Reserve(int32_t inCapacity)
+{
+	if (inCapacity <= iCapacity) return;
+
 	// create new array (initialises)
-	C4Value *pnData = new C4Value[inSize];
+	C4Value *pnData = new C4Value[inCapacity];
 	if (!pnData) return;
 
-	// move existing values
+	// move existing values; this redirects references to them
 	int32_t i;
 	for (i = 0; i < iSize; i++)
 		pData[i].Move(&pnData[i]);
 
 	// replace
-	delete[] pData;
+	if (pData != InlineData)
+		delete[] pData;
+	else
+		for (i = iSize; i < InlineCapacity; i++) ClearElement(InlineData[i]);
 	pData = pnData;
-	iSize = inSize;
+	iCapacity = inCapacity;
 }
 
 bool C4ValueList::operator==(const C4ValueList &IntList2) const
@@ -152,7 +182,13 @@ bool C4ValueList::operator==(const C4ValueList &IntList2) const
 
 void C4ValueList::Reset()
 {
-	delete[] pData; pData = nullptr;
+	if (pData != InlineData)
+	{
+		delete[] pData; pData = InlineData;
+		iCapacity = InlineCapacity;
+	}
+	else
+		for (int32_t i = 0; i < InlineCapacity; i++) ClearElement(InlineData[i]);
 	iSize = 0;
 }
 
@@ -231,6 +267,33 @@ C4ValueArray *C4ValueArray::SetLength(int32_t size)
 	}
 }
 
+void C4ValueArray::Benchmark()
+{
+	using Clock = std::chrono::steady_clock;
+	const int32_t iElements = 1000000; // per array size
+	for (const int32_t iSize : {10, 1000, 100000})
+	{
+		Clock::duration AppendTime{}, IterateTime{};
+		int64_t iSum = 0;
+		for (int32_t iRound = 0; iRound < iElements / iSize; iRound++)
+		{
+			// append like AB_ARRAY_APPEND, read like AB_ARRAYA_V
+			C4Value Array{new C4ValueArray()};
+			C4ValueArray &rArray = *Array._getArray();
+			Clock::time_point Start = Clock::now();
+			for (int32_t i = 0; i < iSize; i++)
+				rArray[rArray.GetSize()].SetInt(i);
+			AppendTime += Clock::now() - Start;
+			Start = Clock::now();
+			for (int32_t i = 0; i < rArray.GetSize(); i++)
+				iSum += static_cast<const C4ValueArray &>(rArray).GetItem(i)._getInt();
+			IterateTime += Clock::now() - Start;
+		}
+		const auto PerElement = [&](Clock::duration Time) { return std::chrono::duration<double, std::nano>(Time).count() / iElements; };
+		LogF("Benchmark: %6d element arrays: append %.1f ns/element, iterate %.1f ns/element (checksum %lld)", iSize, PerElement(AppendTime), PerElement(IterateTime), static_cast<long long>(iSum));
+	}
+}
+
 bool C4ValueArray::hasIndex(const C4Value &index) const
 {
 	C4Value copyIndex = index;
@@ -25,6 +25,7 @@ class C4ValueList
 {
 public:
 	enum { MaxSize = 1000000, }; // ye shalt not create arrays larger than that!
+	enum { InlineCapacity = 4, }; // short lists do not allocate
 
 	C4ValueList();
 	C4ValueList(int32_t inSize);
@@ -35,7 +36,9 @@ public:
 
 protected:
 	int32_t iSize;
-	C4Value *pData;
+	int32_t iCapacity; // all elements up to here are constructed; the ones behind iSize are empty
+	C4Value *pData; // InlineData or allocated
+	C4Value InlineData[InlineCapacity];
 
 public:
 	int32_t GetSize() const { return iSize; }
@@ -50,6 +53,7 @@ public:
 
 	void Reset();
 	void SetSize(int32_t inSize); // (enlarge only!)
+	void Reserve(int32_t inCapacity);
 
 	void DenumeratePointers();
 
@@ -85,6 +89,8 @@ public:
 		C4ValueList::DenumeratePointers();
 	}
 
+	static void Benchmark(); // log append and iteration speed for several array sizes
+
 private:
 	// Only for IncRef/AddElementRef
 	friend C4ValueStandardRefCountedContainer<C4ValueArray>;
@@ -129,6 +129,8 @@ int WINAPI WinMain(HINSTANCE hInst,
 	Application.Clear();
 
 	// Return exit code
+	if (Application.ReplayBenchmark && !Application.ReplayBenchmark->Succeeded()) return C4XRV_Failure;
+	if (Application.BenchmarkFailed) return C4XRV_Failure;
 	return C4XRV_Completed;
 }
 
@@ -272,6 +274,8 @@ int main(int argc, char *argv[])
 	Application.Clear();
 	if (Application.restartAtEnd) restart(argv);
 	// Return exit code
+	if (Application.ReplayBenchmark && !Application.ReplayBenchmark->Succeeded()) return C4XRV_Failure;
+	if (Application.BenchmarkFailed) return C4XRV_Failure;
 	return C4XRV_Completed;
 }
 
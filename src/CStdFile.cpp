@@ -43,7 +43,7 @@ CStdFile::~CStdFile()
 	Close();
 }
 
-bool CStdFile::Create(const char *szFilename, bool fCompressed, bool fExecutable)
+bool CStdFile::Create(const char *szFilename, bool fCompressed, bool fExecutable, bool fSyncFlush)
 {
 	SCopy(szFilename, Name, _MAX_PATH);
 	// Set modes
@@ -53,7 +53,7 @@ bool CStdFile::Create(const char *szFilename, bool fCompressed, bool fExecutable
 	{
 		try
 		{
-			writeCompressedFile.reset(new StdGzCompressedFile::Write{szFilename});
+			writeCompressedFile.reset(new StdGzCompressedFile::Write{szFilename, fSyncFlush});
 		}
 		catch (const StdGzCompressedFile::Exception &)
 		{
@@ -287,12 +287,41 @@ bool CStdFile::Advance(size_t iOffset)
 		else
 		{
 			if (hFile) return !fseek(hFile, iOffset, SEEK_CUR); // uncompressed: Just skip
-			if (LoadBuffer() <= 0) return false; // compressed: Read...
+			if (readCompressedFile) return Seek(readCompressedFile->Tell() + iOffset); // compressed: skip known parts
+			return false;
 		}
 	}
 	return true;
 }
 
+bool CStdFile::Seek(size_t iPosition)
+{
+	if (ModeWrite) return false;
+	if (readCompressedFile)
+	{
+		// still in the buffer?
+		const size_t iBufferStart = readCompressedFile->Tell() - BufferLoad;
+		if (iPosition >= iBufferStart && iPosition <= iBufferStart + BufferLoad)
+		{
+			BufferPtr = iPosition - iBufferStart;
+			return true;
+		}
+		ClearBuffer();
+		try
+		{
+			readCompressedFile->Seek(iPosition);
+		}
+		catch (const StdGzCompressedFile::Exception &)
+		{
+			return false;
+		}
+		return true;
+	}
+	ClearBuffer();
+	if (hFile) return !fseek(hFile, iPosition, SEEK_SET);
+	return false;
+}
+
 bool CStdFile::Save(const char *szFilename, const uint8_t *bpBuf,
 	size_t iSize, bool fCompressed)
 {
@@ -53,7 +53,7 @@ protected:
 	bool ModeWrite;
 
 public:
-	bool Create(const char *szFileName, bool fCompressed = false, bool fExecutable = false);
+	bool Create(const char *szFileName, bool fCompressed = false, bool fExecutable = false, bool fSyncFlush = false); // fSyncFlush: see StdGzCompressedFile::Write
 	bool Open(const char *szFileName, bool fCompressed = false);
 	bool Append(const char *szFilename); // append (uncompressed only)
 	bool Close();
@@ -64,6 +64,7 @@ public:
 	bool WriteString(const char *szStr);
 	bool Rewind();
 	bool Advance(size_t iOffset) override;
+	bool Seek(size_t iPosition); // read mode only; compressed files seek through an index built while reading
 	// Single line commands
 	bool Load(const char *szFileName, uint8_t **lpbpBuf,
 		size_t *ipSize = nullptr, int iAppendZeros = 0,
@@ -811,6 +811,36 @@ struct StdIntPackAdapt
 template <class T>
 StdIntPackAdapt<T> mkIntPackAdapt(T &rVal) { return StdIntPackAdapt<T>(rVal); }
 
+// * Buffer Reference Adaptor
+// Same format as StdBuf, but references the compiler's input instead of copying it where possible.
+// Only use this if the input outlives the buffer!
+struct StdBufRefAdapt
+{
+	StdBuf &rBuf;
+
+	explicit StdBufRefAdapt(StdBuf &rBuf) : rBuf(rBuf) {}
+
+	inline void CompileFunc(StdCompiler *pComp) const
+	{
+		if (!pComp->isCompiler())
+		{
+			pComp->Value(rBuf);
+			return;
+		}
+		uint32_t iSize = 0; pComp->Value(mkIntPackAdapt(iSize));
+		pComp->Separator(StdCompiler::SEP_PART2);
+		if (const void *pData = pComp->RawRef(iSize))
+			rBuf.Ref(pData, iSize);
+		else
+		{
+			rBuf.New(iSize);
+			pComp->Raw(rBuf.getMData(), iSize);
+		}
+	}
+};
+
+inline StdBufRefAdapt mkBufRefAdapt(StdBuf &rBuf) { return StdBufRefAdapt(rBuf); }
+
 template <class T>
 struct StdEnumEntry
 {
@@ -178,6 +178,19 @@ void StdCompilerBinRead::Raw(void *pData, size_t iSize, RawCompileType eType)
 	iPos += iSize;
 }
 
+const void *StdCompilerBinRead::RawRef(size_t iSize)
+{
+	if (!fAllowRawRef) return nullptr;
+	if (iPos + iSize > Buf.getSize())
+	{
+		excEOF(); return nullptr;
+	}
+	// Reference data
+	const void *pData = Buf.getPtr(iPos);
+	iPos += iSize;
+	return pData;
+}
+
 StdStrBuf StdCompilerBinRead::getPosition() const
 {
 	return FormatString("byte %zu", iPos);
@@ -143,6 +143,10 @@ public:
 	virtual void String(std::string &str, RawCompileType type = RCT_Escaped) = 0;
 	virtual void Raw(void *pData, size_t iSize, RawCompileType eType = RCT_Escaped) = 0;
 
+	// Returns a pointer to the next iSize bytes of input and skips them, or nullptr if the compiler can't do that
+	// (use Raw then). The data stays valid as long as the input does.
+	virtual const void *RawRef(size_t iSize) { return nullptr; }
+
 	void String(const char *string, size_t maxLength, RawCompileType type = RCT_Escaped)
 	{
 		assert(isDecompiler());
@@ -436,6 +440,8 @@ public:
 	// Input
 	typedef StdBuf InT;
 	void setInput(const InT &In) { Buf.Ref(In); }
+	// Enables RawRef - only if the input outlives everything compiled from it!
+	void setAllowRawRef(bool fAllow) { fAllowRawRef = fAllow; }
 
 	// Properties
 	virtual bool isCompiler() override { return true; }
@@ -454,6 +460,7 @@ public:
 	virtual void String(char *szString, size_t iMaxLength, RawCompileType eType = RCT_Escaped) override;
 	virtual void String(std::string &str, RawCompileType eType = RCT_Escaped) override;
 	virtual void Raw(void *pData, size_t iSize, RawCompileType eType = RCT_Escaped) override;
+	virtual const void *RawRef(size_t iSize) override;
 
 	// Position
 	virtual StdStrBuf getPosition() const override;
@@ -468,6 +475,7 @@ protected:
 	// Process data
 	size_t iPos;
 	StdBuf Buf;
+	bool fAllowRawRef{false};
 
 	// Helper
 	template <class T> void ReadValue(T &rValue);
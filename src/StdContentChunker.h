@@ -0,0 +1,83 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// content-defined chunking: splits a byte stream at positions that only depend on the bytes
+// right before them (gear hash), so inserting or removing data only changes the chunks around it
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// fixed pseudo-random values (splitmix64), chunk boundaries must be the same everywhere
+constexpr std::array<uint64_t, 256> StdMakeGearTable()
+{
+	std::array<uint64_t, 256> Table{};
+	uint64_t iState = 0;
+	for (size_t i = 0; i < Table.size(); i++)
+	{
+		uint64_t z = (iState += 0x9e3779b97f4a7c15);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+		Table[i] = z ^ (z >> 31);
+	}
+	return Table;
+}
+
+inline constexpr std::array<uint64_t, 256> StdGearTable = StdMakeGearTable();
+
+class StdContentChunker
+{
+public:
+	// iAvgSize must be a power of two
+	constexpr StdContentChunker(size_t iMinSize, size_t iAvgSize, size_t iMaxSize)
+		: iMinSize(iMinSize), iMaxSize(iMaxSize), Mask(MakeMask(iAvgSize)) {}
+
+private:
+	size_t iMinSize, iMaxSize;
+	uint64_t Mask; // boundary if none of these bits are set; the highest bits depend on the last 64 bytes
+	uint64_t Hash = 0;
+	size_t iChunkSize = 0;
+
+public:
+	// returns the number of bytes that still belong to the current chunk;
+	// if fBoundary is set, the chunk ends there and the next call starts a new one
+	size_t Scan(const uint8_t *pData, size_t iSize, bool &fBoundary)
+	{
+		fBoundary = false;
+		for (size_t i = 0; i < iSize; i++)
+		{
+			Hash = (Hash << 1) + StdGearTable[pData[i]];
+			if (++iChunkSize >= iMaxSize || (iChunkSize >= iMinSize && !(Hash & Mask)))
+			{
+				Reset();
+				fBoundary = true;
+				return i + 1;
+			}
+		}
+		return iSize;
+	}
+
+	void Reset() { Hash = 0; iChunkSize = 0; }
+
+private:
+	static constexpr uint64_t MakeMask(size_t iAvgSize)
+	{
+		int iBits = 0;
+		while ((size_t{1} << iBits) < iAvgSize) iBits++;
+		return iBits ? ~uint64_t{0} << (64 - iBits) : 0;
+	}
+};
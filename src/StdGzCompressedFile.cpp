@@ -179,18 +179,9 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 		const auto oldAvailIn = gzStream.avail_in;
 		const auto oldAvailOut = gzStream.avail_out;
 
-		if (const auto ret = inflate(&gzStream, Z_SYNC_FLUSH); ret != Z_OK)
-		{
-			if (ret == Z_STREAM_END)
-			{
-				inflateEnd(&gzStream);
-				gzStreamValid = false;
-			}
-			else if (ret != Z_BUF_ERROR && gzStream.avail_out != 0)
-			{
-				throw Exception(std::string{"inflate failed: "} + zError(ret));
-			}
-		}
+		// stop at block boundaries, which are possible access points
+		const auto ret = inflate(&gzStream, Z_BLOCK);
+
 		const auto outProgress = oldAvailOut - gzStream.avail_out;
 		position += outProgress;
 		readSize += outProgress;
@@ -198,6 +189,31 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 		const auto inProgress = oldAvailIn - gzStream.avail_in;
 		bufferPtr += inProgress;
 		bufferedSize -= inProgress;
+
+		if (ret == Z_STREAM_END)
+		{
+			inflateEnd(&gzStream);
+			gzStreamValid = false;
+			// inflating raw data leaves the gzip trailer to us
+			if (rawDeflate)
+			{
+				rawDeflate = false;
+				SkipInput(8);
+			}
+		}
+		else if (ret != Z_OK)
+		{
+			if (ret != Z_BUF_ERROR && gzStream.avail_out != 0)
+			{
+				throw Exception(std::string{"inflate failed: "} + zError(ret));
+			}
+		}
+		// end of a block that is not the last one
+		else if ((gzStream.data_type & 128) && !(gzStream.data_type & 64)
+			&& position >= (accessPoints.empty() ? 0 : accessPoints.back().position) + AccessPointSpacing)
+		{
+			AddAccessPoint();
+		}
 	}
 
 	return readSize;
@@ -205,6 +221,7 @@ size_t Read::ReadData(uint8_t *const toBuffer, const size_t size)
 
 void Read::RefillBuffer()
 {
+	bufferFileOffset = ftell(file);
 	bufferedSize = static_cast<unsigned int>(fread(buffer.get(), 1, ChunkSize, file));
 	if (ferror(file)) throw Exception("fread failed");
 	bufferPtr = buffer.get();
@@ -215,7 +232,12 @@ void Read::Rewind()
 	position = 0;
 	fseek(file, 0, SEEK_SET);
 
-	inflateEnd(&gzStream);
+	if (gzStreamValid)
+	{
+		inflateEnd(&gzStream);
+		gzStreamValid = false;
+	}
+	rawDeflate = false;
 
 	gzStream.next_out = nullptr;
 	gzStream.avail_out = 0;
@@ -223,7 +245,125 @@ void Read::Rewind()
 	PrepareInflate();
 }
 
-Write::Write(const std::string &filename)
+void Read::Seek(const size_t toPosition)
+{
+	// the last access point before the target
+	const auto next = std::upper_bound(accessPoints.begin(), accessPoints.end(), toPosition,
+		[](const size_t toPosition, const AccessPoint &point) { return toPosition < point.position; });
+	const AccessPoint *const point = (next != accessPoints.begin() ? &*(next - 1) : nullptr);
+
+	// going back or skipping a known part: start from there instead of the current position
+	if (toPosition < position || (point && point->position > position))
+	{
+		if (point)
+		{
+			JumpTo(*point);
+		}
+		else
+		{
+			Rewind();
+		}
+	}
+
+	uint8_t discard[16 * 1024];
+	while (position < toPosition)
+	{
+		if (ReadData(discard, std::min(sizeof(discard), toPosition - position)) == 0)
+		{
+			throw Exception("Seeking beyond the end of the file");
+		}
+	}
+}
+
+void Read::SkipInput(size_t size)
+{
+	while (size > 0)
+	{
+		if (bufferedSize == 0)
+		{
+			RefillBuffer();
+
+			if (bufferedSize == 0)
+			{
+				throw Exception("Unexpected end of file");
+			}
+		}
+
+		const auto progress = std::min<size_t>(size, bufferedSize);
+		bufferPtr += progress;
+		bufferedSize -= static_cast<unsigned int>(progress);
+		size -= progress;
+	}
+
+	gzStream.next_in = bufferPtr;
+	gzStream.avail_in = bufferedSize;
+}
+
+void Read::AddAccessPoint()
+{
+	AccessPoint point{position, bufferFileOffset + static_cast<long>(bufferPtr - buffer.get()), gzStream.data_type & 7, WindowSize, std::make_unique<uint8_t[]>(WindowSize)};
+	if (const auto ret = inflateGetDictionary(&gzStream, point.window.get(), &point.windowSize); ret != Z_OK)
+	{
+		throw Exception(std::string{"inflateGetDictionary failed: "} + zError(ret));
+	}
+	accessPoints.emplace_back(std::move(point));
+}
+
+void Read::JumpTo(const AccessPoint &point)
+{
+	if (gzStreamValid)
+	{
+		inflateEnd(&gzStream);
+		gzStreamValid = false;
+	}
+
+	// the byte that is shared with the preceding block is needed as well
+	if (fseek(file, point.fileOffset - (point.bits ? 1 : 0), SEEK_SET))
+	{
+		throw Exception(std::string{"fseek failed: "} + std::strerror(errno));
+	}
+	bufferedSize = 0;
+	RefillBuffer();
+
+	gzStream.zalloc = nullptr;
+	gzStream.zfree = nullptr;
+	gzStream.opaque = nullptr;
+	gzStream.next_in = nullptr;
+	gzStream.avail_in = 0;
+
+	if (const auto ret = inflateInit2(&gzStream, -15); ret != Z_OK) // raw deflate, there is no header here
+	{
+		throw Exception(std::string{"inflateInit2 failed: "} + zError(ret));
+	}
+	gzStreamValid = true;
+	rawDeflate = true;
+
+	if (point.bits)
+	{
+		if (bufferedSize == 0)
+		{
+			throw Exception("Unexpected end of file");
+		}
+
+		const int lastByte = *bufferPtr++;
+		--bufferedSize;
+		inflatePrime(&gzStream, point.bits, lastByte >> (8 - point.bits));
+	}
+
+	if (point.windowSize)
+	{
+		if (const auto ret = inflateSetDictionary(&gzStream, point.window.get(), point.windowSize); ret != Z_OK)
+		{
+			throw Exception(std::string{"inflateSetDictionary failed: "} + zError(ret));
+		}
+	}
+
+	gzStream.next_in = bufferPtr;
+	gzStream.avail_in = bufferedSize;
+	position = point.position;
+}
+
+Write::Write(const std::string &filename, bool syncFlush) : syncFlush{syncFlush}
 {
 	file = fopen(filename.c_str(), "wb");
 	if (!file)
@@ -295,7 +435,7 @@ void Write::DeflateToBuffer(const uint8_t *const fromBuffer, const size_t size,
 	}
 
 	int ret = Z_BUF_ERROR;
-	while (ret == Z_BUF_ERROR || gzStream.avail_in > 0 || (ret == Z_OK && flushMode == Z_FINISH))
+	while (ret == Z_BUF_ERROR || gzStream.avail_in > 0 || (ret == Z_OK && flushMode == Z_FINISH) || (flushMode == Z_FULL_FLUSH && gzStream.avail_out == 0))
 	{
 		if (gzStream.avail_out == 0)
 		{
@@ -323,6 +463,22 @@ void Write::DeflateToBuffer(const uint8_t *const fromBuffer, const size_t size,
 
 void Write::WriteData(const uint8_t *const fromBuffer, const size_t size)
 {
-	DeflateToBuffer(fromBuffer, size, Z_NO_FLUSH, Z_OK);
+	if (!syncFlush)
+	{
+		DeflateToBuffer(fromBuffer, size, Z_NO_FLUSH, Z_OK);
+		return;
+	}
+
+	for (size_t pos = 0; pos < size; )
+	{
+		bool boundary;
+		const size_t length = syncChunker.Scan(fromBuffer + pos, size - pos, boundary);
+		DeflateToBuffer(fromBuffer + pos, length, Z_NO_FLUSH, Z_OK);
+		if (boundary)
+		{
+			DeflateToBuffer(nullptr, 0, Z_FULL_FLUSH, Z_OK);
+		}
+		pos += length;
+	}
 }
 }
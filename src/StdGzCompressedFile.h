@@ -18,12 +18,14 @@
 #pragma once
 
 #include "Standard.h"
+#include "StdContentChunker.h"
 
 #include <cstdio>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
 #include <zlib.h>
 
@@ -34,20 +36,38 @@ using Exception = std::runtime_error;
 static constexpr uint8_t C4GroupMagic[2] = {0x1e, 0x8c};
 static constexpr uint8_t GZMagic[2] = {0x1f, 0x8b};
 static constexpr auto ChunkSize = 1024 * 1024;
+static constexpr auto WindowSize = 32 * 1024; // history needed to continue inflating from any point
+static constexpr size_t AccessPointSpacing = 512 * 1024; // uncompressed bytes between two access points
 
 class Read
 {
+	// a deflate block boundary, from where inflating can be resumed without the preceding data
+	struct AccessPoint
+	{
+		size_t position; // uncompressed
+		long fileOffset; // of the first byte that has not been consumed completely
+		int bits; // bits of the byte before fileOffset that still belong to the following block
+		unsigned int windowSize;
+		std::unique_ptr<uint8_t[]> window;
+	};
+
 	std::unique_ptr<uint8_t[]> buffer{new uint8_t[ChunkSize]};
 	uint8_t *bufferPtr = nullptr;
 
 	// the gzip struct only has size fields of unsigned int
 	// and this value is bounded by ChunkSize anyway
 	unsigned int bufferedSize = 0;
+	long bufferFileOffset = 0; // of the buffer start
 
 	FILE *file;
 	size_t position = 0;
 	z_stream gzStream;
 	bool gzStreamValid = false;
+	bool rawDeflate = false; // after jumping to an access point, the gzip header has not been seen
+
+	// recorded while the data is read, so seeking never has to start over at the beginning
+	// once a position has been passed
+	std::vector<AccessPoint> accessPoints;
 
 public:
 	Read(const std::string &filename);
@@ -55,11 +75,16 @@ public:
 	size_t UncompressedSize();
 	size_t ReadData(uint8_t *toBuffer, size_t size);
 	void Rewind();
+	void Seek(size_t toPosition);
+	size_t Tell() const { return position; }
 
 private:
 	void CheckMagicBytes();
 	void PrepareInflate();
 	void RefillBuffer();
+	void SkipInput(size_t size);
+	void AddAccessPoint();
+	void JumpTo(const AccessPoint &point);
 };
 
 class Write
@@ -71,9 +96,13 @@ class Write
 	// and this value is bounded by ChunkSize anyway
 	unsigned int bufferedSize = 0;
 	bool magicBytesDone = false;
+	// content-defined full flushes (like gzip --rsyncable): unchanged parts of the data
+	// compress to the same bytes, no matter what changed before them
+	bool syncFlush;
+	StdContentChunker syncChunker{16 * 1024, 64 * 1024, 256 * 1024};
 
 public:
-	Write(const std::string &filename);
+	Write(const std::string &filename, bool syncFlush = false);
 	~Write() noexcept(false);
 	void WriteData(const uint8_t *const fromBuffer, const size_t size);
 
@@ -42,7 +42,7 @@
 
 // *** StdSchedulerProc
 
-#ifndef STDSCHEDULER_USE_EVENTS
+#if !defined(STDSCHEDULER_USE_EVENTS) && !defined(STDSCHEDULER_USE_EPOLL)
 static bool FD_INTERSECTS(int n, fd_set *a, fd_set *b)
 {
 	for (int i = 0; i < n; ++i)
@@ -66,11 +66,29 @@ StdScheduler::StdScheduler()
 	// Experimental castration of the unblocker.
 	fcntl(Unblocker[0], F_SETFL, fcntl(Unblocker[0], F_GETFL) | O_NONBLOCK);
 #endif
+#ifdef STDSCHEDULER_USE_EPOLL
+	EPollFD = epoll_create1(EPOLL_CLOEXEC);
+	if (EPollFD == -1)
+		printf("StdScheduler: epoll_create1 failed %s\n", strerror(errno));
+	// the unblocker is the only descriptor without a process
+	epoll_event Event{};
+	Event.events = EPOLLIN;
+	Event.data.ptr = nullptr;
+	if (EPollFD != -1 && epoll_ctl(EPollFD, EPOLL_CTL_ADD, Unblocker[0], &Event) != 0)
+	{
+		printf("StdScheduler: epoll_ctl failed %s\n", strerror(errno));
+		close(EPollFD); EPollFD = -1;
+	}
+	EPollEvents.resize(1);
+#endif
 }
 
 StdScheduler::~StdScheduler()
 {
 	Clear();
+#ifdef STDSCHEDULER_USE_EPOLL
+	if (EPollFD != -1) close(EPollFD);
+#endif
 }
 
 int StdScheduler::getProc(StdSchedulerProc *pProc)
@@ -83,6 +101,12 @@ int StdScheduler::getProc(StdSchedulerProc *pProc)
 
 void StdScheduler::Clear()
 {
+#ifdef STDSCHEDULER_USE_EPOLL
+	// unregister descriptors
+	for (int i = 0; i < iProcCnt; i++)
+		if (ppProcs[i]->GetFD() >= 0)
+			epoll_ctl(EPollFD, EPOLL_CTL_DEL, ppProcs[i]->GetFD(), nullptr);
+#endif
 	delete[] ppProcs; ppProcs = nullptr;
 #ifdef STDSCHEDULER_USE_EVENTS
 	delete[] pEventHandles; pEventHandles = nullptr;
@@ -100,6 +124,19 @@ void StdScheduler::Add(StdSchedulerProc *pProc)
 	// Add
 	ppProcs[iProcCnt] = pProc;
 	iProcCnt++;
+#ifdef STDSCHEDULER_USE_EPOLL
+	// Register descriptor (level-triggered, as processes don't have to handle everything at once)
+	const int iFD = pProc->GetFD();
+	if (iFD >= 0 && EPollFD != -1)
+	{
+		epoll_event Event{};
+		Event.events = EPOLLIN;
+		Event.data.ptr = pProc;
+		if (epoll_ctl(EPollFD, EPOLL_CTL_ADD, iFD, &Event) != 0)
+			printf("StdScheduler::Add: epoll_ctl failed %s\n", strerror(errno));
+	}
+	EPollEvents.resize(iProcCnt + 1);
+#endif
 }
 
 void StdScheduler::Remove(StdSchedulerProc *pProc)
@@ -107,17 +144,31 @@ void StdScheduler::Remove(StdSchedulerProc *pProc)
 	// Search
 	int iPos = getProc(pProc);
 	// Not found?
-	if (iPos >= iProcCnt) return;
+	if (iPos < 0) return;
+#ifdef STDSCHEDULER_USE_EPOLL
+	// Unregister descriptor
+	if (pProc->GetFD() >= 0)
+		epoll_ctl(EPollFD, EPOLL_CTL_DEL, pProc->GetFD(), nullptr);
+#endif
 	// Remove
 	for (int i = iPos + 1; i < iProcCnt; i++)
 		ppProcs[i - 1] = ppProcs[i];
 	iProcCnt--;
 }
 
+bool StdScheduler::IsValid() const
+{
+#ifdef STDSCHEDULER_USE_EPOLL
+	return EPollFD != -1;
+#else
+	return true;
+#endif
+}
+
 bool StdScheduler::Execute(int iTimeout)
 {
 	// Needs at least one process to work properly
-	if (!iProcCnt) return false;
+	if (!iProcCnt || !IsValid()) return false;
 
 	// Get timeout
 	int i; int iProcTimeout;
@@ -160,6 +211,37 @@ bool StdScheduler::Execute(int iTimeout)
 			}
 	}
 
+#elif defined(STDSCHEDULER_USE_EPOLL)
+
+	// Wait for something to happen
+	int cnt = epoll_wait(EPollFD, EPollEvents.data(), EPollEvents.size(), iTimeout);
+
+	bool fSuccess = true;
+
+	if (cnt > 0)
+	{
+		for (i = 0; i < cnt; i++)
+		{
+			StdSchedulerProc *pProc = static_cast<StdSchedulerProc *>(EPollEvents[i].data.ptr);
+			// Unblocker? Flush
+			if (!pProc)
+			{
+				char c;
+				read(Unblocker[0], &c, 1);
+			}
+			// Execute the signaled process (unless a previous one removed it)
+			else if (hasProc(pProc) && !pProc->Execute(0))
+			{
+				OnError(pProc);
+				fSuccess = false;
+			}
+		}
+	}
+	else if (cnt < 0)
+	{
+		printf("StdScheduler::Execute: epoll_wait failed %s\n", strerror(errno));
+	}
+
 #else
 
 	// Initialize file descriptor sets
@@ -301,6 +383,8 @@ bool StdSchedulerThread::Start()
 {
 	// already running? stop
 	if (fThread) Stop();
+	// nothing could be waited for
+	if (!IsValid()) return false;
 	// begin thread
 	fRunThreadRun = true;
 	thread = std::thread{[this]
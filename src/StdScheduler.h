@@ -28,9 +28,15 @@
 	#endif
 #else
 	#include <sys/select.h>
+	// epoll scales with the number of active descriptors instead of all watched ones
+	#ifdef HAVE_SYS_EPOLL_H
+		#define STDSCHEDULER_USE_EPOLL
+		#include <sys/epoll.h>
+	#endif
 #endif
 
 #include <thread>
+#include <vector>
 
 // helper
 inline int MaxTimeout(int iTimeout1, int iTimeout2)
@@ -51,6 +57,10 @@ public:
 	// Signal for calling Execute()
 #ifdef STDSCHEDULER_USE_EVENTS
 	virtual HANDLE GetEvent() { return 0; }
+#elif defined(STDSCHEDULER_USE_EPOLL)
+	// Must become readable whenever Execute() should be called and stay the same while the process is scheduled.
+	// Processes watching multiple descriptors should return an epoll descriptor of their own.
+	virtual int GetFD() { return -1; }
 #else
 	virtual void GetFDs(fd_set *pFDs, int *pMaxFD) {}
 #endif
@@ -85,10 +95,17 @@ private:
 	StdSchedulerProc **ppEventProcs;
 #endif
 
+#ifdef STDSCHEDULER_USE_EPOLL
+	// the descriptors of all processes and the unblocker, registered level-triggered by Add/Remove
+	int EPollFD;
+	std::vector<epoll_event> EPollEvents;
+#endif
+
 public:
 	int getProcCnt() const { return iProcCnt; }
 	int getProc(StdSchedulerProc *pProc);
 	bool hasProc(StdSchedulerProc *pProc) { return getProc(pProc) >= 0; }
+	bool IsValid() const; // false if the scheduler could not be set up
 
 	void Clear();
 	void Add(StdSchedulerProc *pProc);
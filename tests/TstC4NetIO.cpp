@@ -3,15 +3,27 @@
 #endif
 
 #include <C4NetIO.h>
+#include <StdScheduler.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <iostream>
+#include <mutex>
+#include <random>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include <time.h>
 #ifdef _WIN32
 #include <windows.h>
 #include <mmsystem.h>
 #else
 #include <arpa/inet.h>
+#include <poll.h>
+#include <sys/resource.h>
+#include <unistd.h>
 #endif
 
 using namespace std;
@@ -79,8 +91,417 @@ public:
 	};
 };
 
+#ifndef _WIN32
+
+// loopback stress test: how often does the scheduler wake up while serving many connections (or UDP senders)?
+
+class StressCBClass : public C4NetIO::CBClass
+{
+public:
+	std::atomic<int> iConnCnt{0}, iPacketCnt{0};
+
+	virtual bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const C4NetIO::addr_t *pOwnAddr, C4NetIO *pNetIO) override
+	{
+		++iConnCnt;
+		return true;
+	}
+	virtual void OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO) override
+	{
+		++iPacketCnt;
+	}
+};
+
+static bool StressTest(bool fUDP, int iConnCnt, uint16_t iPort, int iDuration)
+{
+	C4NetIOTCP NetIOTCP; C4NetIOSimpleUDP NetIOUDP;
+	C4NetIO &NetIO = fUDP ? static_cast<C4NetIO &>(NetIOUDP) : NetIOTCP;
+	StressCBClass CBClass;
+	NetIO.SetCallback(&CBClass);
+	if (!NetIO.Init(iPort))
+	{
+		cout << " Fehler: " << NetIO.GetError() << endl;
+		return false;
+	}
+	StdScheduler Scheduler;
+	Scheduler.Add(&NetIO);
+
+	// connect plain client sockets, so only the server side is measured
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(iPort);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	std::vector<int> Clients;
+	bool fSuccess = true;
+	for (int i = 0; i < iConnCnt && fSuccess; i++)
+	{
+		int sock = socket(AF_INET, fUDP ? SOCK_DGRAM : SOCK_STREAM, 0);
+		if (sock < 0 || connect(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+		{
+			cout << " Fehler: connect " << strerror(errno) << endl;
+			if (sock >= 0) close(sock);
+			fSuccess = false;
+			break;
+		}
+		Clients.push_back(sock);
+		// accept from time to time, so the listen backlog does not overflow
+		while (!fUDP && CBClass.iConnCnt <= i - 64)
+			Scheduler.Execute(100);
+	}
+	for (int i = 0; fSuccess && !fUDP && CBClass.iConnCnt < iConnCnt; i++)
+		if (i > 100)
+		{
+			cout << " Fehler: only " << CBClass.iConnCnt << " connections accepted" << endl;
+			fSuccess = false;
+		}
+		else
+			Scheduler.Execute(100);
+
+	if (fSuccess)
+	{
+		// every client sends a small packet per millisecond round
+		std::atomic<bool> fRunning{true};
+		std::thread Sender{[&]
+		{
+			// TCP packets are framed like C4NetIOTCP::PackPacket does it
+			char Packet[1 + sizeof(uint32_t) + 16];
+			const uint32_t iSize = 16;
+			Packet[0] = static_cast<char>(0xff);
+			memcpy(Packet + 1, &iSize, sizeof(iSize));
+			memset(Packet + 1 + sizeof(iSize), 'A', iSize);
+			const char *pPacket = fUDP ? Packet + 1 + sizeof(iSize) : Packet;
+			const size_t iPacketSize = fUDP ? iSize : sizeof(Packet);
+			while (fRunning)
+			{
+				for (int sock : Clients)
+					send(sock, pPacket, iPacketSize, 0);
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			}
+		}};
+
+		// count scheduler wakeups
+		const int iStartPackets = CBClass.iPacketCnt;
+		int iWakeups = 0;
+		const auto Start = std::chrono::steady_clock::now();
+		const auto End = Start + std::chrono::milliseconds(iDuration);
+		while (std::chrono::steady_clock::now() < End)
+		{
+			Scheduler.Execute(100);
+			iWakeups++;
+		}
+		const double dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+		fRunning = false;
+		Sender.join();
+
+		const int iPackets = CBClass.iPacketCnt - iStartPackets;
+		cout << (fUDP ? "UDP, " : "TCP, ") << iConnCnt << (fUDP ? " senders: " : " connections: ") << static_cast<int>(iWakeups / dSeconds) << " wakeups/s, "
+			<< static_cast<int>(iPackets / dSeconds) << " packets/s, "
+			<< (iWakeups ? iPackets / iWakeups : 0) << " packets per wakeup" << endl;
+	}
+
+	for (int sock : Clients)
+		close(sock);
+	Scheduler.Remove(&NetIO);
+	NetIO.Close();
+	return fSuccess;
+}
+
+static int StressTests(uint16_t iPort)
+{
+	// server and client sockets share one process
+	rlimit Limit;
+	if (!getrlimit(RLIMIT_NOFILE, &Limit))
+	{
+		Limit.rlim_cur = Limit.rlim_max;
+		setrlimit(RLIMIT_NOFILE, &Limit);
+	}
+
+	for (bool fUDP : {false, true})
+		for (int iConnCnt : {50, 200, 1000})
+			if (!StressTest(fUDP, iConnCnt, iPort, 5000))
+				return 1;
+	return 0;
+}
+
+// loopback receive benchmark: packet throughput and how many packets reach the callback without being copied
+
+class BenchCBClass : public C4NetIO::CBClass
+{
+public:
+	std::atomic<int> iPacketCnt{0}, iRefCnt{0};
+
+	virtual bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const C4NetIO::addr_t *pOwnAddr, C4NetIO *pNetIO) override
+	{
+		return true;
+	}
+	virtual void OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO) override
+	{
+		++iPacketCnt;
+		if (rPacket.isRef()) ++iRefCnt;
+	}
+};
+
+static bool BenchTest(bool fUDP, uint32_t iPacketSize, uint16_t iPort, int iDuration)
+{
+	C4NetIOTCP NetIOTCP; C4NetIOSimpleUDP NetIOUDP;
+	C4NetIO &NetIO = fUDP ? static_cast<C4NetIO &>(NetIOUDP) : NetIOTCP;
+	BenchCBClass CBClass;
+	NetIO.SetCallback(&CBClass);
+	if (!NetIO.Init(iPort))
+	{
+		cout << " Fehler: " << NetIO.GetError() << endl;
+		return false;
+	}
+	StdScheduler Scheduler;
+	Scheduler.Add(&NetIO);
+
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons(iPort);
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	int sock = socket(AF_INET, fUDP ? SOCK_DGRAM : SOCK_STREAM, 0);
+	if (sock < 0 || connect(sock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0)
+	{
+		cout << " Fehler: connect " << strerror(errno) << endl;
+		if (sock >= 0) close(sock);
+		Scheduler.Remove(&NetIO);
+		NetIO.Close();
+		return false;
+	}
+
+	// TCP packets are framed like C4NetIOTCP::PackPacket does it
+	std::vector<char> Packet(iPacketSize, 'A');
+	if (!fUDP)
+	{
+		Packet.insert(Packet.begin(), 1 + sizeof(uint32_t), 0);
+		Packet[0] = static_cast<char>(0xff);
+		memcpy(&Packet[1], &iPacketSize, sizeof(iPacketSize));
+	}
+	std::atomic<bool> fRunning{true};
+	std::thread Sender{[&]
+	{
+		while (fRunning)
+		{
+			for (int i = 0; i < 64; i++)
+				send(sock, Packet.data(), Packet.size(), 0);
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+	}};
+
+	const auto Start = std::chrono::steady_clock::now();
+	const auto End = Start + std::chrono::milliseconds(iDuration);
+	while (std::chrono::steady_clock::now() < End)
+		Scheduler.Execute(100);
+	const double dSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - Start).count();
+	fRunning = false;
+	Sender.join();
+
+	const int iPackets = CBClass.iPacketCnt;
+	cout << (fUDP ? "UDP" : "TCP") << ", " << iPacketSize << " bytes: " << static_cast<int>(iPackets / dSeconds) << " packets/s, "
+		<< (iPackets ? 100 * CBClass.iRefCnt / iPackets : 0) << "% without copy" << endl;
+
+	close(sock);
+	Scheduler.Remove(&NetIO);
+	NetIO.Close();
+	return true;
+}
+
+static int BenchTests(uint16_t iPort)
+{
+	for (bool fUDP : {false, true})
+		for (uint32_t iPacketSize : {64u, 1024u})
+			if (!BenchTest(fUDP, iPacketSize, iPort, 2000))
+				return 1;
+	return 0;
+}
+
+// lossy link test: C4NetIOUDP control packet latency through a loopback proxy that drops and delays datagrams
+
+class LossProxy
+{
+public:
+	LossProxy(uint16_t iPort, uint16_t iTargetPort, double dLoss, int iDelay)
+		: dLoss(dLoss), Delay(iDelay), Random(42)
+	{
+		sockaddr_in addr{};
+		addr.sin_family = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		// clients send to the proxy port...
+		ClientSock = socket(AF_INET, SOCK_DGRAM, 0);
+		addr.sin_port = htons(iPort);
+		bind(ClientSock, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+		// ...and the proxy forwards to the target from another socket
+		TargetSock = socket(AF_INET, SOCK_DGRAM, 0);
+		TargetAddr = addr; TargetAddr.sin_port = htons(iTargetPort);
+		Thread = std::thread{[this] { Run(); }};
+	}
+
+	~LossProxy()
+	{
+		fRunning = false;
+		Thread.join();
+		close(ClientSock); close(TargetSock);
+	}
+
+private:
+	struct Datagram
+	{
+		std::chrono::steady_clock::time_point Time;
+		bool fToTarget;
+		std::vector<char> Data;
+	};
+
+	double dLoss;
+	std::chrono::milliseconds Delay;
+	std::mt19937 Random;
+	int ClientSock, TargetSock;
+	sockaddr_in TargetAddr, ClientAddr{};
+	std::deque<Datagram> Queue;
+	std::atomic<bool> fRunning{true};
+	std::thread Thread;
+
+	void Run()
+	{
+		std::uniform_real_distribution<double> Dist(0.0, 1.0);
+		char Buf[2048];
+		while (fRunning)
+		{
+			pollfd fds[2] = {{ClientSock, POLLIN, 0}, {TargetSock, POLLIN, 0}};
+			poll(fds, 2, 1);
+			for (int i = 0; i < 2; i++)
+				if (fds[i].revents & POLLIN)
+					for (;;)
+					{
+						sockaddr_in From{}; socklen_t iFromLen = sizeof(From);
+						const ssize_t iSize = recvfrom(fds[i].fd, Buf, sizeof(Buf), MSG_DONTWAIT, reinterpret_cast<sockaddr *>(&From), &iFromLen);
+						if (iSize <= 0) break;
+						if (!i) ClientAddr = From;
+						if (Dist(Random) < dLoss) continue;
+						Queue.push_back({std::chrono::steady_clock::now() + Delay, !i, std::vector<char>(Buf, Buf + iSize)});
+					}
+			// constant delay: the queue stays sorted
+			while (!Queue.empty() && Queue.front().Time <= std::chrono::steady_clock::now())
+			{
+				const Datagram &Dgram = Queue.front();
+				if (Dgram.fToTarget)
+					sendto(TargetSock, Dgram.Data.data(), Dgram.Data.size(), 0, reinterpret_cast<const sockaddr *>(&TargetAddr), sizeof(TargetAddr));
+				else
+					sendto(ClientSock, Dgram.Data.data(), Dgram.Data.size(), 0, reinterpret_cast<const sockaddr *>(&ClientAddr), sizeof(ClientAddr));
+				Queue.pop_front();
+			}
+		}
+	}
+};
+
+class LossCBClass : public C4NetIO::CBClass
+{
+public:
+	std::atomic<bool> fConnected{false};
+	std::mutex LatencyMutex;
+	std::vector<double> Latencies; // ms
+
+	virtual bool OnConn(const C4NetIO::addr_t &AddrPeer, const C4NetIO::addr_t &AddrConnect, const C4NetIO::addr_t *pOwnAddr, C4NetIO *pNetIO) override
+	{
+		fConnected = true;
+		return true;
+	}
+	virtual void OnPacket(const class C4NetIOPacket &rPacket, C4NetIO *pNetIO) override
+	{
+		int64_t iSent;
+		if (rPacket.getSize() < 1 + sizeof(iSent)) return;
+		memcpy(&iSent, rPacket.getPtr<char>(1), sizeof(iSent));
+		const int64_t iNow = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		std::lock_guard<std::mutex> Lock(LatencyMutex);
+		Latencies.push_back((iNow - iSent) / 1000.0);
+	}
+};
+
+static bool LossTest(double dLoss, uint16_t iPort, int iPacketCnt)
+{
+	const uint16_t iServerPort = iPort, iProxyPort = iPort + 1, iClientPort = iPort + 2;
+	C4NetIOUDP Server, Client;
+	LossCBClass ServerCB, ClientCB;
+	Server.SetCallback(&ServerCB); Client.SetCallback(&ClientCB);
+	if (!Server.Init(iServerPort) || !Client.Init(iClientPort))
+	{
+		cout << " Fehler: " << (Server.GetError() ? Server.GetError() : Client.GetError()) << endl;
+		return false;
+	}
+	LossProxy Proxy(iProxyPort, iServerPort, dLoss, 10);
+
+	std::atomic<bool> fRunning{true};
+	std::thread ServerThread{[&] { while (fRunning) Server.Execute(); }};
+	std::thread ClientThread{[&] { while (fRunning) Client.Execute(); }};
+
+	sockaddr_in ProxyAddr4{};
+	ProxyAddr4.sin_family = AF_INET;
+	ProxyAddr4.sin_port = htons(iProxyPort);
+	ProxyAddr4.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	C4NetIO::addr_t ProxyAddr;
+	ProxyAddr.SetAddress(reinterpret_cast<sockaddr *>(&ProxyAddr4));
+	Client.Connect(ProxyAddr);
+	for (int i = 0; i < 500 && !(ClientCB.fConnected && ServerCB.fConnected); i++)
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+
+	bool fSuccess = ClientCB.fConnected && ServerCB.fConnected;
+	if (fSuccess)
+	{
+		// one small control packet every 5 ms
+		char Packet[1 + sizeof(int64_t) + 23] = {};
+		Packet[0] = 1;
+		for (int i = 0; i < iPacketCnt; i++)
+		{
+			const int64_t iNow = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+			memcpy(Packet + 1, &iNow, sizeof(iNow));
+			Client.Send(C4NetIOPacket(Packet, sizeof(Packet), false, ProxyAddr));
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		}
+		// wait for the stragglers
+		for (int i = 0; i < 500; i++)
+		{
+			{
+				std::lock_guard<std::mutex> Lock(ServerCB.LatencyMutex);
+				if (ServerCB.Latencies.size() >= static_cast<size_t>(iPacketCnt)) break;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		std::lock_guard<std::mutex> Lock(ServerCB.LatencyMutex);
+		std::vector<double> Latencies = ServerCB.Latencies;
+		std::sort(Latencies.begin(), Latencies.end());
+		auto Percentile = [&](double p) { return Latencies.empty() ? 0.0 : Latencies[std::min(Latencies.size() - 1, static_cast<size_t>(p * Latencies.size()))]; };
+		cout << static_cast<int>(dLoss * 100 + 0.5) << "% loss: " << Latencies.size() << "/" << iPacketCnt << " packets, latency p50 "
+			<< Percentile(0.5) << " ms, p99 " << Percentile(0.99) << " ms, max " << (Latencies.empty() ? 0.0 : Latencies.back()) << " ms" << endl;
+	}
+	else
+		cout << " Fehler: no connection" << endl;
+
+	fRunning = false;
+	Server.UnBlock(); Client.UnBlock();
+	ServerThread.join(); ClientThread.join();
+	Client.Close(); Server.Close();
+	return fSuccess;
+}
+
+static int LossTests(uint16_t iPort)
+{
+	for (double dLoss : {0.0, 0.01, 0.05, 0.1})
+		if (!LossTest(dLoss, iPort, 2000))
+			return 1;
+	return 0;
+}
+
+#endif
+
 int main(int argc, char *argv[])
 {
+#ifndef _WIN32
+	for (int i = 1; i < argc; ++i)
+		if (std::string(argv[i]) == "--stress")
+			return StressTests(11111);
+		else if (std::string(argv[i]) == "--bench")
+			return BenchTests(11111);
+		else if (std::string(argv[i]) == "--loss")
+			return LossTests(11111);
+#endif
 
 	int i;
 	for (i = 0; i < sizeof(DummyData); i++)
@@ -139,7 +560,10 @@ int main(int argc, char *argv[])
 	if (argc == 1)
 	{
 #ifndef _WIN32
-		cout << "Possible usage: " << argv[0] << " [--server] [address[:port]] --port=port --size=size" << std::endl << std::endl;
+		cout << "Possible usage: " << argv[0] << " [--server] [address[:port]] --port=port --size=size" << std::endl;
+		cout << "       " << argv[0] << " --stress" << std::endl;
+		cout << "       " << argv[0] << " --bench" << std::endl;
+		cout << "       " << argv[0] << " --loss" << std::endl << std::endl;
 #endif
 
 		cout << "Server? (j/n)";
@@ -0,0 +1,143 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// checks that local files can be reused for similar network resources:
+// content-defined chunks survive insertions and sync-flushed packing keeps
+// unchanged parts byte-identical, while normal packing stays untouched
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <StdContentChunker.h>
+#include <StdGzCompressedFile.h>
+
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+// same parameters as C4Network2Res (see C4NetResDelta*)
+const size_t MinChunk = 4 * 1024, AvgChunk = 16 * 1024, MaxChunk = 64 * 1024;
+
+int iFails = 0;
+
+void Check(bool fCond, const char *szWhat)
+{
+	cout << (fCond ? "ok: " : "FAILED: ") << szWhat << endl;
+	if (!fCond) iFails++;
+}
+
+vector<string> Chunks(const vector<uint8_t> &Data)
+{
+	StdContentChunker Chunker(MinChunk, AvgChunk, MaxChunk);
+	vector<string> Result;
+	string Chunk;
+	// feed in odd pieces, boundaries must not depend on them
+	for (size_t iPos = 0; iPos < Data.size(); )
+	{
+		const size_t iPiece = min<size_t>(Data.size() - iPos, 1000 + iPos % 777);
+		for (size_t i = 0; i < iPiece; )
+		{
+			bool fBoundary;
+			const size_t iLength = Chunker.Scan(Data.data() + iPos + i, iPiece - i, fBoundary);
+			Chunk.append(reinterpret_cast<const char *>(Data.data()) + iPos + i, iLength);
+			i += iLength;
+			if (fBoundary) { Result.push_back(Chunk); Chunk.clear(); }
+		}
+		iPos += iPiece;
+	}
+	if (!Chunk.empty()) Result.push_back(Chunk);
+	return Result;
+}
+
+vector<uint8_t> Pack(const vector<uint8_t> &Data, bool fSyncFlush)
+{
+	const char *szFilename = "TstDeltaChunks.tmp";
+	{
+		StdGzCompressedFile::Write File(szFilename, fSyncFlush);
+		File.WriteData(Data.data(), Data.size());
+	}
+	vector<uint8_t> Result;
+	{
+		StdGzCompressedFile::Read File(szFilename);
+		Result.resize(Data.size() + 1);
+		Result.resize(File.ReadData(Result.data(), Result.size()));
+		Check(Result == Data, fSyncFlush ? "sync-flushed data unpacks unchanged" : "data unpacks unchanged");
+	}
+	FILE *f = fopen(szFilename, "rb");
+	Result.clear();
+	for (int c; (c = fgetc(f)) != EOF; ) Result.push_back(c);
+	fclose(f);
+	remove(szFilename);
+	return Result;
+}
+
+size_t SharedSize(const vector<uint8_t> &Old, const vector<uint8_t> &New)
+{
+	const auto OldChunks = Chunks(Old);
+	const set<string> Known(OldChunks.begin(), OldChunks.end());
+	size_t iShared = 0;
+	for (const auto &Chunk : Chunks(New))
+		if (Known.count(Chunk)) iShared += Chunk.size();
+	return iShared;
+}
+
+int main()
+{
+	// compressible, but not too much: words from a small vocabulary
+	mt19937 Rnd(42);
+	vector<uint8_t> Old;
+	while (Old.size() < 4 * 1024 * 1024)
+	{
+		const size_t iLength = 2 + Rnd() % 8;
+		for (size_t i = 0; i < iLength; i++) Old.push_back('a' + Rnd() % 6);
+		Old.push_back(Rnd() % 10 ? ' ' : '\n');
+	}
+
+	// chunk limits
+	const auto OldChunks = Chunks(Old);
+	bool fSizesOk = true;
+	for (size_t i = 0; i + 1 < OldChunks.size(); i++)
+		fSizesOk = fSizesOk && OldChunks[i].size() >= MinChunk && OldChunks[i].size() <= MaxChunk;
+	Check(fSizesOk, "chunk sizes stay within limits");
+	cout << "  " << OldChunks.size() << " chunks, " << Old.size() / OldChunks.size() << " bytes average" << endl;
+
+	// a few bytes inserted near the start and a modification in the middle
+	vector<uint8_t> New = Old;
+	New.insert(New.begin() + 1000, {'x', 'y', 'z'});
+	for (size_t i = 0; i < 500; i++) New[New.size() / 2 + i] = 'q';
+	const size_t iShared = SharedSize(Old, New);
+	cout << "  " << iShared * 100 / New.size() << "% of the raw data reusable" << endl;
+	Check(iShared > New.size() * 9 / 10, "raw chunks survive insertions");
+
+	// packed the way network resources are
+	const size_t iSyncShared = SharedSize(Pack(Old, true), Pack(New, true));
+	const size_t iSyncPacked = Pack(New, true).size();
+	cout << "  " << iSyncShared * 100 / iSyncPacked << "% of the sync-flushed data reusable" << endl;
+	Check(iSyncShared > iSyncPacked * 3 / 4, "sync-flushed chunks survive insertions");
+
+	// normal packing doesn't pay for that
+	const size_t iPacked = Pack(New, false).size();
+	cout << "  " << iPacked << " bytes packed, " << iSyncPacked << " bytes sync-flushed" << endl;
+	Check(iPacked <= iSyncPacked, "normal packing doesn't flush");
+
+	cout << (iFails ? "FAILED" : "all ok") << endl;
+	return iFails ? 1 : 0;
+}
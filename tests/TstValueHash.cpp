@@ -0,0 +1,77 @@
+/*
+ * LegacyClonk
+ *
+ * Copyright (c) 2020, The LegacyClonk Team and contributors
+ *
+ * Distributed under the terms of the ISC license; see accompanying file
+ * "COPYING" for details.
+ *
+ * "Clonk" is a registered trademark of Matthes Bender, used with permission.
+ * See accompanying file "TRADEMARK" for details.
+ *
+ * To redistribute this file separately, substitute the full license texts
+ * for the above references.
+ */
+
+// checks that script maps drop entries of removed object keys
+// and that iterators survive compactions of the map
+
+#include <C4Include.h>
+#include <C4ValueHash.h>
+#include <C4Object.h>
+
+#include <iostream>
+#include <set>
+
+using namespace std;
+
+int iFails = 0;
+
+void Check(bool fCond, const char *szWhat)
+{
+	cout << (fCond ? "ok: " : "FAILED: ") << szWhat << endl;
+	if (!fCond) iFails++;
+}
+
+int main()
+{
+	// entries keyed by objects that are removed must disappear from the map
+	{
+		C4Value Map{new C4ValueHash()};
+		C4ValueHash &rMap = *Map._getMap();
+		C4Object *pObj = new C4Object;
+		rMap[C4VInt(1)].SetInt(1);
+		rMap[C4VObj(pObj)].SetInt(2);
+		delete pObj;
+		int32_t iIterated = 0;
+		for (auto [key, value] : rMap) ++iIterated;
+		Check(rMap.size() == 1, "removed object key is not counted");
+		Check(iIterated == 1, "removed object key is not iterated");
+		Check(!rMap.contains(C4VNull), "removed object key does not become nil");
+	}
+
+	// removing entries while iterating compacts the map under the iterator
+	{
+		C4Value Map{new C4ValueHash()};
+		C4ValueHash &rMap = *Map._getMap();
+		const int32_t iCount = 1000;
+		for (int32_t i = 0; i < iCount; i++)
+			rMap[C4VInt(i)].SetInt(i);
+		set<int32_t> Visited;
+		bool fOnce = true;
+		for (auto [key, value] : rMap)
+		{
+			fOnce = Visited.insert(key._getInt()).second && fOnce;
+			if (!(key._getInt() % 2)) value.Set0();
+		}
+		Check(fOnce && Visited.size() == static_cast<size_t>(iCount), "every entry is iterated once while removing");
+		Check(rMap.size() == iCount / 2, "removed entries are gone");
+		int32_t iOdd = 0;
+		for (auto [key, value] : rMap)
+			if (key._getInt() % 2 && value.getInt() == key._getInt()) iOdd++;
+		Check(iOdd == iCount / 2, "remaining entries keep their values");
+	}
+
+	cout << (iFails ? "FAILED" : "all ok") << endl;
+	return iFails ? 1 : 0;
+}